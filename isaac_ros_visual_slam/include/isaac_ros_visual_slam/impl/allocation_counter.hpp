@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__ALLOCATION_COUNTER_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__ALLOCATION_COUNTER_HPP_
+
+#include <cstdint>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Per thread count of heap allocations. The node library does not replace the global operator
+// new, so the count only advances in processes that do and call CountHeapAllocation() from it,
+// like visual_slam_replay_bench. Everywhere else it stays 0.
+void CountHeapAllocation() noexcept;
+
+// Number of heap allocations counted on the calling thread.
+uint64_t GetThreadHeapAllocations() noexcept;
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__BOUNDED_QUEUE_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__BOUNDED_QUEUE_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Blocking queue with a fixed maximum size that keeps the latest items. When the queue is full
+// the oldest item is dropped to make room for the new one.
+// Items are swapped in and out of slots that are allocated once. Push() hands the producer the
+// item of a free slot and Pop() leaves the consumer's previous item in the slot, so items owning
+// heap storage (e.g. std::vector) circulate between producer and consumer and keep their
+// capacity. Both sides are expected to clear or overwrite the items they get back.
+template<class T>
+class BoundedQueue
+{
+public:
+  explicit BoundedQueue(size_t max_size)
+  : slots_(std::max<size_t>(max_size, 1))
+  {
+  }
+
+  // Swaps item into the queue, dropping the oldest one if the queue is full. Before an item is
+  // dropped merge(dropped, next) is called with the item that becomes the new front, which allows
+  // to carry over data that must not be lost. Afterwards item holds the content of a free slot.
+  template<class Merge>
+  void Push(T & item, Merge merge)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (size_ == slots_.size()) {
+        merge(slots_[head_], size_ > 1 ? slots_[(head_ + 1) % slots_.size()] : item);
+        head_ = (head_ + 1) % slots_.size();
+        --size_;
+        ++drops_;
+      }
+      std::swap(slots_[(head_ + size_) % slots_.size()], item);
+      ++size_;
+    }
+    cond_var_.notify_one();
+  }
+
+  void Push(T & item)
+  {
+    Push(item, [](T &, T &) {});
+  }
+
+  // Blocks until an item is available and swaps it into item. Returns false if the queue was
+  // stopped.
+  bool Pop(T & item)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_var_.wait(lock, [this]() {return stopped_ || size_ > 0;});
+    if (stopped_) {
+      return false;
+    }
+    std::swap(item, slots_[head_]);
+    head_ = (head_ + 1) % slots_.size();
+    --size_;
+    return true;
+  }
+
+  // Wakes up all waiting consumers and drops all queued items.
+  void Stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+      Clear();
+    }
+    cond_var_.notify_all();
+  }
+
+  // Makes a stopped queue usable again.
+  void Restart()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = false;
+    Clear();
+  }
+
+  size_t Size() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return size_;
+  }
+
+  // Total number of items dropped because the queue was full.
+  uint64_t Drops() const {return drops_;}
+
+private:
+  // Releases all slots. Only called on Stop() and Restart(), so the lost capacity does not matter.
+  void Clear()
+  {
+    for (T & slot : slots_) {
+      slot = T{};
+    }
+    head_ = 0;
+    size_ = 0;
+  }
+
+  std::vector<T> slots_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+  bool stopped_ = false;
+  std::atomic<uint64_t> drops_{0};
+  mutable std::mutex mutex_;
+  std::condition_variable cond_var_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__BOUNDED_QUEUE_HPP_
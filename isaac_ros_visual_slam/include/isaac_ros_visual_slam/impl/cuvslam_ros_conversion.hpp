@@ -18,10 +18,13 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__CUVSLAM_ROS_CONVERSION_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__CUVSLAM_ROS_CONVERSION_HPP_
 
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "cuvslam/cuvslam2.h"
 #include "cv_bridge/cv_bridge.hpp"
+#include "isaac_ros_visual_slam/impl/message_stream_sequencer.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
 #include "tf2/LinearMath/Transform.h"
 #include "Eigen/Eigen"
@@ -66,8 +69,38 @@ cuvslam::Image TocuVSLAMImage(
 cuvslam::Image TocuVSLAMDepthImage(
   int32_t camera_index, const ImageType & image_view, const int64_t & acqtime_ns);
 
+// An IMU message on its way to the tracker. measurement is set if the message was already
+// converted when it arrived, see enable_eager_imu_ingestion.
+struct ImuSample
+{
+  ImuType::ConstSharedPtr msg;
+  std::optional<cuvslam::ImuMeasurement> measurement;
+};
+
+// Buffers to convert a batch of IMU messages. The samples are gathered into a structure of arrays,
+// so that all of them are rotated in a single matrix product. The buffers only grow, converting
+// does not allocate once they have reached the largest batch.
+struct ImuBatch
+{
+  // Linear accelerations followed by angular velocities, 3 rows per sample in column major order.
+  std::vector<double> samples;
+  std::vector<double> rotated_samples;
+  std::vector<cuvslam::ImuMeasurement> measurements;
+};
+
+// Rotation of the IMU measurements from the frame of the messages into the cuVSLAM imu frame.
+// imu_rotation_msg rotates from the frame of the messages into the imu frame of the calibration,
+// it is applied before the change from ROS to cuVSLAM conventions.
+Eigen::Matrix3d TocuVSLAMImuRotation(const tf2::Matrix3x3 & imu_rotation_msg);
+
+// Converts the messages of a batch of IMU samples to cuVSLAM measurements in batch.measurements,
+// rotated by rotation, see TocuVSLAMImuRotation().
+void TocuVSLAMImuMeasurements(
+  const BatchView<ImuSample> & samples_imu, const Eigen::Matrix3d & rotation, ImuBatch & batch);
+
+// Converts a single IMU message, for converting the messages as they arrive.
 cuvslam::ImuMeasurement TocuVSLAMImuMeasurement(
-  const ImuType::ConstSharedPtr & msg_imu, const int64_t & acqtime_ns);
+  const ImuType & msg_imu, const Eigen::Matrix3d & rotation);
 
 void FillIntrinsics(const CameraInfoType::ConstSharedPtr & msg, cuvslam::Camera & camera);
 
@@ -0,0 +1,333 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__DROPOUT_SYNCHRONIZER_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__DROPOUT_SYNCHRONIZER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Synchronizes messages of several streams into frame sets like MessageStreamSynchronizer, but
+// does not let a stalled stream hold back the others.
+//
+// Messages whose timestamps are within the matching threshold form a frame set. A frame set is
+// emitted as soon as every healthy stream has contributed to it. If that does not happen before
+// the deadline, counted from the first message of the set, the available subset is emitted if it
+// has at least min_num_messages messages and dropped otherwise. Streams missing from such a set
+// are marked degraded and are no longer waited for, so the following frame sets are emitted as
+// soon as the healthy streams are complete. A degraded stream is re-admitted once it delivered
+// num_readmit_frames consecutive messages before the deadline of their frame set.
+//
+// Frame sets are emitted in timestamp order. Messages that arrive after their frame set was
+// emitted are dropped. Not thread safe.
+template<class T>
+class DropoutSynchronizer
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using Messages = std::vector<std::pair<int, T>>;
+  // Called with the latest timestamp and the messages of a frame set.
+  using Callback = std::function<void (int64_t, const Messages &)>;
+  // Called when a stream is marked degraded or is re-admitted.
+  using StreamCallback = std::function<void (int index, bool degraded)>;
+
+  DropoutSynchronizer(
+    size_t num_streams, int64_t matching_threshold_ns, size_t min_num_messages,
+    size_t max_num_pending, Clock::duration deadline, size_t num_readmit_frames);
+
+  void RegisterCallback(Callback callback) {callback_ = std::move(callback);}
+  void RegisterStreamCallback(StreamCallback callback) {stream_callback_ = std::move(callback);}
+
+  void AddMessage(
+    int index, int64_t timestamp, const T & msg, Clock::time_point now = Clock::now());
+
+  // Emits or drops the frame sets whose deadline has passed. Has to be called periodically, so
+  // that the deadline is met if no further messages arrive.
+  void CheckDeadlines(Clock::time_point now = Clock::now());
+
+  // May be read from any thread.
+  size_t NumDegraded() const {return num_degraded_.load(std::memory_order_relaxed);}
+  uint64_t NumPartial() const {return num_partial_.load(std::memory_order_relaxed);}
+  uint64_t NumDropped() const {return num_dropped_.load(std::memory_order_relaxed);}
+
+private:
+  // Timestamps that jump back further than this restart the synchronization, e.g. when a rosbag
+  // is restarted.
+  static constexpr int64_t kTimeJumpNs = 1'000'000'000;
+
+  struct FrameSet
+  {
+    // Timestamp of the first message, the others are matched against it.
+    int64_t timestamp;
+    int64_t latest_timestamp;
+    Clock::time_point deadline;
+    Messages messages;
+  };
+
+  struct Stream
+  {
+    bool degraded = false;
+    size_t num_on_time = 0;
+    // A degraded stream that has not delivered its message for the last emitted frame set yet.
+    bool owes_message = false;
+  };
+
+  bool IsComplete(const FrameSet & frame_set) const;
+  void Emit(FrameSet & frame_set, bool deadline_passed);
+  void Drop(FrameSet & frame_set);
+  void PopFront();
+  void CountOnTime(int index);
+  void SetDegraded(int index, bool degraded);
+
+  const int64_t matching_threshold_ns_;
+  const size_t min_num_messages_;
+  const size_t max_num_pending_;
+  const Clock::duration deadline_;
+  const size_t num_readmit_frames_;
+
+  std::vector<Stream> streams_;
+  // Sorted by timestamp.
+  std::vector<FrameSet> pending_;
+  // Message storage of emitted frame sets, reused for new ones.
+  std::vector<Messages> spare_messages_;
+  int64_t last_emitted_timestamp_ = -1;
+  Clock::time_point last_emitted_deadline_;
+
+  std::atomic<size_t> num_degraded_{0};
+  std::atomic<uint64_t> num_partial_{0};
+  std::atomic<uint64_t> num_dropped_{0};
+
+  Callback callback_ = [](int64_t, const Messages &) {};
+  StreamCallback stream_callback_ = [](int, bool) {};
+};
+
+template<class T>
+DropoutSynchronizer<T>::DropoutSynchronizer(
+  size_t num_streams, int64_t matching_threshold_ns, size_t min_num_messages,
+  size_t max_num_pending, Clock::duration deadline, size_t num_readmit_frames)
+: matching_threshold_ns_(matching_threshold_ns), min_num_messages_(min_num_messages),
+  max_num_pending_(std::max<size_t>(max_num_pending, 1)), deadline_(deadline),
+  num_readmit_frames_(std::max<size_t>(num_readmit_frames, 1)), streams_(num_streams)
+{
+  pending_.reserve(max_num_pending_ + 1);
+  spare_messages_.resize(max_num_pending_ + 1);
+  for (Messages & messages : spare_messages_) {
+    messages.reserve(num_streams);
+  }
+}
+
+template<class T>
+void DropoutSynchronizer<T>::AddMessage(
+  int index, int64_t timestamp, const T & msg, Clock::time_point now)
+{
+  if (index < 0 || static_cast<size_t>(index) >= streams_.size()) {
+    return;
+  }
+  if (timestamp < last_emitted_timestamp_ - kTimeJumpNs) {
+    while (!pending_.empty()) {
+      PopFront();
+    }
+    last_emitted_timestamp_ = -1;
+  }
+  if (last_emitted_timestamp_ >= 0 &&
+    timestamp <= last_emitted_timestamp_ + matching_threshold_ns_)
+  {
+    // Too late for its frame set. A degraded stream is not waited for, it is still on time if its
+    // message would have made the deadline.
+    Stream & stream = streams_[index];
+    if (stream.owes_message && now <= last_emitted_deadline_ &&
+      std::abs(timestamp - last_emitted_timestamp_) <= matching_threshold_ns_)
+    {
+      stream.owes_message = false;
+      CountOnTime(index);
+    } else {
+      stream.num_on_time = 0;
+    }
+    return;
+  }
+
+  auto it = std::find_if(
+    pending_.begin(), pending_.end(), [&](const FrameSet & frame_set) {
+      return std::abs(frame_set.timestamp - timestamp) <= matching_threshold_ns_;
+    });
+  if (it == pending_.end()) {
+    FrameSet frame_set{timestamp, timestamp, now + deadline_, {}};
+    if (!spare_messages_.empty()) {
+      frame_set.messages = std::move(spare_messages_.back());
+      spare_messages_.pop_back();
+    }
+    it = pending_.insert(
+      std::upper_bound(
+        pending_.begin(), pending_.end(), timestamp,
+        [](int64_t t, const FrameSet & frame_set) {return t < frame_set.timestamp;}),
+      std::move(frame_set));
+  }
+  auto message = std::find_if(
+    it->messages.begin(), it->messages.end(),
+    [index](const std::pair<int, T> & m) {return m.first == index;});
+  if (message != it->messages.end()) {
+    message->second = msg;
+  } else {
+    it->messages.emplace_back(index, msg);
+  }
+  it->latest_timestamp = std::max(it->latest_timestamp, timestamp);
+
+  // A full buffer gives up on the oldest frame set.
+  if (pending_.size() > max_num_pending_) {
+    if (pending_.front().messages.size() >= min_num_messages_) {
+      Emit(pending_.front(), true);
+    } else {
+      Drop(pending_.front());
+    }
+    PopFront();
+  }
+  CheckDeadlines(now);
+}
+
+template<class T>
+void DropoutSynchronizer<T>::CheckDeadlines(Clock::time_point now)
+{
+  while (!pending_.empty()) {
+    FrameSet & frame_set = pending_.front();
+    if (IsComplete(frame_set)) {
+      Emit(frame_set, false);
+    } else if (now < frame_set.deadline) {
+      // Newer frame sets wait for the oldest one, they are emitted in order.
+      return;
+    } else if (frame_set.messages.size() >= min_num_messages_) {
+      Emit(frame_set, true);
+    } else {
+      Drop(frame_set);
+    }
+    PopFront();
+  }
+}
+
+template<class T>
+bool DropoutSynchronizer<T>::IsComplete(const FrameSet & frame_set) const
+{
+  if (frame_set.messages.size() < min_num_messages_) {
+    return false;
+  }
+  size_t num_healthy = 0;
+  size_t num_healthy_present = 0;
+  for (size_t i = 0; i < streams_.size(); i++) {
+    if (!streams_[i].degraded) {
+      num_healthy++;
+    }
+  }
+  for (const auto & message : frame_set.messages) {
+    if (!streams_[message.first].degraded) {
+      num_healthy_present++;
+    }
+  }
+  return num_healthy_present == num_healthy;
+}
+
+template<class T>
+void DropoutSynchronizer<T>::Emit(FrameSet & frame_set, bool deadline_passed)
+{
+  for (size_t i = 0; i < streams_.size(); i++) {
+    const bool present = std::any_of(
+      frame_set.messages.begin(), frame_set.messages.end(),
+      [i](const std::pair<int, T> & m) {return m.first == static_cast<int>(i);});
+    Stream & stream = streams_[i];
+    if (present) {
+      stream.owes_message = false;
+      CountOnTime(i);
+    } else if (stream.degraded) {
+      // The message may still arrive before the deadline.
+      if (stream.owes_message) {
+        stream.num_on_time = 0;
+      }
+      stream.owes_message = true;
+    } else {
+      stream.num_on_time = 0;
+      if (deadline_passed) {
+        SetDegraded(i, true);
+      }
+    }
+  }
+  if (frame_set.messages.size() < streams_.size()) {
+    num_partial_.fetch_add(1, std::memory_order_relaxed);
+  }
+  last_emitted_timestamp_ = frame_set.timestamp;
+  last_emitted_deadline_ = frame_set.deadline;
+  callback_(frame_set.latest_timestamp, frame_set.messages);
+}
+
+template<class T>
+void DropoutSynchronizer<T>::Drop(FrameSet & frame_set)
+{
+  for (const auto & message : frame_set.messages) {
+    streams_[message.first].num_on_time = 0;
+  }
+  last_emitted_timestamp_ = frame_set.timestamp;
+  last_emitted_deadline_ = frame_set.deadline;
+  num_dropped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<class T>
+void DropoutSynchronizer<T>::PopFront()
+{
+  // Keep the storage of the messages, releasing the messages themselves.
+  Messages messages = std::move(pending_.front().messages);
+  messages.clear();
+  spare_messages_.push_back(std::move(messages));
+  pending_.erase(pending_.begin());
+}
+
+template<class T>
+void DropoutSynchronizer<T>::CountOnTime(int index)
+{
+  Stream & stream = streams_[index];
+  stream.num_on_time++;
+  if (stream.degraded && stream.num_on_time >= num_readmit_frames_) {
+    SetDegraded(index, false);
+  }
+}
+
+template<class T>
+void DropoutSynchronizer<T>::SetDegraded(int index, bool degraded)
+{
+  streams_[index].degraded = degraded;
+  streams_[index].owes_message = false;
+  if (degraded) {
+    num_degraded_.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    num_degraded_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  stream_callback_(index, degraded);
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__DROPOUT_SYNCHRONIZER_HPP_
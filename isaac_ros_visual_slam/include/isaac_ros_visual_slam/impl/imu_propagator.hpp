@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__IMU_PROPAGATOR_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__IMU_PROPAGATOR_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "isaac_ros_visual_slam/impl/limited_vector.hpp"
+#include "tf2/LinearMath/Transform.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Propagates the last tracked pose with IMU measurements, to provide poses at IMU rate between
+// camera frames. Everything is in ROS conventions: the pose is odom_pose_base_link and the
+// measurements are rotated from the imu frame into the base frame. Sensor biases and the lever
+// arm of the IMU are ignored, the state is re-anchored with every tracked frame.
+//
+// Thread safe, anchors and measurements may come from different threads.
+class ImuPropagator
+{
+public:
+  struct State
+  {
+    int64_t timestamp_ns = 0;
+    tf2::Transform pose;
+    // Linear velocity in the odom frame.
+    tf2::Vector3 linear_velocity;
+    // Angular velocity of the last measurement in the base frame.
+    tf2::Vector3 angular_velocity;
+  };
+
+  // buffer_size is the number of measurements kept to integrate them again after an anchor.
+  // Nothing is propagated further than max_propagation_time_ns past the anchor.
+  ImuPropagator(size_t buffer_size, int64_t max_propagation_time_ns);
+
+  void SetBasePoseImu(const tf2::Transform & base_pose_imu);
+
+  // Restarts the propagation at a tracked pose. linear_velocity is given in the odom frame and
+  // gravity in the base frame. Buffered measurements newer than the anchor are integrated again.
+  void Anchor(
+    int64_t timestamp_ns, const tf2::Transform & pose, const tf2::Vector3 & linear_velocity,
+    const tf2::Vector3 & gravity);
+
+  // Integrates a measurement in the imu frame. Returns the propagated state, or nothing if there
+  // is no anchor, the measurement is out of order or too far from the anchor.
+  std::optional<State> Add(
+    int64_t timestamp_ns, const tf2::Vector3 & angular_velocity,
+    const tf2::Vector3 & linear_acceleration);
+
+  // Drops the anchor, for example after tracking was lost.
+  void Reset();
+
+private:
+  struct Measurement
+  {
+    int64_t timestamp_ns;
+    tf2::Vector3 angular_velocity;
+    tf2::Vector3 linear_acceleration;
+  };
+
+  // Advances state_ to the measurement. Must be called with mutex_ held.
+  void Integrate(const Measurement & measurement);
+
+  const int64_t max_propagation_time_ns_;
+
+  std::mutex mutex_;
+  tf2::Matrix3x3 base_rotation_imu_;
+  // Measurements in the base frame.
+  limited_vector<Measurement> measurements_;
+  std::optional<State> state_;
+  int64_t anchor_timestamp_ns_ = 0;
+  // Gravity in the odom frame.
+  tf2::Vector3 gravity_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__IMU_PROPAGATOR_HPP_
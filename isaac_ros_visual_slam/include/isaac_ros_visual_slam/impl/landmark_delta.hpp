@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__LANDMARK_DELTA_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__LANDMARK_DELTA_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Id keyed diff of a landmark layer against the state that was last published on the delta topic.
+// Landmarks are added or moved if their id is new or their position or weight changed, and removed
+// if their id is no longer in the layer. A keyframe carries all landmarks and is due every
+// keyframe_period on the steady clock, independent of whether the layer still changes, so that
+// late subscribers of a static layer can resynchronize.
+// LandmarkList is a std::vector of landmarks with id, coords[3] and weight members.
+template<class LandmarkList>
+class LandmarkDelta
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Landmarks that moved less than this since their last publication are not sent again. In
+  // cuVSLAM units, i.e. meters.
+  static constexpr float kMoveThreshold = 1e-3f;
+
+  void Configure(std::chrono::nanoseconds keyframe_period, size_t max_landmarks)
+  {
+    keyframe_period_ = keyframe_period;
+    published_.reserve(max_landmarks);
+    changed_.reserve(max_landmarks);
+    removed_ids_.reserve(max_landmarks);
+  }
+
+  // Forgets the published state, so that the next update is a keyframe.
+  void Reset()
+  {
+    last_keyframe_time_.reset();
+    published_.clear();
+  }
+
+  bool HasKeyframe() const {return last_keyframe_time_.has_value();}
+
+  bool IsKeyframeDue(Clock::time_point now) const
+  {
+    return !last_keyframe_time_ || now - *last_keyframe_time_ >= keyframe_period_;
+  }
+
+  // Diffs landmarks against the published state and takes them as the new published state.
+  // Returns false if there is nothing to publish, i.e. no keyframe is due and nothing changed.
+  bool Update(const LandmarkList & landmarks, Clock::time_point now)
+  {
+    keyframe_ = IsKeyframeDue(now);
+    if (keyframe_) {
+      last_keyframe_time_ = now;
+    }
+    generation_++;
+    changed_.clear();
+    removed_ids_.clear();
+
+    for (const auto & landmark : landmarks) {
+      auto [it, added] = published_.try_emplace(landmark.id);
+      PublishedLandmark & published = it->second;
+      published.generation = generation_;
+      const bool changed = added || published.weight != landmark.weight ||
+        std::abs(published.coords[0] - landmark.coords[0]) > kMoveThreshold ||
+        std::abs(published.coords[1] - landmark.coords[1]) > kMoveThreshold ||
+        std::abs(published.coords[2] - landmark.coords[2]) > kMoveThreshold;
+      if (changed) {
+        std::copy(std::begin(landmark.coords), std::end(landmark.coords), published.coords);
+        published.weight = landmark.weight;
+      }
+      if (changed || keyframe_) {
+        changed_.push_back(landmark);
+      }
+    }
+    // Landmarks not touched by this update were removed from the layer.
+    for (auto it = published_.begin(); it != published_.end(); ) {
+      if (it->second.generation == generation_) {
+        ++it;
+        continue;
+      }
+      if (!keyframe_) {
+        removed_ids_.push_back(it->first);
+      }
+      it = published_.erase(it);
+    }
+    return keyframe_ || !changed_.empty() || !removed_ids_.empty();
+  }
+
+  // Result of the last Update(). A keyframe lists all landmarks as changed and none as removed.
+  bool IsKeyframe() const {return keyframe_;}
+  const LandmarkList & Changed() const {return changed_;}
+  const std::vector<uint64_t> & RemovedIds() const {return removed_ids_;}
+
+private:
+  struct PublishedLandmark
+  {
+    float coords[3];
+    float weight;
+    // Value of generation_ of the last update that contained the landmark.
+    uint64_t generation;
+  };
+
+  std::chrono::nanoseconds keyframe_period_{0};
+  std::optional<Clock::time_point> last_keyframe_time_;
+  uint64_t generation_ = 0;
+  std::unordered_map<uint64_t, PublishedLandmark> published_;
+
+  bool keyframe_ = false;
+  // Reused for every update.
+  LandmarkList changed_;
+  std::vector<uint64_t> removed_ids_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__LANDMARK_DELTA_HPP_
@@ -18,10 +18,13 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__LANDMARKS_VIS_HELPER_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__LANDMARKS_VIS_HELPER_HPP_
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 
 #include "viz_helper.hpp"
+#include "isaac_ros_visual_slam/impl/landmark_delta.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
 
 namespace nvidia
@@ -45,12 +48,31 @@ public:
   };
 
   LandmarksVisHelper(
+    VisScheduler & scheduler,
+    SubscriberPresence & presence,
+    int priority,
     cuvslam::Slam::DataLayer layer,
     uint32_t max_landmarks_count = 1024,
     ColorMode color_mode = CM_RGB_MODE, uint32_t period_ms = 500);
 
   ~LandmarksVisHelper() override;
 
+  using LandmarkList = decltype(cuvslam::Slam::Landmarks::landmarks);
+
+  // Writes the landmarks, transformed by canonical_pose_cuvslam, as x, y, z and rgb points into
+  // the data buffer of cloud in a single pass. The buffer is reused if it is large enough.
+  static void EncodeLandmarks(
+    const LandmarkList & landmarks, ColorMode color_mode,
+    const tf2::Transform & canonical_pose_cuvslam, PointCloud2Type & cloud);
+
+  // Additionally streams the layer as LandmarkCloudUpdate messages, which only carry the landmarks
+  // added, moved or removed since the previous update. Every keyframe_period_ms of wall time a
+  // keyframe with all landmarks is sent, also if the layer did not change, so that late subscribers
+  // can resynchronize. Must be called before Init().
+  void SetDeltaPublisher(
+    const rclcpp::Publisher<LandmarkCloudUpdateType>::SharedPtr delta_publisher,
+    double keyframe_period_ms);
+
   void Init(
     const rclcpp::Publisher<PointCloud2Type>::SharedPtr publisher,
     std::shared_ptr<cuvslam::Slam> & cuvslam_slam,
@@ -61,9 +83,13 @@ public:
 
   void Reset() override;
 
-  void Run();
+  void Run() override;
 
 protected:
+  // Diffs landmarks against the published state and publishes the resulting update.
+  void PublishDelta(
+    const cuvslam::Slam::Landmarks & landmarks, std::chrono::steady_clock::time_point now);
+
   cuvslam::Slam::DataLayer layer_;
   uint32_t max_landmarks_count_ = 1024;
 
@@ -73,10 +99,16 @@ protected:
 
   uint32_t period_ms_ = 500;
 
-  // Point cloud to visualize tracks
-  using pointcloud_msg_t = std::unique_ptr<PointCloud2Type>;
+  // Point cloud to visualize tracks. Reused for every publication.
+  PointCloud2Type cloud_;
 
   rclcpp::Publisher<PointCloud2Type>::SharedPtr publisher_;
+  const std::atomic<bool> * has_subscribers_ = nullptr;
+
+  rclcpp::Publisher<LandmarkCloudUpdateType>::SharedPtr delta_publisher_;
+  const std::atomic<bool> * has_delta_subscribers_ = nullptr;
+  LandmarkDelta<LandmarkList> delta_;
+  LandmarkCloudUpdateType update_;
 };
 
 }  // namespace visual_slam
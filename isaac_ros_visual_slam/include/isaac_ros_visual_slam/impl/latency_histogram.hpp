@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__LATENCY_HISTOGRAM_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__LATENCY_HISTOGRAM_HPP_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Fixed size latency histogram with logarithmic buckets (HDR histogram layout).
+// Every power of two range of nanoseconds is split into kSubBuckets linear buckets, so any
+// recorded value is reported with a relative error below 1 / kSubBuckets (~3%). Values up to
+// ~18 minutes are tracked, larger values are clamped.
+//
+// Samples are recorded into the current of two windows. Rotate() discards the previous window and
+// starts a new one, the statistics cover the current and the previous window. Rotating
+// periodically keeps them recent, while they never lack samples right after a rotation.
+//
+// Record() is lock-free and does not allocate. It may be called concurrently from several threads.
+// Rotate() and Reset() must not be called concurrently with each other.
+class LatencyHistogram
+{
+public:
+  static constexpr int kSubBucketBits = 5;
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  static constexpr int kMaxValueBits = 40;
+  static constexpr uint64_t kMaxValue = (uint64_t{1} << kMaxValueBits) - 1;
+  static constexpr size_t kNumBuckets = kSubBuckets * (kMaxValueBits - kSubBucketBits + 1);
+
+  template<class Rep, class Period>
+  void Record(std::chrono::duration<Rep, Period> duration)
+  {
+    const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    const uint64_t value = std::min<uint64_t>(std::max<int64_t>(ns, 0), kMaxValue);
+    Window & window = windows_[current_.load(std::memory_order_relaxed)];
+    window.counts[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    window.total_count.fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = window.max.load(std::memory_order_relaxed);
+    while (value > max &&
+      !window.max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  // Computes the values at the given quantiles in [0, 1] in a single pass over the buckets.
+  // The quantiles must be sorted in ascending order. Results are in seconds and are 0 if nothing
+  // was recorded yet.
+  template<size_t N>
+  std::array<double, N> Percentiles(const std::array<double, N> & quantiles) const
+  {
+    std::array<double, N> results{};
+    const uint64_t total = Count();
+    if (total == 0) {
+      return results;
+    }
+    size_t q = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets && q < N; i++) {
+      for (const Window & window : windows_) {
+        seen += window.counts[i].load(std::memory_order_relaxed);
+      }
+      while (q < N && seen >= Rank(quantiles[q], total)) {
+        results[q++] = ToSeconds(BucketUpperBound(i));
+      }
+    }
+    // Buckets might be updated concurrently. Anything left over is reported as the max.
+    for (; q < N; q++) {
+      results[q] = MaxSeconds();
+    }
+    return results;
+  }
+
+  uint64_t Count() const
+  {
+    uint64_t count = 0;
+    for (const Window & window : windows_) {
+      count += window.total_count.load(std::memory_order_relaxed);
+    }
+    return count;
+  }
+
+  double MaxSeconds() const
+  {
+    uint64_t max = 0;
+    for (const Window & window : windows_) {
+      max = std::max(max, window.max.load(std::memory_order_relaxed));
+    }
+    return ToSeconds(max);
+  }
+
+  void Rotate()
+  {
+    const size_t next = 1 - current_.load(std::memory_order_relaxed);
+    windows_[next].Clear();
+    current_.store(next, std::memory_order_relaxed);
+  }
+
+  void Reset()
+  {
+    for (Window & window : windows_) {
+      window.Clear();
+    }
+  }
+
+private:
+  struct Window
+  {
+    void Clear()
+    {
+      for (auto & count : counts) {
+        count.store(0, std::memory_order_relaxed);
+      }
+      total_count.store(0, std::memory_order_relaxed);
+      max.store(0, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, kNumBuckets> counts{};
+    std::atomic<uint64_t> total_count{0};
+    std::atomic<uint64_t> max{0};
+  };
+
+  static size_t BucketIndex(uint64_t value)
+  {
+    if (value < kSubBuckets) {
+      return value;
+    }
+    const int msb = 63 - __builtin_clzll(value);
+    const int shift = msb - kSubBucketBits;
+    // The kSubBucketBits bits below the most significant bit select the linear sub bucket.
+    const uint64_t sub_bucket = (value >> shift) - kSubBuckets;
+    return kSubBuckets + shift * kSubBuckets + sub_bucket;
+  }
+
+  // Highest value that falls into the bucket.
+  static uint64_t BucketUpperBound(size_t index)
+  {
+    if (index < kSubBuckets) {
+      return index;
+    }
+    const uint64_t shift = (index - kSubBuckets) / kSubBuckets;
+    const uint64_t sub_bucket = (index - kSubBuckets) % kSubBuckets;
+    return ((kSubBuckets + sub_bucket + 1) << shift) - 1;
+  }
+
+  static uint64_t Rank(double quantile, uint64_t total)
+  {
+    const double rank = std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total);
+    return std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(rank)));
+  }
+
+  static double ToSeconds(uint64_t ns)
+  {
+    constexpr double kNanoSecInSec = 1000000000.0;
+    return ns / kNanoSecInSec;
+  }
+
+  std::array<Window, 2> windows_;
+  std::atomic<size_t> current_{0};
+};
+
+// Remembers when the most recent messages with a given timestamp arrived, so that the time they
+// spent waiting in a buffer can be measured once they come out of it. Old entries are overwritten.
+class ArrivalTimes
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit ArrivalTimes(size_t capacity)
+  : entries_(std::max<size_t>(capacity, 1))
+  {
+  }
+
+  void Add(int64_t timestamp, Clock::time_point arrival_time)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[next_] = {timestamp, arrival_time};
+    next_ = (next_ + 1) % entries_.size();
+  }
+
+  // Gets the earliest arrival of a message with this timestamp. Returns false if no message with
+  // this timestamp is remembered.
+  bool Find(int64_t timestamp, Clock::time_point & arrival_time) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool found = false;
+    for (const Entry & entry : entries_) {
+      if (entry.timestamp == timestamp && (!found || entry.arrival_time < arrival_time)) {
+        arrival_time = entry.arrival_time;
+        found = true;
+      }
+    }
+    return found;
+  }
+
+private:
+  struct Entry
+  {
+    int64_t timestamp = -1;
+    Clock::time_point arrival_time;
+  };
+
+  std::vector<Entry> entries_;
+  size_t next_ = 0;
+  mutable std::mutex mutex_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__LATENCY_HISTOGRAM_HPP_
@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__LATEST_VALUE_CACHE_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__LATEST_VALUE_CACHE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Keeps the latest few values of several channels by timestamp, for streams that accompany the
+// camera images but must not hold them back, like segmentation masks. Consumers look up the
+// value closest to the timestamp of their frame instead of waiting for it.
+//
+// Thread safe, values are added and looked up from different threads.
+template<class T>
+class LatestValueCache
+{
+public:
+  // Every channel keeps its last depth values.
+  LatestValueCache(size_t num_channels, size_t depth)
+  : channels_(num_channels, Channel{std::vector<Entry>(std::max<size_t>(depth, 1)), 0}) {}
+
+  void Add(size_t channel, int64_t timestamp, const T & value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (channel >= channels_.size()) {
+      return;
+    }
+    Channel & c = channels_[channel];
+    c.entries[c.next] = Entry{timestamp, value};
+    c.next = c.next + 1 < c.entries.size() ? c.next + 1 : 0;
+  }
+
+  // Copies the value of the channel that is closest to timestamp, the newer one of two equally
+  // close values, into value. Returns false and leaves value untouched if there is no value within
+  // tolerance_ns.
+  bool Find(
+    size_t channel, int64_t timestamp, int64_t tolerance_ns, std::optional<T> & value) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (channel >= channels_.size()) {
+      return false;
+    }
+    const Entry * best = nullptr;
+    for (const Entry & entry : channels_[channel].entries) {
+      if (!entry.value) {
+        continue;
+      }
+      const int64_t distance = std::abs(entry.timestamp - timestamp);
+      if (distance > tolerance_ns) {
+        continue;
+      }
+      const int64_t best_distance = best ? std::abs(best->timestamp - timestamp) : 0;
+      if (!best || distance < best_distance ||
+        (distance == best_distance && entry.timestamp > best->timestamp))
+      {
+        best = &entry;
+      }
+    }
+    if (!best) {
+      return false;
+    }
+    value = best->value;
+    return true;
+  }
+
+  void Clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (Channel & channel : channels_) {
+      std::fill(channel.entries.begin(), channel.entries.end(), Entry{});
+      channel.next = 0;
+    }
+  }
+
+private:
+  struct Entry
+  {
+    int64_t timestamp = 0;
+    std::optional<T> value;
+  };
+
+  struct Channel
+  {
+    std::vector<Entry> entries;
+    size_t next;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Channel> channels_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__LATEST_VALUE_CACHE_HPP_
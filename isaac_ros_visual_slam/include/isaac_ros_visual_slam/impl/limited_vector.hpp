@@ -18,6 +18,8 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__LIMITED_VECTOR_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__LIMITED_VECTOR_HPP_
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 namespace nvidia
@@ -27,31 +29,69 @@ namespace isaac_ros
 namespace visual_slam
 {
 
-// limited_vector
+// limited_vector keeps the last max_size added values in a ring buffer. Adding a value is O(1)
+// independent of the size. Index 0 is the oldest value.
 template<class T>
 class limited_vector
 {
   const uint max_size_;
   std::vector<T> data;
+  // Position of the oldest value in data once the buffer is full.
+  size_t head_ = 0;
+  // Number of values added since construction, including the ones that were overwritten.
+  uint64_t num_added_ = 0;
 
 public:
   explicit limited_vector(uint max_size)
   : max_size_(max_size)
   {
+    data.reserve(max_size_);
   }
   void add(const T & value)
   {
-    // tracking_vo_path_pub_
-    if (data.size() >= max_size_) {
-      std::rotate(data.begin(), data.begin() + 1, data.end());
-      data.back() = value;
-    } else {
+    num_added_++;
+    if (max_size_ == 0) {
+      return;
+    }
+    if (data.size() < max_size_) {
       data.push_back(value);
+      return;
+    }
+    // Overwrite the oldest value.
+    data[head_] = value;
+    head_ = head_ + 1 == data.size() ? 0 : head_ + 1;
+  }
+  size_t size() const
+  {
+    return data.size();
+  }
+  uint64_t numAdded() const
+  {
+    return num_added_;
+  }
+  const T & operator[](size_t index) const
+  {
+    const size_t position = head_ + index;
+    return data[position < data.size() ? position : position - data.size()];
+  }
+  // Copies the last count values in order into out, reusing its capacity.
+  void copyLast(size_t count, std::vector<T> & out) const
+  {
+    count = std::min(count, data.size());
+    const size_t first = data.size() - count;
+    out.clear();
+    // The values are stored in at most two contiguous segments.
+    for (size_t i = first; i < data.size(); ) {
+      const size_t position = head_ + i < data.size() ? head_ + i : head_ + i - data.size();
+      const size_t segment = std::min(data.size() - i, data.size() - position);
+      out.insert(out.end(), data.begin() + position, data.begin() + position + segment);
+      i += segment;
     }
   }
-  const std::vector<T> & getData() const
+  // Copies all values in order into out, reusing its capacity.
+  void copyTo(std::vector<T> & out) const
   {
-    return data;
+    copyLast(data.size(), out);
   }
 };
 
@@ -18,6 +18,7 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__LOCALIZER_VIS_HELPER_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__LOCALIZER_VIS_HELPER_HPP_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -36,6 +37,9 @@ struct LocalizerVisHelper : public VisHelper
 {
 public:
   LocalizerVisHelper(
+    VisScheduler & scheduler,
+    SubscriberPresence & presence,
+    int priority,
     uint32_t max_items_count = 1024,
     uint32_t period_ms = 500
   );
@@ -51,7 +55,7 @@ public:
 
   void Reset() override;
 
-  void Run();
+  void Run() override;
 
   void SetResult(bool succeeded, const tf2::Transform & pose);
 
@@ -68,6 +72,7 @@ protected:
   tf2::Transform result_pose_;
 
   rclcpp::Publisher<MarkerArrayType>::SharedPtr publisher_localizer_probes_;
+  const std::atomic<bool> * has_localizer_probes_subscribers_ = nullptr;
 };
 
 }  // namespace visual_slam
@@ -23,7 +23,7 @@
 #include <utility>
 #include <vector>
 
-#include "isaac_common/messaging/message_buffer.hpp"
+#include "isaac_ros_visual_slam/impl/spsc_ring_buffer.hpp"
 
 namespace nvidia
 {
@@ -32,17 +32,45 @@ namespace isaac_ros
 namespace visual_slam
 {
 
+// Non-owning view on a contiguous batch of messages. Only valid for the duration of the callback
+// it was passed to.
+template<class T>
+class BatchView
+{
+public:
+  BatchView() = default;
+  BatchView(const T * data, size_t size)
+  : data_(data), size_(size) {}
+
+  const T * begin() const {return data_;}
+  const T * end() const {return data_ + size_;}
+  const T & operator[](size_t i) const {return data_[i];}
+  size_t size() const {return size_;}
+  bool empty() const {return size_ == 0;}
+
+  // Copy for callers that need to keep the messages beyond the callback. This allocates, so it
+  // is not an implicit conversion.
+  std::vector<T> ToVector() const {return std::vector<T>(begin(), end());}
+
+private:
+  const T * data_ = nullptr;
+  size_t size_ = 0;
+};
+
 // This class is designed to generate an interleaved sequence of messages from two separate streams.
 // Streams are named stream1 and stream2 and assumption is stream1 is faster than stream2.
+// Each stream is buffered in a fixed capacity ring and the batch handed to the callback is backed
+// by storage owned by the sequencer, so sequencing does not allocate once the buffers are warmed
+// up.
 
 template<class T1, class T2>
 class MessageStreamSequencer
 {
 public:
-  using Callback = std::function<void (const std::vector<T1> &, const T2 &)>;
+  using Callback = std::function<void (const BatchView<T1> &, const T2 &)>;
 
   explicit MessageStreamSequencer(
-    uint8_t size_stream1, int64_t eps_stream1, uint8_t size_stream2, int64_t eps_stream2);
+    size_t size_stream1, int64_t eps_stream1, size_t size_stream2, int64_t eps_stream2);
   void CallbackStream1(const int64_t & timestamp, const T1 & msg);
   void CallbackStream2(const int64_t & timestamp, const T2 & msg);
   int64_t GetNextTimeStampStream1();
@@ -52,37 +80,77 @@ public:
   void RegisterCallback(Callback callback);
 
 private:
-  isaac_common::messaging::MessageBuffer<T1> stream1_buff_;
+  // Ring of buffered messages together with the timestamps the sequencing logic relies on.
+  template<class T>
+  struct Stream
+  {
+    explicit Stream(size_t size)
+    : buffer(size) {}
+
+    // Both ends of the ring are driven by the sequencer, so the oldest message can be dropped to
+    // make room for the new one.
+    void Push(int64_t timestamp, const T & msg)
+    {
+      if (buffer.IsFull()) {
+        buffer.Drop();
+      }
+      buffer.Push(timestamp, msg);
+      current_ts = timestamp;
+    }
+    void PopInto(T & msg)
+    {
+      last_ts = buffer.FrontTimeStamp();
+      buffer.PopInto(msg);
+    }
+    void Drop()
+    {
+      last_ts = buffer.FrontTimeStamp();
+      buffer.Drop();
+    }
+
+    SpscRingBuffer<T> buffer;
+    // Timestamp of the latest pushed message.
+    int64_t current_ts = 0;
+    // Timestamp of the latest popped message.
+    int64_t last_ts = 0;
+  };
+
+  void EmitBatch();
+
+  Stream<T1> stream1_;
   int64_t epsilon_stream1_;
-  isaac_common::messaging::MessageBuffer<T2> stream2_buff_;
+  Stream<T2> stream2_;
   int64_t epsilon_stream2_;
-  Callback registered_callback_ = [](const std::vector<T1> &, const T2 &) {};
+  // Reused output storage for the batch passed to the callback.
+  std::vector<T1> stream1_batch_;
+  T2 stream2_msg_{};
+  Callback registered_callback_ = [](const BatchView<T1> &, const T2 &) {};
 };
 
 template<class T1, class T2>
 MessageStreamSequencer<T1, T2>::MessageStreamSequencer(
-  uint8_t size_stream1, int64_t eps_stream1,
-  uint8_t size_stream2, int64_t eps_stream2)
-: stream1_buff_{size_stream1}, epsilon_stream1_{eps_stream1},
-  stream2_buff_{size_stream2}, epsilon_stream2_{eps_stream2}
+  size_t size_stream1, int64_t eps_stream1,
+  size_t size_stream2, int64_t eps_stream2)
+: stream1_{size_stream1}, epsilon_stream1_{eps_stream1},
+  stream2_{size_stream2}, epsilon_stream2_{eps_stream2}
 {
+  stream1_batch_.reserve(stream1_.buffer.Capacity());
 }
 
 template<class T1, class T2>
 void MessageStreamSequencer<T1, T2>::CallbackStream1(const int64_t & timestamp, const T1 & msg)
 {
-  stream1_buff_.Push(timestamp, msg);
-  std::pair<std::vector<T1>, T2> result;
-  auto curr_msg_ts = stream1_buff_.GetCurrentTimeStamp();
-  auto last_msg_ts = stream1_buff_.GetLastTimeStamp();
-  auto next_msg_ts = stream1_buff_.GetNextTimeStamp();
-  auto stream2_curr_ts = stream2_buff_.GetCurrentTimeStamp();
-  auto stream2_next_ts = stream2_buff_.GetNextTimeStamp();
-  auto stream2_last_ts = stream2_buff_.GetLastTimeStamp();
+  stream1_.Push(timestamp, msg);
+  auto curr_msg_ts = stream1_.current_ts;
+  auto last_msg_ts = stream1_.last_ts;
+  auto next_msg_ts = stream1_.buffer.FrontTimeStamp();
+  auto stream2_curr_ts = stream2_.current_ts;
+  auto stream2_next_ts = stream2_.buffer.FrontTimeStamp();
+  auto stream2_last_ts = stream2_.last_ts;
 
   // Ignoring late stream1 msg
   if (curr_msg_ts < stream2_last_ts) {
-    stream1_buff_.Pop();
+    stream1_.Drop();
     return;
   }
 
@@ -101,18 +169,16 @@ void MessageStreamSequencer<T1, T2>::CallbackStream1(const int64_t & timestamp,
 
     // Process all the stored msgs from stream2 till current time of stream1
     while ((curr_msg_ts >= stream2_next_ts || other_esp_timeout || self_esp_timeout) &&
-      !stream2_buff_.IsEmpty())
+      !stream2_.buffer.IsEmpty())
     {
       // Process all the stored msgs from stream1 till current time of stream1
-      while (!stream1_buff_.IsEmpty() && stream2_next_ts >= next_msg_ts) {
-        result.first.emplace_back(stream1_buff_.Pop());
-        next_msg_ts = stream1_buff_.GetNextTimeStamp();
+      while (!stream1_.buffer.IsEmpty() && stream2_next_ts >= next_msg_ts) {
+        stream1_.PopInto(stream1_batch_.emplace_back());
+        next_msg_ts = stream1_.buffer.FrontTimeStamp();
       }
-      result.second = stream2_buff_.Pop();
-      registered_callback_(result.first, result.second);
-      // Clearing stream1 msgs for the subsequent runs
-      result.first.clear();
-      stream2_next_ts = stream2_buff_.GetNextTimeStamp();
+      stream2_.PopInto(stream2_msg_);
+      EmitBatch();
+      stream2_next_ts = stream2_.buffer.FrontTimeStamp();
     }
   }
 }
@@ -120,17 +186,16 @@ void MessageStreamSequencer<T1, T2>::CallbackStream1(const int64_t & timestamp,
 template<class T1, class T2>
 void MessageStreamSequencer<T1, T2>::CallbackStream2(const int64_t & timestamp, const T2 & msg)
 {
-  stream2_buff_.Push(timestamp, msg);
+  stream2_.Push(timestamp, msg);
 
-  std::pair<std::vector<T1>, T2> result;
-  auto curr_msg_ts = stream2_buff_.GetCurrentTimeStamp();
-  auto last_msg_ts = stream2_buff_.GetLastTimeStamp();
-  auto stream1_curr_ts = stream1_buff_.GetCurrentTimeStamp();
-  auto stream1_next_ts = stream1_buff_.GetNextTimeStamp();
+  auto curr_msg_ts = stream2_.current_ts;
+  auto last_msg_ts = stream2_.last_ts;
+  auto stream1_curr_ts = stream1_.current_ts;
+  auto stream1_next_ts = stream1_.buffer.FrontTimeStamp();
 
   // Ignoring late stream2 msg
-  if (curr_msg_ts < stream1_buff_.GetLastTimeStamp()) {
-    stream2_buff_.Pop();
+  if (curr_msg_ts < stream1_.last_ts) {
+    stream2_.Drop();
     return;
   }
 
@@ -147,38 +212,46 @@ void MessageStreamSequencer<T1, T2>::CallbackStream2(const int64_t & timestamp,
 
     // Process all the stored msgs from stream2 till current time of stream1
     while (((curr_msg_ts >= stream1_next_ts && curr_msg_ts <= stream1_curr_ts) ||
-      self_timeout || other_timeout) && !stream2_buff_.IsEmpty())
+      self_timeout || other_timeout) && !stream2_.buffer.IsEmpty())
     {
       // Process all the stored msgs from stream1 till current time of stream1
-      while (curr_msg_ts >= stream1_next_ts && !stream1_buff_.IsEmpty()) {
-        result.first.emplace_back(stream1_buff_.Pop());
-        stream1_next_ts = stream1_buff_.GetNextTimeStamp();
+      while (curr_msg_ts >= stream1_next_ts && !stream1_.buffer.IsEmpty()) {
+        stream1_.PopInto(stream1_batch_.emplace_back());
+        stream1_next_ts = stream1_.buffer.FrontTimeStamp();
       }
-      result.second = stream2_buff_.Pop();
-      registered_callback_(result.first, result.second);
-      // Clearing stream1 msgs for the subsequent runs
-      result.first.clear();
+      stream2_.PopInto(stream2_msg_);
+      EmitBatch();
     }
   }
 }
 
+template<class T1, class T2>
+void MessageStreamSequencer<T1, T2>::EmitBatch()
+{
+  registered_callback_(
+    BatchView<T1>(stream1_batch_.data(), stream1_batch_.size()), stream2_msg_);
+  // Clearing stream1 msgs for the subsequent runs. Capacity of both outputs is kept.
+  stream1_batch_.clear();
+  ResetMessage(stream2_msg_);
+}
+
 template<class T1, class T2>
 int64_t MessageStreamSequencer<T1, T2>::GetNextTimeStampStream1()
 {
-  return stream1_buff_.GetNextTimeStamp();
+  return stream1_.buffer.FrontTimeStamp();
 }
 
 template<class T1, class T2>
 int64_t MessageStreamSequencer<T1, T2>::GetNextTimeStampStream2()
 {
-  return stream2_buff_.GetNextTimeStamp();
+  return stream2_.buffer.FrontTimeStamp();
 }
 
 template<class T1, class T2>
-size_t MessageStreamSequencer<T1, T2>::GetSizeStream1() {return stream1_buff_.Size();}
+size_t MessageStreamSequencer<T1, T2>::GetSizeStream1() {return stream1_.buffer.Size();}
 
 template<class T1, class T2>
-size_t MessageStreamSequencer<T1, T2>::GetSizeStream2() {return stream2_buff_.Size();}
+size_t MessageStreamSequencer<T1, T2>::GetSizeStream2() {return stream2_.buffer.Size();}
 
 template<class T1, class T2>
 void MessageStreamSequencer<T1, T2>::RegisterCallback(Callback callback)
@@ -19,9 +19,9 @@
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__POSE_CACHE_HPP_
 
 #include <array>
-#include <list>
-#include <utility>
+#include <vector>
 
+#include "Eigen/Core"
 #include "tf2/LinearMath/Transform.h"
 #include "tf2/LinearMath/Quaternion.h"
 
@@ -31,25 +31,106 @@ namespace isaac_ros
 {
 namespace visual_slam
 {
+
+// Mean and covariance of a sliding window of samples, updated in O(1) per sample with Welford's
+// algorithm.
+template<int N>
+class RunningCovariance
+{
+public:
+  using Vector = Eigen::Matrix<double, N, 1>;
+  using Matrix = Eigen::Matrix<double, N, N>;
+
+  void Reset()
+  {
+    count_ = 0;
+    mean_.setZero();
+    m2_.setZero();
+  }
+
+  void Add(const Vector & x)
+  {
+    count_++;
+    const Vector delta = x - mean_;
+    mean_ += delta / count_;
+    m2_.noalias() += delta * (x - mean_).transpose();
+  }
+
+  // x has to be one of the samples that were added before.
+  void Remove(const Vector & x)
+  {
+    if (count_ <= 1) {
+      Reset();
+      return;
+    }
+    const Vector mean_before = mean_;
+    mean_ = (mean_ * count_ - x) / (count_ - 1);
+    count_--;
+    m2_.noalias() -= (x - mean_) * (x - mean_before).transpose();
+  }
+
+  size_t Count() const {return count_;}
+
+  const Vector & Mean() const {return mean_;}
+
+  // Population covariance, i.e. normalized by the number of samples.
+  Matrix Covariance() const {return m2_ / count_;}
+
+private:
+  size_t count_ = 0;
+  Vector mean_ = Vector::Zero();
+  Matrix m2_ = Matrix::Zero();
+};
+
+// Keeps the last window_size poses in a fixed size ring. The covariance statistics are updated
+// incrementally, so every call costs the same independent of the window size.
 class PoseCache
 {
 public:
+  explicit PoseCache(size_t window_size = 10);
+
   void Reset();
   void Add(int64_t timestamp, const tf2::Transform & pose);
 
+  // Velocity between the oldest and the newest of the last 10 poses, in the base frame of the
+  // oldest of them.
   bool GetVelocity(
     double & x, double & y, double & z,
     double & roll, double & pitch, double & yaw) const;
+  // Linear velocity over the same poses in the frame the poses are given in, e.g. odom.
+  bool GetLinearVelocity(tf2::Vector3 & linear_velocity) const;
   bool GetCovariance(std::array<double, 6 * 6> & cov) const;
 
 protected:
-  const size_t num_poses_to_keep_ = 10;
-  std::list<std::pair<int64_t, tf2::Transform>> poses_;
+  // Translation and quaternion x, y, z, w.
+  using Sample = RunningCovariance<7>::Vector;
+
+  struct Entry
+  {
+    int64_t timestamp;
+    tf2::Transform pose;
+    Sample sample;
+  };
+
+  // Index 0 is the oldest pose.
+  const Entry & At(size_t index) const;
+
+  const size_t window_size_;
+  std::vector<Entry> poses_;
+  size_t head_ = 0;
+  // The statistics are recomputed from the window once per window_size adds to bound the
+  // accumulated rounding errors, which keeps the amortized cost constant.
+  size_t num_adds_since_recompute_ = 0;
+  // The quaternions are sign aligned with their predecessor before they enter the statistics.
+  tf2::Vector3 prev_axis_ = {0, 0, 0};
+  RunningCovariance<7> statistics_;
 };
 
 class VelocityCache
 {
 public:
+  explicit VelocityCache(size_t window_size = 10);
+
   void Reset();
   void Add(
     const double & x, const double & y, const double & z, const double & roll,
@@ -58,8 +139,13 @@ public:
   bool GetCovariance(std::array<double, 6 * 6> & cov) const;
 
 private:
-  const size_t num_velocities_to_keep_ = 10;
-  std::list<std::array<double, 6>> velocities_;
+  using Sample = RunningCovariance<6>::Vector;
+
+  const size_t window_size_;
+  std::vector<Sample> velocities_;
+  size_t head_ = 0;
+  size_t num_adds_since_recompute_ = 0;
+  RunningCovariance<6> statistics_;
 };
 
 }  // namespace visual_slam
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__POSE_HISTORY_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__POSE_HISTORY_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "tf2/LinearMath/Quaternion.h"
+#include "tf2/LinearMath/Transform.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Time indexed history of the tracked poses of the base frame, in the odom and in the map frame.
+// The poses are kept in a ring sorted by timestamp, so a pose at an arbitrary timestamp is found
+// with a binary search and interpolated between its neighbours. Timestamps up to
+// max_extrapolation_ns outside of the history are extrapolated with the motion of the two
+// outermost poses. The map poses are recorded as they were tracked, later loop closures do not
+// change them.
+//
+// Thread safe, a batch of queries takes the lock once.
+class PoseHistory
+{
+public:
+  enum class Frame
+  {
+    kOdom,
+    kMap,
+  };
+
+  PoseHistory(size_t capacity, int64_t max_extrapolation_ns);
+
+  void Reset();
+
+  // Appends a pose. A time jump back clears the history first, an equal timestamp replaces the
+  // newest pose.
+  void Add(int64_t timestamp, const tf2::Transform & odom_pose, const tf2::Transform & map_pose);
+
+  // Marks that tracking was lost. Nothing is interpolated across the gap, and nothing is
+  // extrapolated past the newest pose until the next pose is added.
+  void MarkDiscontinuity();
+
+  // Writes the pose at every timestamp to poses, or nothing if the timestamp can not be answered.
+  // Returns the number of poses found.
+  size_t GetPoses(
+    Frame frame, const std::vector<int64_t> & timestamps,
+    std::vector<std::optional<tf2::Transform>> & poses) const;
+
+private:
+  struct Pose
+  {
+    tf2::Vector3 origin;
+    tf2::Quaternion rotation;
+  };
+
+  struct Entry
+  {
+    int64_t timestamp;
+    Pose odom;
+    Pose map;
+    // True if tracking was lost between the previous and this entry.
+    bool follows_gap;
+  };
+
+  // Index 0 is the oldest entry.
+  const Entry & At(size_t index) const;
+  std::optional<tf2::Transform> GetPose(Frame frame, int64_t timestamp) const;
+  // Interpolates between two entries, or extrapolates for timestamps outside of them.
+  static tf2::Transform Interpolate(
+    Frame frame, const Entry & a, const Entry & b, int64_t timestamp);
+
+  const size_t capacity_;
+  const int64_t max_extrapolation_ns_;
+
+  mutable std::mutex mutex_;
+  std::vector<Entry> entries_;
+  // Position of the oldest entry once the ring is full.
+  size_t head_ = 0;
+  bool lost_ = false;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__POSE_HISTORY_HPP_
@@ -18,6 +18,7 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__POSEGRAPH_VIS_HELPER_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__POSEGRAPH_VIS_HELPER_HPP_
 
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -36,6 +37,9 @@ struct PoseGraphVisHelper : public VisHelper
 {
 public:
   PoseGraphVisHelper(
+    VisScheduler & scheduler,
+    SubscriberPresence & presence,
+    int priority,
     cuvslam::Slam::DataLayer layer,
     uint32_t max_items_count = 1024,
     uint32_t period_ms = 500
@@ -53,7 +57,7 @@ public:
 
   void Reset() override;
 
-  void Run();
+  void Run() override;
 
 protected:
   cuvslam::Slam::DataLayer layer_ = cuvslam::Slam::DataLayer::PoseGraph;
@@ -67,6 +71,9 @@ protected:
   rclcpp::Publisher<PoseArrayType>::SharedPtr publisher_nodes_;
   rclcpp::Publisher<MarkerType>::SharedPtr publisher_edges_;
   rclcpp::Publisher<MarkerType>::SharedPtr publisher_edges2_;
+  const std::atomic<bool> * has_nodes_subscribers_ = nullptr;
+  const std::atomic<bool> * has_edges_subscribers_ = nullptr;
+  const std::atomic<bool> * has_edges2_subscribers_ = nullptr;
 };
 
 }  // namespace visual_slam
@@ -0,0 +1,81 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__RIG_CACHE_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__RIG_CACHE_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/types.hpp"
+#include "tf2/LinearMath/Transform.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// On-disk cache of everything the rig calibration is built from: the camera info messages, the
+// initial IMU message and the extrinsics looked up in the tf tree. With it the tracker can be
+// created without waiting for messages and transforms.
+//
+// The file name contains a hash of the configuration of the rig, like the frame names, so that a
+// cache is only used for the configuration it was written for. The camera info messages can only
+// be compared to the live ones once they arrive, HashCameraInfo() compares their calibration.
+class RigCache
+{
+public:
+  struct Contents
+  {
+    std::map<int, CameraInfoType::ConstSharedPtr> camera_infos;
+    // Not set if the IMU is not used.
+    ImuType::ConstSharedPtr imu;
+    // Extrinsics by target and source frame.
+    std::map<std::pair<std::string, std::string>, tf2::Transform> transforms;
+  };
+
+  // config identifies the configuration of the rig, the cache file is placed in directory.
+  RigCache(const std::string & directory, const std::vector<std::string> & config);
+
+  const std::string & Path() const {return path_;}
+  bool Exists() const;
+
+  // Throws std::runtime_error if the file can not be read or was written for a different version
+  // or configuration.
+  Contents Load() const;
+  // Replaces the file atomically. Throws std::runtime_error on failure.
+  void Save(const Contents & contents) const;
+  void Remove() const;
+
+  // Hash of the parts of a camera info message that the calibration depends on.
+  static uint64_t HashCameraInfo(const CameraInfoType & msg);
+
+private:
+  uint64_t config_hash_;
+  std::string path_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__RIG_CACHE_HPP_
@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__SENSOR_TIME_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__SENSOR_TIME_HPP_
+
+#include <cstdint>
+#include <optional>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Whether the sensor clock went back from last_timestamp to timestamp, in nanoseconds. This happens
+// when a rosbag is restarted, and state that is ordered by sensor time has to start over then.
+inline bool IsTimeJumpBack(int64_t timestamp, int64_t last_timestamp)
+{
+  return timestamp < last_timestamp;
+}
+
+// Whether something that was last done at last_timestamp is due again at timestamp, for a period
+// in nanoseconds. It is always due the first time, if the period is not positive, and after the
+// sensor clock jumped back.
+inline bool IsPeriodElapsed(
+  int64_t timestamp, const std::optional<int64_t> & last_timestamp, int64_t period_ns)
+{
+  return period_ns <= 0 || !last_timestamp || IsTimeJumpBack(timestamp, *last_timestamp) ||
+         timestamp - *last_timestamp >= period_ns;
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__SENSOR_TIME_HPP_
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__SPSC_RING_BUFFER_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__SPSC_RING_BUFFER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Releases the content of a message slot. Containers are cleared in place to keep their capacity,
+// everything else is reset to a default constructed value.
+template<class U>
+auto ResetMessage(U & value, int)->decltype(value.clear(), void())
+{
+  value.clear();
+}
+template<class U>
+void ResetMessage(U & value, long)  // NOLINT(runtime/int)
+{
+  value = U{};
+}
+template<class U>
+void ResetMessage(U & value)
+{
+  ResetMessage(value, 0);
+}
+
+// Fixed capacity single-producer/single-consumer ring of timestamped messages.
+// All slots are allocated once in the constructor. Push() copy-assigns into an existing slot and
+// PopInto() swaps the slot with the caller's object, so messages owning heap storage (e.g.
+// std::vector) keep their capacity and the steady state does not allocate.
+// Push() may only be called from the producer thread, PopInto() only from the consumer thread.
+template<class T>
+class SpscRingBuffer
+{
+public:
+  explicit SpscRingBuffer(size_t capacity)
+  : slots_(std::max<size_t>(capacity, 1))
+  {
+  }
+
+  // Moving is only allowed while no producer or consumer is active, e.g. during construction.
+  SpscRingBuffer(SpscRingBuffer && other) noexcept
+  : slots_(std::move(other.slots_)),
+    head_(other.head_.load(std::memory_order_relaxed)),
+    tail_(other.tail_.load(std::memory_order_relaxed))
+  {
+  }
+
+  // Returns false if the ring is full. The message is not stored in that case.
+  bool Push(int64_t timestamp, const T & msg)
+  {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= slots_.size()) {
+      return false;
+    }
+    Slot & slot = slots_[tail % slots_.size()];
+    slot.timestamp = timestamp;
+    slot.msg = msg;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Moves the oldest message into msg. Returns false if the ring is empty.
+  bool PopInto(T & msg)
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    Slot & slot = slots_[head % slots_.size()];
+    std::swap(msg, slot.msg);
+    // Release whatever the swap left behind so that the ring does not keep messages alive.
+    ResetMessage(slot.msg);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Drops the oldest message. Returns false if the ring is empty.
+  bool Drop()
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    ResetMessage(slots_[head % slots_.size()].msg);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Timestamp of the oldest message or max int64_t if the ring is empty.
+  int64_t FrontTimeStamp() const
+  {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    return slots_[head % slots_.size()].timestamp;
+  }
+
+  size_t Size() const
+  {
+    return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+  }
+
+  bool IsEmpty() const {return Size() == 0;}
+
+  bool IsFull() const {return Size() >= slots_.size();}
+
+  size_t Capacity() const {return slots_.size();}
+
+private:
+  struct Slot
+  {
+    int64_t timestamp = 0;
+    T msg{};
+  };
+
+  std::vector<Slot> slots_;
+  // Monotonic counters. The slot index is counter % capacity.
+  std::atomic<size_t> head_{0};
+  std::atomic<size_t> tail_{0};
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__SPSC_RING_BUFFER_HPP_
@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__SUBSCRIBER_PRESENCE_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__SUBSCRIBER_PRESENCE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "rclcpp/node.hpp"
+#include "rclcpp/publisher_base.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Caches whether publishers have subscribers, so that publishing code reads a single atomic
+// instead of querying the rmw graph. A background thread recounts the subscribers of all tracked
+// publishers whenever the graph of the node changes, and at least every refresh_period.
+class SubscriberPresence
+{
+public:
+  SubscriberPresence(rclcpp::Node & node, std::chrono::milliseconds refresh_period);
+  ~SubscriberPresence();
+
+  // Returns the flag of the publisher, which is true while it has subscribers. The subscribers
+  // are counted right away when a publisher is tracked for the first time. The flag stays valid
+  // for the lifetime of this object. A null publisher gets a flag that is always false.
+  const std::atomic<bool> * Track(const std::shared_ptr<rclcpp::PublisherBase> & publisher);
+
+  // Like Track(), but the flag is only true while the publisher has intra-process subscribers.
+  const std::atomic<bool> * TrackIntraProcess(
+    const std::shared_ptr<rclcpp::PublisherBase> & publisher);
+
+  // Recounts the subscribers of all tracked publishers.
+  void Refresh();
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<rclcpp::PublisherBase> publisher;
+    std::atomic<bool> has_subscribers{false};
+    std::atomic<bool> has_intra_process_subscribers{false};
+  };
+
+  // Returns the entry of the publisher, adds it if it is not tracked yet.
+  Entry & GetEntry(const std::shared_ptr<rclcpp::PublisherBase> & publisher);
+  static void Count(Entry & entry);
+  void Run();
+
+  rclcpp::Node & node_;
+  const std::chrono::milliseconds refresh_period_;
+
+  std::mutex mutex_;
+  // A deque keeps the flags in place when entries are added.
+  std::deque<Entry> entries_;
+  const std::atomic<bool> no_subscribers_{false};
+
+  std::atomic<bool> stop_{false};
+  std::thread thread_;
+};
+
+// Reads a flag returned by SubscriberPresence::Track(). A null flag has no subscribers.
+inline bool HasSubscribers(const std::atomic<bool> * has_subscribers)
+{
+  return has_subscribers && has_subscribers->load(std::memory_order_relaxed);
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__SUBSCRIBER_PRESENCE_HPP_
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__SYNC_TUNER_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__SYNC_TUNER_HPP_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Learns the settings of the image synchronizer from the observed image streams. For every stream
+// it tracks the period between timestamps and its jitter, across streams the skew between the
+// timestamps of the same frame, and the time the first image of a frame set waits for the others.
+// The matching threshold follows the skew, the buffer size follows the wait. Hardware triggered
+// cameras end up with a tight window and a shallow buffer, jittery free running cameras with a
+// wide window and a deep buffer.
+//
+// New settings are only proposed after a warm up, at most once per retune period and only if they
+// differ noticeably from the current ones, because applying them rebuilds the synchronizer.
+//
+// Thread safe, the statistics may be read from another thread.
+class SyncTuner
+{
+public:
+  struct Config
+  {
+    int64_t matching_threshold_ns;
+    size_t buffer_size;
+  };
+
+  struct Statistics
+  {
+    Config config;
+    // Largest mean period and period jitter of all streams.
+    double max_period_ms;
+    double max_jitter_ms;
+    // Mean and decaying peak of the skew between streams.
+    double skew_ms;
+    double skew_peak_ms;
+    // Decaying peak of the time the first image of a frame set waited for the others.
+    double sync_wait_peak_ms;
+    uint64_t num_retunes;
+  };
+
+  // config is used until the first retune. Proposed configs are clamped to [min, max].
+  SyncTuner(size_t num_streams, const Config & config, const Config & min, const Config & max);
+
+  // Called for every image before it is passed to the synchronizer.
+  void AddImage(int index, int64_t timestamp);
+
+  // Called for every synchronized frame set.
+  void AddSyncWait(int64_t sync_wait_ns);
+
+  // Returns true and writes the config that should be applied now. The config is then considered
+  // applied.
+  bool Retune(Config & config);
+
+  Statistics GetStatistics() const;
+
+private:
+  // Exponentially weighted mean and mean absolute deviation.
+  struct RunningStatistic
+  {
+    void Add(double value);
+
+    double mean = 0.0;
+    double deviation = 0.0;
+    double peak = 0.0;
+    uint64_t count = 0;
+  };
+
+  struct Stream
+  {
+    int64_t last_timestamp = -1;
+    RunningStatistic period;
+  };
+
+  // Must be called with mutex_ held.
+  Config Recommend() const;
+
+  const Config min_;
+  const Config max_;
+
+  mutable std::mutex mutex_;
+  std::vector<Stream> streams_;
+  RunningStatistic skew_;
+  RunningStatistic sync_wait_;
+  Config config_;
+  uint64_t num_images_since_retune_ = 0;
+  uint64_t num_retunes_ = 0;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__SYNC_TUNER_HPP_
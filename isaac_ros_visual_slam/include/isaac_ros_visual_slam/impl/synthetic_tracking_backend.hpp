@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__SYNTHETIC_TRACKING_BACKEND_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__SYNTHETIC_TRACKING_BACKEND_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/tracking_backend.hpp"
+#include "tf2/LinearMath/Transform.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// CPU-only stand-in for cuVSLAM used to benchmark the node without a GPU.
+// The images are not looked at. The rig moves along a scripted trajectory that only depends on the
+// image timestamps: it drives with a constant linear velocity along its x axis while turning with
+// a constant yaw rate, i.e. on a circle. Track() and TrackSlam() sleep for a configurable time to
+// emulate the cost of the real tracker. The output is deterministic for the same input timestamps.
+class SyntheticTrackingBackend : public TrackingBackend
+{
+public:
+  struct Config
+  {
+    // Velocity of the rig in ROS conventions in m/s and rad/s.
+    double linear_velocity = 1.0;
+    double angular_velocity = 0.1;
+    // Time spent in Track() and TrackSlam().
+    std::chrono::microseconds track_cost{0};
+    std::chrono::microseconds slam_cost{0};
+  };
+
+  explicit SyntheticTrackingBackend(const Config & config);
+
+  void RegisterImuMeasurement(const cuvslam::ImuMeasurement & imu_measurement) override;
+
+  cuvslam::PoseEstimate Track(
+    const std::vector<cuvslam::Image> & images,
+    const std::vector<cuvslam::Image> & masks,
+    const std::vector<cuvslam::Image> & depth_images) override;
+
+  std::optional<cuvslam::Odometry::Gravity> GetLastGravity() override;
+
+  cuvslam::Pose TrackSlam() override;
+
+  // There is no map, so saving and localizing always fail.
+  void SaveMap(const std::string & map_folder_path, SaveMapCallback callback) override;
+
+  void LocalizeInMap(
+    const std::string & map_folder_path, const cuvslam::Pose & pose_hint,
+    const cuvslam::Slam::LocalizationSettings & localization_settings,
+    LocalizeInMapCallback callback) override;
+
+  void GetAllSlamPoses(std::vector<cuvslam::PoseStamped> & poses, uint32_t max_count) override;
+
+  void SetSlamPose(const cuvslam::Pose & pose) override;
+
+  void Reset(bool clear_map) override;
+
+private:
+  // Pose of the rig in cuVSLAM conventions at the given time after the first frame.
+  tf2::Transform GetScriptedPose(double seconds) const;
+
+  const Config config_;
+  // Upper bound for the number of poses kept for GetAllSlamPoses().
+  const size_t max_slam_poses_ = 100000;
+
+  int64_t first_timestamp_ns_ = -1;
+
+  std::mutex slam_mutex_;
+  int64_t last_timestamp_ns_ = 0;
+  tf2::Transform odom_pose_rig_ = tf2::Transform::getIdentity();
+  tf2::Transform map_pose_odom_ = tf2::Transform::getIdentity();
+  std::deque<cuvslam::PoseStamped> slam_poses_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__SYNTHETIC_TRACKING_BACKEND_HPP_
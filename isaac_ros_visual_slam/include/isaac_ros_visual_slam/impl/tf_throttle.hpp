@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__TF_THROTTLE_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__TF_THROTTLE_HPP_
+
+#include <cstdint>
+#include <optional>
+
+#include "tf2/LinearMath/Transform.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Decides which transforms of a frame are published to the tf tree. map->odom is published when it
+// moved by more than the thresholds or the keep alive period elapsed, odom->base at most at
+// odom_to_base_max_rate. Timestamps are sensor times in nanoseconds.
+//
+// Not thread safe, only accessed by the output stage.
+class TfThrottle
+{
+public:
+  struct Options
+  {
+    // Publishes map->odom with every frame if not positive.
+    double map_to_odom_keep_alive_ms = 0;
+    // Meters and radians.
+    double map_to_odom_translation_threshold = 0;
+    double map_to_odom_rotation_threshold = 0;
+    // Publishes odom->base with every frame if not positive.
+    double odom_to_base_max_rate = 0;
+  };
+
+  explicit TfThrottle(const Options & options);
+
+  // Whether the transform is published for the frame at timestamp. Remembers the publication if
+  // it is.
+  bool ShouldPublishMapToOdom(int64_t timestamp, const tf2::Transform & map_pose_odom);
+  bool ShouldPublishOdomToBase(int64_t timestamp);
+
+  // Publishes the transforms of the next frame right away.
+  void Reset();
+
+private:
+  const int64_t map_to_odom_keep_alive_ns_;
+  const double map_to_odom_translation_threshold_;
+  const double map_to_odom_rotation_threshold_;
+  const int64_t odom_to_base_period_ns_;
+
+  std::optional<tf2::Transform> map_pose_odom_;
+  std::optional<int64_t> map_to_odom_publish_ts_;
+  std::optional<int64_t> odom_to_base_publish_ts_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__TF_THROTTLE_HPP_
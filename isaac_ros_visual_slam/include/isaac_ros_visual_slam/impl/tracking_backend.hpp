@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__TRACKING_BACKEND_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__TRACKING_BACKEND_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "cuvslam/cuvslam2.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Everything the node needs from the visual odometry and slam implementation. All poses are in
+// cuVSLAM conventions. Errors are reported by throwing exceptions, like the cuVSLAM API does.
+class TrackingBackend
+{
+public:
+  using SaveMapCallback = std::function<void (bool)>;
+  using LocalizeInMapCallback = std::function<void (const cuvslam::Result<cuvslam::Pose> &)>;
+
+  virtual ~TrackingBackend() = default;
+
+  // Odometry
+  virtual void RegisterImuMeasurement(const cuvslam::ImuMeasurement & imu_measurement) = 0;
+
+  virtual cuvslam::PoseEstimate Track(
+    const std::vector<cuvslam::Image> & images,
+    const std::vector<cuvslam::Image> & masks,
+    const std::vector<cuvslam::Image> & depth_images) = 0;
+
+  // Empty until the backend has aligned the optical and imu sensors.
+  virtual std::optional<cuvslam::Odometry::Gravity> GetLastGravity() = 0;
+
+  // Slam. Only usable if the backend was created with slam enabled.
+  // Feeds the latest odometry state into slam and returns the slam pose.
+  virtual cuvslam::Pose TrackSlam() = 0;
+
+  // The callback may be called from a different thread.
+  virtual void SaveMap(const std::string & map_folder_path, SaveMapCallback callback) = 0;
+
+  // The callback may be called from a different thread, also if localization fails.
+  virtual void LocalizeInMap(
+    const std::string & map_folder_path, const cuvslam::Pose & pose_hint,
+    const cuvslam::Slam::LocalizationSettings & localization_settings,
+    LocalizeInMapCallback callback) = 0;
+
+  virtual void GetAllSlamPoses(std::vector<cuvslam::PoseStamped> & poses, uint32_t max_count) = 0;
+
+  virtual void SetSlamPose(const cuvslam::Pose & pose) = 0;
+
+  // Restarts odometry at the identity, keeping the rig. Slam keeps its map and continues from the
+  // last slam pose, unless clear_map is set. Must not be called while tracking.
+  virtual void Reset(bool clear_map) = 0;
+
+  // The cuVSLAM slam object used by the visualization helpers. nullptr if there is none.
+  virtual std::shared_ptr<cuvslam::Slam> GetSlam() const {return nullptr;}
+};
+
+// Backend running cuVSLAM on the GPU.
+class CuvslamTrackingBackend : public TrackingBackend
+{
+public:
+  // slam may be nullptr if localization and mapping is disabled. The rig and the configurations
+  // the objects were created with are kept for Reset().
+  CuvslamTrackingBackend(
+    std::unique_ptr<cuvslam::Odometry> odometry, std::shared_ptr<cuvslam::Slam> slam,
+    const cuvslam::Rig & rig, const cuvslam::Odometry::Config & odometry_config,
+    const cuvslam::Slam::Config & slam_config);
+
+  void RegisterImuMeasurement(const cuvslam::ImuMeasurement & imu_measurement) override;
+
+  cuvslam::PoseEstimate Track(
+    const std::vector<cuvslam::Image> & images,
+    const std::vector<cuvslam::Image> & masks,
+    const std::vector<cuvslam::Image> & depth_images) override;
+
+  std::optional<cuvslam::Odometry::Gravity> GetLastGravity() override;
+
+  cuvslam::Pose TrackSlam() override;
+
+  void SaveMap(const std::string & map_folder_path, SaveMapCallback callback) override;
+
+  void LocalizeInMap(
+    const std::string & map_folder_path, const cuvslam::Pose & pose_hint,
+    const cuvslam::Slam::LocalizationSettings & localization_settings,
+    LocalizeInMapCallback callback) override;
+
+  void GetAllSlamPoses(std::vector<cuvslam::PoseStamped> & poses, uint32_t max_count) override;
+
+  void SetSlamPose(const cuvslam::Pose & pose) override;
+
+  // cuVSLAM can not reset a tracker, the odometry and, with clear_map, the slam object are
+  // recreated from the kept rig. Slam is replaced, so GetSlam() returns a new object.
+  void Reset(bool clear_map) override;
+
+  std::shared_ptr<cuvslam::Slam> GetSlam() const override {return slam_;}
+
+private:
+  cuvslam::Slam & CheckedSlam() const;
+
+  const cuvslam::Rig rig_;
+  const cuvslam::Odometry::Config odometry_config_;
+  const cuvslam::Slam::Config slam_config_;
+
+  std::unique_ptr<cuvslam::Odometry> odometry_;
+  std::shared_ptr<cuvslam::Slam> slam_;
+  cuvslam::Odometry::State odometry_state_;
+  std::optional<cuvslam::Pose> last_slam_pose_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__TRACKING_BACKEND_HPP_
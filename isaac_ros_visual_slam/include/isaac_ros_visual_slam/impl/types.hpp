@@ -26,9 +26,12 @@
 #include "isaac_ros_managed_nitros/managed_nitros_subscriber.hpp"
 #include "isaac_ros_nitros/types/nitros_type_message_filter_traits.hpp"
 #include "isaac_ros_nitros_image_type/nitros_image_view.hpp"
+#include "isaac_ros_visual_slam_interfaces/msg/landmark_cloud_update.hpp"
+#include "isaac_ros_visual_slam_interfaces/msg/latency_percentiles.hpp"
 #include "isaac_ros_visual_slam_interfaces/msg/visual_slam_status.hpp"
 #include "isaac_ros_visual_slam_interfaces/srv/file_path.hpp"
 #include "isaac_ros_visual_slam_interfaces/srv/get_all_poses.hpp"
+#include "isaac_ros_visual_slam_interfaces/srv/get_poses_at_times.hpp"
 #include "isaac_ros_visual_slam_interfaces/srv/localize_in_map.hpp"
 #include "isaac_ros_visual_slam_interfaces/srv/reset.hpp"
 #include "isaac_ros_visual_slam_interfaces/srv/set_slam_pose.hpp"
@@ -38,6 +41,7 @@
 #include "sensor_msgs/msg/image.hpp"
 #include "sensor_msgs/msg/imu.hpp"
 #include "sensor_msgs/msg/point_cloud2.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
 #include "visualization_msgs/msg/marker_array.hpp"
 
 
@@ -61,6 +65,10 @@ using OdometryType = nav_msgs::msg::Odometry;
 using PathType = nav_msgs::msg::Path;
 
 using VisualSlamStatusType = isaac_ros_visual_slam_interfaces::msg::VisualSlamStatus;
+using LatencyPercentilesType = isaac_ros_visual_slam_interfaces::msg::LatencyPercentiles;
+using LandmarkCloudUpdateType = isaac_ros_visual_slam_interfaces::msg::LandmarkCloudUpdate;
+
+using TFMessageType = tf2_msgs::msg::TFMessage;
 
 using DiagnosticArrayType = diagnostic_msgs::msg::DiagnosticArray;
 using DiagnosticStatusType = diagnostic_msgs::msg::DiagnosticStatus;
@@ -68,6 +76,7 @@ using KeyValueType = diagnostic_msgs::msg::KeyValue;
 
 using SrvFilePath = isaac_ros_visual_slam_interfaces::srv::FilePath;
 using SrvGetAllPoses = isaac_ros_visual_slam_interfaces::srv::GetAllPoses;
+using SrvGetPosesAtTimes = isaac_ros_visual_slam_interfaces::srv::GetPosesAtTimes;
 using SrvLocalizeInMap = isaac_ros_visual_slam_interfaces::srv::LocalizeInMap;
 using SrvReset = isaac_ros_visual_slam_interfaces::srv::Reset;
 using SrvSetSlamPose = isaac_ros_visual_slam_interfaces::srv::SetSlamPose;
@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__VIS_SCHEDULER_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__IMPL__VIS_SCHEDULER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "rclcpp/rclcpp.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// Runs the periodic tasks of the visualization helpers on a small pool of worker threads.
+//
+// Deadlines are kept in a hashed timer wheel with a granularity of kTickMs. Tasks that fall into
+// the same tick are dispatched with a single wakeup, and the timer thread only wakes up for ticks
+// that have tasks. Due tasks are handed to the workers in priority order.
+class VisScheduler
+{
+public:
+  struct Options
+  {
+    size_t num_workers = 1;
+    // CPUs the scheduler threads may run on. Empty to keep the affinity of the process.
+    std::vector<int64_t> cpu_affinity;
+    // Nice value of the scheduler threads. Not used with the idle policy.
+    int nice = 10;
+    // Run the scheduler threads with SCHED_IDLE, so that they only get CPU time that no other
+    // thread wants.
+    bool idle_policy = false;
+  };
+
+  using TaskId = uint64_t;
+
+  static constexpr int64_t kTickMs = 4;
+  static constexpr size_t kNumSlots = 256;
+
+  VisScheduler(const Options & options, const rclcpp::Logger & logger);
+  ~VisScheduler();
+
+  // Runs task every period until it is removed. Of the tasks that are due at the same time, the
+  // ones with the lower priority value run first. The threads are started on first use.
+  TaskId Add(std::function<void()> task, std::chrono::milliseconds period, int priority);
+
+  // Removes a task. Blocks until a running invocation of the task has returned, so the resources
+  // used by the task can be released afterwards. Must not be called from a task.
+  void Remove(TaskId id);
+
+  // Joins all threads and drops the remaining tasks.
+  void Stop();
+
+private:
+  struct Task
+  {
+    std::function<void()> function;
+    uint64_t period_ticks;
+    int priority;
+    uint64_t due_tick;
+    bool running;
+    bool removed;
+  };
+
+  struct ReadyTask
+  {
+    int priority;
+    uint64_t due_tick;
+    TaskId id;
+  };
+
+  uint64_t NowTick() const;
+  // Inserts the task into the wheel. Must be called with mutex_ held.
+  void Schedule(TaskId id, Task & task);
+  void ConfigureThread();
+  void RunTimer();
+  void RunWorker();
+
+  const Options options_;
+  const rclcpp::Logger logger_;
+  const std::chrono::steady_clock::time_point start_time_;
+
+  std::mutex mutex_;
+  std::condition_variable timer_cond_var_;
+  std::condition_variable worker_cond_var_;
+  std::condition_variable task_done_cond_var_;
+
+  std::unordered_map<TaskId, Task> tasks_;
+  // Ids of the scheduled tasks by due_tick % kNumSlots. Ids of removed tasks are dropped lazily.
+  std::vector<std::vector<TaskId>> wheel_;
+  // Heap of the due tasks, the next task to run is at the front.
+  std::vector<ReadyTask> ready_;
+  uint64_t current_tick_ = 0;
+  // Tick the timer thread sleeps until, UINT64_MAX if it waits for new tasks.
+  uint64_t timer_wakeup_tick_ = UINT64_MAX;
+  TaskId next_id_ = 1;
+
+  bool running_ = false;
+  bool stop_ = false;
+  std::thread timer_thread_;
+  std::vector<std::thread> worker_threads_;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__IMPL__VIS_SCHEDULER_HPP_
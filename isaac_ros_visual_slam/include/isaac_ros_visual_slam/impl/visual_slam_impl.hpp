@@ -17,12 +17,17 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__VISUAL_SLAM_IMPL_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__VISUAL_SLAM_IMPL_HPP_
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -35,19 +40,33 @@
 #include "cuvslam/ground_constraint2.h"
 #include "cv_bridge/cv_bridge.hpp"
 #include "isaac_common/messaging/message_stream_synchronizer.hpp"
+#include "isaac_ros_visual_slam/impl/bounded_queue.hpp"
+#include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
+#include "isaac_ros_visual_slam/impl/dropout_synchronizer.hpp"
+#include "isaac_ros_visual_slam/impl/imu_propagator.hpp"
 #include "isaac_ros_visual_slam/impl/landmarks_vis_helper.hpp"
+#include "isaac_ros_visual_slam/impl/latency_histogram.hpp"
+#include "isaac_ros_visual_slam/impl/latest_value_cache.hpp"
 #include "isaac_ros_visual_slam/impl/limited_vector.hpp"
 #include "isaac_ros_visual_slam/impl/localizer_vis_helper.hpp"
 #include "isaac_ros_visual_slam/impl/message_stream_sequencer.hpp"
 #include "isaac_ros_visual_slam/impl/pose_cache.hpp"
+#include "isaac_ros_visual_slam/impl/pose_history.hpp"
 #include "isaac_ros_visual_slam/impl/posegraph_vis_helper.hpp"
+#include "isaac_ros_visual_slam/impl/rig_cache.hpp"
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
+#include "isaac_ros_visual_slam/impl/sync_tuner.hpp"
+#include "isaac_ros_visual_slam/impl/tf_throttle.hpp"
+#include "isaac_ros_visual_slam/impl/tracking_backend.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
+#include "isaac_ros_visual_slam/impl/vis_scheduler.hpp"
+#include "isaac_ros_visual_slam/shm_pose_ring.hpp"
 #include "isaac_ros_visual_slam/visual_slam_node.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "tf2/LinearMath/Transform.h"
 #include "tf2_ros/buffer.h"
+#include "tf2_ros/qos.hpp"
 #include "tf2_ros/static_transform_broadcaster.h"
-#include "tf2_ros/transform_broadcaster.h"
 #include "tf2_ros/transform_listener.h"
 
 namespace nvidia
@@ -68,6 +87,89 @@ struct VisualSlamNode::VisualSlamImpl
     boost::promise<Response> response_promise;
   };
 
+  // Synchronized frame set waiting for the tracking thread in pipelined mode.
+  struct FrameSet
+  {
+    std::vector<ImuSample> imu_samples;
+    std::vector<std::pair<int, ImageType>> idx_and_image_msgs;
+    std::chrono::steady_clock::time_point enqueue_time;
+  };
+
+  // Everything the output stage needs to publish the result of one tracked frame set.
+  struct TrackingResult
+  {
+    // Timestamp of the latest image in the frame set in nanoseconds.
+    int64_t latest_ts = 0;
+    rclcpp::Time timestamp_output;
+    bool vo_success = false;
+
+    // Poses, velocity and covariances in ROS conventions. Only valid if vo_success is true.
+    tf2::Transform odom_pose_base_link;
+    tf2::Transform map_pose_base_link;
+    std::array<double, 6 * 6> vo_pose_covariance{};
+    geometry_msgs::msg::Twist velocity;
+    std::optional<std::array<double, 6 * 6>> odom_pose_covariance;
+    std::optional<std::array<double, 6 * 6>> odom_twist_covariance;
+    std::optional<cuvslam::Odometry::Gravity> gravity;
+
+    // Execution time of cuvslam::Odometry::Track in seconds.
+    double track_execution_time = 0;
+
+    // Stage timing. start_time is the time the frame set entered the node's processing.
+    std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point tracked_time;
+    double tracking_queue_latency = 0;
+    double tracking_stage_execution_time = 0;
+
+    // Heap allocations counted on the tracking thread while tracking the frame set.
+    uint64_t heap_allocations = 0;
+  };
+
+  // Scratch state of the tracking stage. It is sized once and reset for every frame, so that
+  // tracking a frame does not allocate.
+  struct TrackingArena
+  {
+    void Reset();
+
+    std::vector<cuvslam::Image> images;
+    std::vector<cuvslam::Image> masks;
+    std::vector<cuvslam::Image> depth_images;
+    // Mask of every camera indexed by the camera index. nullptr if the frame set has none.
+    std::vector<const ImageType *> mask_msgs;
+    // Masks and depth image taken from the side channels, indexed by channel.
+    std::vector<std::optional<ImageType>> side_channel_msgs;
+    ImuBatch imu_batch;
+  };
+
+  // Messages of the output stage. They are reused for every frame, so that only their contents
+  // are overwritten and strings and vectors keep their capacity.
+  struct OutputArena
+  {
+    PoseStampedType vo_pose;
+    PoseWithCovarianceStampedType vo_pose_covariance;
+    OdometryType odometry;
+    OdometryType slam_odometry;
+    VisualSlamStatusType status;
+    DiagnosticArrayType diagnostics;
+    MarkerArrayType velocity_markers;
+    MarkerType gravity_marker;
+    // Transforms of the frame, published to the tf tree in a single message.
+    TFMessageType transforms;
+  };
+
+  // Processing stages for which a latency histogram is recorded.
+  enum LatencyStage : size_t
+  {
+    kSyncWait,
+    kSequencerWait,
+    kImuRegistration,
+    kImageConversion,
+    kOdometryTrack,
+    kSlamTrack,
+    kTfPublish,
+    kMessagePublish,
+    kNumLatencyStages
+  };
 
   explicit VisualSlamImpl(VisualSlamNode & vslam_node);
 
@@ -82,29 +184,112 @@ struct VisualSlamNode::VisualSlamImpl
 
   void Exit();
 
+  // Restarts tracking without destroying the tracker: the rig, the extrinsics and the
+  // visualization helpers are kept. The map is kept unless clear_map is set. Returns false if
+  // not initialized or the backend failed to reset, then a full Exit() is required.
+  bool SoftReset(bool clear_map);
+  // Resets the pose caches and the per stream state used while tracking.
+  void ResetTrackingState();
+  // Answers an outstanding localization request with a failure.
+  void CancelLocalization(const std::string & reason);
+
+  void InitVisHelpers();
+  void ExitVisHelpers();
+
   // Create the configuration for the cuvslam tracker.
   cuvslam::Odometry::Config CreateOdometryConfiguration();
 
   // Create the configuration for the cuvslam slam.
   cuvslam::Slam::Config CreateSlamConfiguration();
 
-  // Helper function to publish a transform to the tf tree.
-  void PublishFrameTransform(
+  // Create the tracking backend selected by the tracking_backend parameter. Returns nullptr on
+  // failure.
+  std::unique_ptr<TrackingBackend> CreateTrackingBackend(const cuvslam::Rig & cam_rig);
+
+  // Helper function to add a transform to the batch of the frame in output_arena.
+  void AddFrameTransform(
     rclcpp::Time stamp, const tf2::Transform & pose, const std::string & target,
     const std::string & source);
 
   // Helper to get latest transform from the tf tree.
   tf2::Transform GetLatestTransform(
     const std::string & target, const std::string & source);
+  // Same as GetLatestTransform, but waits for the transform on a separate thread, so that several
+  // transforms can be waited for at the same time.
+  std::future<tf2::Transform> GetLatestTransformAsync(
+    const std::string & target, const std::string & source);
+  // Returns the extrinsic from cached_extrinsics if it is there, and from the tf tree otherwise.
+  std::future<tf2::Transform> GetExtrinsicAsync(
+    const std::string & target, const std::string & source);
+
+  // Initializes from the rig cache if there is one for the configuration. Returns false if the
+  // messages and transforms have to be waited for.
+  bool InitializeFromRigCache();
+
+  // Waits until the GPU warm-up started by the node is done.
+  void WaitForGpuWarmUp();
+  // Logs the startup timeline and publishes it as diagnostic status. Called for the first pose.
+  void ReportStartupTimeline();
+
+  // Bookkeeping and reused messages for publishing one pose trail.
+  struct PathState
+  {
+    PoseStampedType pose;
+    PathType full_msg;
+    PathType delta_msg;
+    // Value of limited_vector::numAdded() when the last delta message was published.
+    uint64_t num_added_at_last_delta = 0;
+    // Timestamp of the last full path message in nanoseconds.
+    std::optional<int64_t> last_full_publish_ts;
+    // Subscriber flags of the full and the delta topic.
+    const std::atomic<bool> * has_full_subscribers = nullptr;
+    const std::atomic<bool> * has_delta_subscribers = nullptr;
+  };
+
+  // Subscriber flags of the publishers used for every frame, see SubscriberPresence. The
+  // intra_process flags select the publishing path of PublishFrameMessage().
+  struct SubscriberFlags
+  {
+    const std::atomic<bool> * vo_pose = nullptr;
+    const std::atomic<bool> * vo_pose_intra_process = nullptr;
+    const std::atomic<bool> * vo_pose_covariance = nullptr;
+    const std::atomic<bool> * vo_pose_covariance_intra_process = nullptr;
+    const std::atomic<bool> * odometry = nullptr;
+    const std::atomic<bool> * odometry_intra_process = nullptr;
+    const std::atomic<bool> * odometry_imu_rate = nullptr;
+    const std::atomic<bool> * odometry_imu_rate_intra_process = nullptr;
+    const std::atomic<bool> * vo_velocity = nullptr;
+    const std::atomic<bool> * slam_odometry = nullptr;
+    const std::atomic<bool> * slam_odometry_intra_process = nullptr;
+    const std::atomic<bool> * gravity = nullptr;
+    const std::atomic<bool> * status = nullptr;
+    const std::atomic<bool> * status_intra_process = nullptr;
+    const std::atomic<bool> * diagnostics = nullptr;
+  };
+
+  // Helper to append a pose to a pose trail. Publishes the appended poses on the delta topic and
+  // the full trail if path_publish_period_ms has passed since it was last published.
+  void UpdatePath(
+    const rclcpp::Time & stamp, const std::string & frame_id, const PoseType & pose,
+    limited_vector<PoseStampedType> & path, PathState & path_state,
+    const rclcpp::Publisher<PathType>::SharedPtr & full_publisher,
+    const rclcpp::Publisher<PathType>::SharedPtr & delta_publisher);
+
+  // Helper to write the result of a frame to shm_pose_ring.
+  void WriteShmPoseRecord(const TrackingResult & result);
 
   // Helper to publish the estimated velocity from odometry.
   void PublishOdometryVelocity(
-    rclcpp::Time stamp, const std::string & frame_id,
+    rclcpp::Time stamp, const std::string & frame_id, const geometry_msgs::msg::Twist & twist,
     const rclcpp::Publisher<MarkerArrayType>::SharedPtr publisher);
 
+  // Helper to publish a propagated IMU state on odometry_imu_rate.
+  void PublishImuRateOdometry(const ImuPropagator::State & state, const rclcpp::Time & stamp);
+
   // Helper to publish the estimated gravity vector.
   void PublishGravity(
     rclcpp::Time stamp, const std::string & frame_id,
+    const cuvslam::Odometry::Gravity & gravity_in_cuvslam,
     const rclcpp::Publisher<MarkerType>::SharedPtr publisher);
 
   // Callbacks for subscribers.
@@ -112,15 +297,40 @@ struct VisualSlamNode::VisualSlamImpl
   void CallbackImage(int index, const ImageType & image_view);
   void CallbackCameraInfo(int index, const CameraInfoType::ConstSharedPtr & msg);
 
+  // Number of image streams that are synchronized, and how many of them make a frame set.
+  size_t NumImageStreams() const;
+  size_t MinNumImages() const;
+
+  // Creates the synchronizer, or replaces it with one of the new settings. Images buffered in the
+  // old synchronizer are dropped. Creates the dropout synchronizer instead if
+  // enable_camera_dropout_handling is set.
+  void CreateSynchronizer(const SyncTuner::Config & config);
+
   // Callback for synchronizer.
   void CallbackSynchronizedImages(
     int64_t current_ts, const std::vector<std::pair<int, ImageType>> & idx_and_image_msgs);
 
   // Callback for sequencer
   void UpdatePose(
-    const std::vector<ImuType::ConstSharedPtr> & imu_msgs,
+    const BatchView<ImuSample> & imu_samples,
     const std::vector<std::pair<int, ImageType>> & idx_and_image_msgs);
 
+  // Tracking stage: registers the imu measurements and tracks the images. Returns false if no
+  // result should be published for this frame set.
+  bool TrackFrame(
+    const BatchView<ImuSample> & imu_samples,
+    const std::vector<std::pair<int, ImageType>> & idx_and_image_msgs,
+    TrackingResult & result);
+
+  // Output stage: publishes tf, pose, odometry, path, status and diagnostics messages.
+  void PublishTrackingResult(const TrackingResult & result);
+
+  // Start and stop the tracking and output threads used in pipelined mode.
+  void StartPipeline();
+  void StopPipeline();
+  void RunTrackingStage();
+  void RunOutputStage();
+
   // Save the current map to disk.
   bool SaveMap(const std::string & map_folder_path);
 
@@ -144,22 +354,43 @@ struct VisualSlamNode::VisualSlamImpl
   // Check and handle the localization future status
   void CheckLocalizationStatus();
 
+  // Adds the latency percentiles of all stages to the status message and the diagnostics. The
+  // diagnostic values are written starting at value_index, reusing existing entries. Returns the
+  // index after the last written diagnostic value.
+  size_t AddLatencyStatistics(
+    VisualSlamStatusType * visual_slam_status_msg,
+    DiagnosticStatusType * diagnostic_status, size_t value_index = 0) const;
+
   // Reference to the ros node.
   VisualSlamNode & node;
 
   // Synchronizer used to sync all image messages.
   using Synchronizer = isaac_common::messaging::MessageStreamSynchronizer<ImageType>;
-  Synchronizer sync;
+  std::optional<Synchronizer> sync;
+  // Replaces sync if enable_camera_dropout_handling is set. The timer enforces the deadlines of
+  // its frame sets when the images stop arriving.
+  using DropoutSync = DropoutSynchronizer<ImageType>;
+  std::optional<DropoutSync> dropout_sync;
+  rclcpp::TimerBase::SharedPtr dropout_sync_timer;
+
+  // Masks and depth images if decouple_masks_and_depth is set. They bypass the synchronizer,
+  // channel i holds the masks of camera i and channel num_input_masks the depth images.
+  LatestValueCache<ImageType> side_channels;
+  // Number of masks and depth images that were not found within their staleness tolerance.
+  std::atomic<uint64_t> num_side_channel_misses{0};
+  // Learns the settings of the synchronizer if enable_adaptive_sync is set.
+  SyncTuner sync_tuner;
 
   // Sequencer used to sequence imu and image messages.
-  using Sequencer = MessageStreamSequencer<ImuType::ConstSharedPtr,
+  using Sequencer = MessageStreamSequencer<ImuSample,
       std::vector<std::pair<int, ImageType>>>;
   Sequencer sequencer;
 
-  // cuVSLAM API objects
-  std::unique_ptr<cuvslam::Odometry> cuvslam_odometry;
-  cuvslam::Odometry::State odometry_state;
-  std::shared_ptr<cuvslam::Slam> cuvslam_slam;  // Shared pointer for async visualization helpers
+  // Visual odometry and slam implementation. Only set while initialized.
+  std::unique_ptr<TrackingBackend> tracking_backend;
+  // Held around every call into tracking_backend. In pipelined mode the tracking thread calls it
+  // concurrently with the service callbacks.
+  std::mutex tracking_backend_mutex;
   std::unique_ptr<cuvslam::GroundConstraint> ground_constraint;
 
   // Define cameras for cuVSLAM. 2 for stereo camera.
@@ -168,11 +399,23 @@ struct VisualSlamNode::VisualSlamImpl
   // Helper classes for tf listening and publishing.
   std::unique_ptr<tf2_ros::Buffer> tf_buffer{nullptr};
   std::unique_ptr<tf2_ros::TransformListener> tf_listener{nullptr};
-  std::unique_ptr<tf2_ros::TransformBroadcaster> tf_publisher{nullptr};
+  // Publishes to the tf tree like tf2_ros::TransformBroadcaster, but takes the message by
+  // reference, so that the transforms of a frame are not copied into a new message.
+  rclcpp::Publisher<TFMessageType>::SharedPtr tf_publisher;
   std::unique_ptr<tf2_ros::StaticTransformBroadcaster> tf_static_publisher{nullptr};
 
   limited_vector<PoseStampedType> vo_path;
   limited_vector<PoseStampedType> slam_path;
+  PathState vo_path_state;
+  PathState slam_path_state;
+
+  // Tracks the subscribers of the publishers, so that the per frame path and the visualization
+  // helpers do not query the ROS graph. Must outlive the helpers below.
+  SubscriberPresence subscriber_presence;
+  SubscriberFlags subscribed;
+
+  // Runs the visualization helpers below. Must outlive them.
+  VisScheduler vis_scheduler;
 
   // Point cloud to visualize tracks
   // LandmarksVisHelper observations_vis_helper;
@@ -197,9 +440,68 @@ struct VisualSlamNode::VisualSlamImpl
   // Velocity cache. For velocity covariance calculation.
   VelocityCache velocity_cache;
 
+  // Tracked poses for the get_poses_at_times service. Written by the tracking stage.
+  PoseHistory pose_history;
+
+  // Rotation of the IMU measurements into the cuVSLAM imu frame, see TocuVSLAMImuRotation(). Set
+  // by Initialize().
+  Eigen::Matrix3d imu_measurement_rotation = Eigen::Matrix3d::Identity();
+
+  // Timestamp of the last IMU message converted on arrival and the number of rejected ones. Only
+  // accessed by the IMU callback.
+  int64_t last_staged_imu_ts = -1;
+  uint64_t num_rejected_imu_msgs = 0;
+
+  // Propagates the tracked pose with IMU measurements between frames. Anchored by the tracking
+  // stage, advanced by the IMU callback.
+  ImuPropagator imu_propagator;
+  // Reused message of odometry_imu_rate, only accessed by the IMU callback.
+  OdometryType imu_rate_odometry;
+
   // Container to calulate execution time statictics.
   limited_vector<double> track_execution_times;
 
+  // Latency histograms indexed by LatencyStage.
+  std::array<LatencyHistogram, kNumLatencyStages> latency_histograms;
+  // Start of the current window of the histograms, only accessed by the output stage.
+  std::chrono::steady_clock::time_point latency_window_start = std::chrono::steady_clock::now();
+
+  // Arrival times of images at the synchronizer and of frame sets at the sequencer.
+  ArrivalTimes image_arrival_times;
+  ArrivalTimes frame_set_arrival_times;
+
+  // Per frame scratch state, only accessed by the tracking and the output stage respectively.
+  TrackingArena tracking_arena;
+  OutputArena output_arena;
+  TfThrottle tf_throttle;
+
+  // Durations of the phases from the construction to the first pose, in milliseconds.
+  struct StartupTimeline
+  {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    // Until all messages needed for initialization arrived.
+    double wait_for_inputs_ms = 0.0;
+    double extrinsics_ms = 0.0;
+    double gpu_warm_up_ms = 0.0;
+    // Time initialization was blocked by the GPU warm-up.
+    double gpu_warm_up_wait_ms = 0.0;
+    double odometry_ms = 0.0;
+    double slam_ms = 0.0;
+    double initialize_ms = 0.0;
+    bool reported = false;
+  };
+  StartupTimeline startup_timeline;
+
+  // Shared memory output of the poses. Only set if shm_pose_ring_name is set, written by the
+  // output stage.
+  std::unique_ptr<ShmPoseRingWriter> shm_pose_ring;
+
+  // Number of published frames and the heap allocations counted while tracking and publishing
+  // them. The count only advances in processes that count allocations, like
+  // visual_slam_replay_bench, so it is not published.
+  std::atomic<uint64_t> num_published_frames{0};
+  std::atomic<uint64_t> frame_heap_allocations{0};
+
   // Timestamp of the last time CUVSLAM_Track was called in nanoseconds.
   int64_t last_track_ts;
 
@@ -207,8 +509,24 @@ struct VisualSlamNode::VisualSlamImpl
   std::optional<ImuType::ConstSharedPtr> initial_imu_message;
   std::map<int, std::optional<CameraInfoType::ConstSharedPtr>> initial_camera_info_messages;
 
+  // Cache of the rig calibration. Only set if rig_cache_directory is set.
+  std::unique_ptr<RigCache> rig_cache;
+  // Extrinsics of the rig cache, used instead of the tf tree while initializing from it.
+  std::map<std::pair<std::string, std::string>, tf2::Transform> cached_extrinsics;
+  // Hashes of the cached camera infos that were not compared to the live ones yet, by index.
+  std::map<int, uint64_t> pending_camera_info_hashes;
+
+  // Queues and threads used in pipelined mode.
+  BoundedQueue<FrameSet> tracking_queue;
+  // Frame set that is filled and swapped into the tracking queue. It gets back the storage of a
+  // frame set the tracking stage is done with.
+  FrameSet pending_frame_set;
+  BoundedQueue<TrackingResult> output_queue;
+  std::thread tracking_thread;
+  std::thread output_thread;
+
   LocalizeInExistDbContext localize_in_exist_db_context;
-  bool localized_in_exist_map_ = false;
+  std::atomic<bool> localized_in_exist_map_{false};
 
   // Store the localization future to prevent it from being destroyed before callback completes
   std::optional<boost::future<std::optional<PoseType>>> localization_future_;
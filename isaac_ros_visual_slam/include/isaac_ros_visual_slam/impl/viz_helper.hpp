@@ -18,14 +18,15 @@
 #ifndef ISAAC_ROS_VISUAL_SLAM__IMPL__VIZ_HELPER_HPP_
 #define ISAAC_ROS_VISUAL_SLAM__IMPL__VIZ_HELPER_HPP_
 
-#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
-#include <thread>
 
 #include "cuvslam/cuvslam2.h"
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
+#include "isaac_ros_visual_slam/impl/vis_scheduler.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "tf2/LinearMath/Transform.h"
 
@@ -36,11 +37,13 @@ namespace isaac_ros
 namespace visual_slam
 {
 
-// Base class for async helpers
+// Base class for async helpers. Run() is executed periodically as a task of the shared
+// VisScheduler. Tasks with a lower priority value run first when several are due. Subscribers
+// are looked up in the shared SubscriberPresence.
 class VisHelper
 {
 public:
-  VisHelper();
+  VisHelper(VisScheduler & scheduler, SubscriberPresence & presence, int priority);
   virtual ~VisHelper() {}
 
   void Init(
@@ -55,14 +58,22 @@ public:
 protected:
   virtual void Reset() = 0;
 
+  // Reads and publishes the data once. Called with mutex_ held.
+  virtual void Run() = 0;
+
+  // Schedules Run() every period_ms until Exit() is called.
+  void Start(uint32_t period_ms);
+
 protected:
   std::shared_ptr<cuvslam::Slam> cuvslam_slam_;
   tf2::Transform canonical_pose_cuvslam_;
   std::string frame_id_;
 
-  std::thread thread_;
+  VisScheduler & scheduler_;
+  SubscriberPresence & presence_;
+  const int priority_;
+  std::optional<VisScheduler::TaskId> task_id_;
   std::mutex mutex_;
-  std::condition_variable cond_var_;
   rclcpp::Logger logger_;
 };
 
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef ISAAC_ROS_VISUAL_SLAM__SHM_POSE_RING_HPP_
+#define ISAAC_ROS_VISUAL_SLAM__SHM_POSE_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Shared memory output of the tracked poses for processes on the same host.
+//
+// VisualSlamNode writes one record per tracked frame into a POSIX shared memory ring when the
+// shm_pose_ring_name parameter is set. Readers map the ring read-only and poll it, without any
+// ROS or DDS involvement. Every slot of the ring is a seqlock: the writer never waits for readers
+// and readers retry if a slot was overwritten while they copied it.
+//
+// This header and the shm_pose_ring library have no ROS dependencies, so that any local process
+// can link them.
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+// One tracked frame in ROS conventions. Poses are x, y, z, qx, qy, qz, qw. Covariances are row
+// major 6x6 matrices in the order x, y, z, roll, pitch, yaw, like in nav_msgs/Odometry.
+struct ShmPoseRecord
+{
+  // Timestamp of the frame in nanoseconds, the stamp of the tracking/odometry message.
+  int64_t timestamp_ns;
+  // CLOCK_MONOTONIC in nanoseconds when the record was written, to measure the latency.
+  int64_t write_time_ns;
+  // Same values as VisualSlamStatus.vo_state: 1 if tracking succeeded, 2 if it failed. The poses
+  // and the twist are only valid if it succeeded.
+  uint32_t vo_state;
+  uint32_t reserved;
+  // odom_pose_base_link
+  double vo_pose[7];
+  // map_pose_base_link
+  double slam_pose[7];
+  // Pose covariance as in tracking/odometry.
+  double pose_covariance[36];
+  // Linear and angular velocity in the base frame.
+  double twist[6];
+  double twist_covariance[36];
+};
+
+// Layout of the shared memory: the header followed by capacity slots.
+struct ShmPoseRingHeader
+{
+  static constexpr uint32_t kMagic = 0x56534c52;  // "VSLR"
+  static constexpr uint32_t kVersion = 1;
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t capacity;
+  uint32_t record_size;
+  // Number of records written so far. Record i is in slot i % capacity.
+  alignas(64) std::atomic<uint64_t> num_written;
+};
+
+struct ShmPoseRingSlot
+{
+  // 2 * (i + 1) once record i is complete, odd while a record is written.
+  alignas(64) std::atomic<uint64_t> sequence;
+  ShmPoseRecord record;
+};
+
+// Creates the ring and writes records into it. Only one writer per ring. The shared memory is
+// removed when the writer is destroyed; readers that still map it keep a valid mapping.
+class ShmPoseRingWriter
+{
+public:
+  // name is a POSIX shared memory name, a leading '/' is added if it is missing. An existing
+  // ring of the same name is replaced. Throws std::system_error on failure.
+  ShmPoseRingWriter(const std::string & name, uint32_t capacity);
+  ~ShmPoseRingWriter();
+
+  ShmPoseRingWriter(const ShmPoseRingWriter &) = delete;
+  ShmPoseRingWriter & operator=(const ShmPoseRingWriter &) = delete;
+
+  // Writes the record into the next slot. Does not allocate or block.
+  void Write(const ShmPoseRecord & record);
+
+private:
+  std::string name_;
+  size_t size_ = 0;
+  ShmPoseRingHeader * header_ = nullptr;
+  ShmPoseRingSlot * slots_ = nullptr;
+};
+
+// Maps an existing ring read-only and copies records out of it.
+class ShmPoseRingReader
+{
+public:
+  // Throws std::system_error if the ring does not exist and std::runtime_error if it has an
+  // unexpected layout.
+  explicit ShmPoseRingReader(const std::string & name);
+  ~ShmPoseRingReader();
+
+  ShmPoseRingReader(const ShmPoseRingReader &) = delete;
+  ShmPoseRingReader & operator=(const ShmPoseRingReader &) = delete;
+
+  // Number of records written so far.
+  uint64_t NumWritten() const;
+
+  // Copies the newest record. Returns false if nothing was written yet.
+  bool ReadLatest(ShmPoseRecord & record) const;
+
+  // Copies the oldest record that this reader has not returned yet. Returns false if there is
+  // none. Records overwritten before they were read are skipped and counted in NumSkipped().
+  bool ReadNext(ShmPoseRecord & record);
+
+  uint64_t NumSkipped() const {return num_skipped_;}
+
+private:
+  enum class ReadResult
+  {
+    kOk,
+    kNotWritten,
+    kOverwritten,
+  };
+
+  ReadResult Read(uint64_t index, ShmPoseRecord & record) const;
+
+  size_t size_ = 0;
+  const ShmPoseRingHeader * header_ = nullptr;
+  const ShmPoseRingSlot * slots_ = nullptr;
+  uint64_t next_index_ = 0;
+  uint64_t num_skipped_ = 0;
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+#endif  // ISAAC_ROS_VISUAL_SLAM__SHM_POSE_RING_HPP_
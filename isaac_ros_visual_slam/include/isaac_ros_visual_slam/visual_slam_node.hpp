@@ -24,6 +24,7 @@
 #include <vector>
 #include <thread>
 #include <atomic>
+#include <future>
 
 #include "isaac_ros_visual_slam/impl/types.hpp"
 #include "message_filters/subscriber.h"
@@ -210,13 +211,72 @@ private:
   // Buffer size of image buffer used in synchronizer.
   const uint image_buffer_size_;
 
+  // Learn the matching threshold and the buffer size of the image synchronizer from the observed
+  // timestamps and arrival times of the images. sync_matching_threshold_ms and image_buffer_size
+  // are the initial values. The statistics are published in the diagnostics.
+  const bool enable_adaptive_sync_;
+  // Upper bounds of the learned synchronizer settings.
+  const double adaptive_sync_max_matching_threshold_ms_;
+  const uint adaptive_sync_max_buffer_size_;
+
+  // Do not let a stalled camera hold back the frame sets. A frame set that is not complete
+  // camera_dropout_deadline_ms after its first image arrived is emitted with the available images,
+  // if there are at least min_num_images. The missing cameras are no longer waited for until they
+  // delivered camera_dropout_readmit_frames consecutive images in time.
+  const bool enable_camera_dropout_handling_;
+  const double camera_dropout_deadline_ms_;
+  const uint camera_dropout_readmit_frames_;
+
+  // Do not synchronize the segmentation masks and the depth image with the camera images. The
+  // frames are tracked as soon as the camera images are synchronized, with the mask or depth image
+  // closest in time, if it is within mask_staleness_tolerance_ms or depth_staleness_tolerance_ms.
+  const bool decouple_masks_and_depth_;
+  const double mask_staleness_tolerance_ms_;
+  const double depth_staleness_tolerance_ms_;
+
   // Buffer size of imu buffer.
   const uint imu_buffer_size_;
 
+  // Maximum time in milliseconds the pose on odometry_imu_rate is propagated with IMU measurements
+  // past the last tracked frame. Only used in VIO mode.
+  const double imu_propagation_max_time_ms_;
+
   // The QoS used for the image and subscriptions
   const rclcpp::QoS image_qos_;
   const rclcpp::QoS imu_qos_;
 
+  // Pipelining Parameters:
+  // Run cuVSLAM tracking and all output publishing on two dedicated threads instead of the executor
+  // thread that delivered the images, so a slow Track() does not stall the subscriptions.
+  const bool enable_pipelined_tracking_;
+
+  // Maximum number of frame sets waiting for the tracking thread and of results waiting for the
+  // output thread. The oldest entry is dropped when a queue is full.
+  const uint tracking_queue_size_;
+
+  // Validate and convert IMU messages to the tracker's format when they arrive, instead of in a
+  // burst when the frame set they belong to is tracked. The sequencer then only orders them.
+  const bool enable_eager_imu_ingestion_;
+
+  // Tracking Backend Parameters:
+  // Implementation used for tracking. Either "cuvslam" or "synthetic". The synthetic backend
+  // replaces cuVSLAM with scripted poses, which allows to benchmark the node without a GPU.
+  const std::string tracking_backend_;
+
+  // Velocity of the scripted trajectory of the synthetic backend in m/s and rad/s.
+  const double synthetic_backend_linear_velocity_;
+  const double synthetic_backend_angular_velocity_;
+
+  // Time the synthetic backend spends in odometry and slam tracking per frame in milliseconds.
+  const double synthetic_backend_track_cost_ms_;
+  const double synthetic_backend_slam_cost_ms_;
+
+  // Startup Parameters:
+  // Directory of a cache of the rig calibration: the camera infos, the initial IMU message and the
+  // extrinsics. If set, the tracker is created from the cache at startup instead of waiting for
+  // them, and the cache is discarded if the live camera infos differ. Empty disables the cache.
+  const std::string rig_cache_directory_;
+
   // Output Parameters:
   // Enable this to override the timestamps of all outputs to the current time.
   // This is helpful when playing back with rosbags and allows to ignore the
@@ -232,6 +292,37 @@ private:
   const bool invert_map_to_odom_tf_;
   const bool invert_odom_to_base_tf_;
 
+  // The map -> odom transform is only published when it has moved by more than these thresholds
+  // in meters and radians, or when map_to_odom_tf_keep_alive_ms has passed since it was last
+  // published. 0 publishes it with every frame.
+  const double map_to_odom_tf_keep_alive_ms_;
+  const double map_to_odom_tf_translation_threshold_;
+  const double map_to_odom_tf_rotation_threshold_;
+
+  // Maximum rate of the odom -> base transform in Hz. 0 publishes it with every frame.
+  const double odom_to_base_tf_max_rate_;
+
+  // Name of the POSIX shared memory ring the tracked poses are written to, see
+  // shm_pose_ring.hpp. Empty to disable it.
+  const std::string shm_pose_ring_name_;
+
+  // Number of records in the shared memory ring.
+  const uint shm_pose_ring_size_;
+
+  // Number of poses and velocities used to estimate the pose and twist covariance of the
+  // odometry output. The cost per frame does not depend on it.
+  const uint odometry_covariance_window_size_;
+
+  // Number of tracked poses kept for the get_poses_at_times service.
+  const uint pose_history_size_;
+
+  // Maximum time in milliseconds get_poses_at_times extrapolates outside of the pose history.
+  const double pose_history_max_extrapolation_ms_;
+
+  // The latency percentiles in the status and diagnostics cover the last one to two windows of
+  // this length in seconds. 0 reports them since startup.
+  const double latency_window_s_;
+
   // Debug/Visualization Parameters:
   // Enable slam data visualization (Landmarks, Pose Graph, etc).
   // Demands additional hardware resources.
@@ -243,9 +334,31 @@ private:
   // Enable view landmarks for map and loop closure events.
   const bool enable_landmarks_view_;
 
+  // Time between two keyframes on the landmark cloud delta topics in milliseconds of wall time.
+  // Keyframes are sent also if a layer does not change, so late subscribers can reconstruct the
+  // cloud after the next keyframe.
+  const double landmarks_keyframe_period_ms_;
+
+  // Number of worker threads shared by all visualization helpers.
+  const int vis_num_threads_;
+
+  // CPUs the visualization threads may run on. Empty to not restrict them.
+  const std::vector<int64_t> vis_cpu_affinity_;
+
+  // Nice value of the visualization threads, used if vis_idle_scheduling is disabled.
+  const int vis_thread_nice_;
+
+  // Run the visualization threads with the SCHED_IDLE policy, so that they never preempt tracking.
+  // Off by default, on a fully loaded CPU the idle threads can starve and visualization stalls.
+  const bool vis_idle_scheduling_;
+
   // Max size of the buffer for pose trail visualization.
   const uint path_max_size_;
 
+  // Minimum time between two publications of the full vo_path and slam_path in milliseconds.
+  // 0 publishes them on every frame. The path_delta topics are published on every frame anyway.
+  const double path_publish_period_ms_;
+
   // Verbosity for cuvslam, the larger the more verbose.
   const int verbosity_;
 
@@ -277,8 +390,13 @@ private:
   const rclcpp::Publisher<PoseWithCovarianceStampedType>::SharedPtr
     tracking_vo_pose_covariance_pub_;
   const rclcpp::Publisher<OdometryType>::SharedPtr tracking_odometry_pub_;
+  // Odometry propagated with every IMU measurement between the camera frames.
+  const rclcpp::Publisher<OdometryType>::SharedPtr tracking_odometry_imu_rate_pub_;
   const rclcpp::Publisher<PathType>::SharedPtr tracking_vo_path_pub_;
   const rclcpp::Publisher<PathType>::SharedPtr tracking_slam_path_pub_;
+  // Only the poses appended to the paths since the last delta message.
+  const rclcpp::Publisher<PathType>::SharedPtr tracking_vo_path_delta_pub_;
+  const rclcpp::Publisher<PathType>::SharedPtr tracking_slam_path_delta_pub_;
   const rclcpp::Publisher<DiagnosticArrayType>::SharedPtr diagnostics_pub_;
 
   // Sends a message to global localization to generate a pose hint
@@ -292,6 +410,7 @@ private:
 
   // Visualization for map and "loop closure"
   const rclcpp::Publisher<PointCloud2Type>::SharedPtr vis_landmarks_pub_;
+  const rclcpp::Publisher<LandmarkCloudUpdateType>::SharedPtr vis_landmarks_delta_pub_;
   const rclcpp::Publisher<PointCloud2Type>::SharedPtr vis_loop_closure_pub_;
   const rclcpp::Publisher<PoseArrayType>::SharedPtr vis_posegraph_nodes_pub_;
   const rclcpp::Publisher<MarkerType>::SharedPtr vis_posegraph_edges_pub_;
@@ -300,12 +419,14 @@ private:
   // Visualization for localization
   const rclcpp::Publisher<MarkerArrayType>::SharedPtr vis_localizer_pub_;
   const rclcpp::Publisher<PointCloud2Type>::SharedPtr vis_localizer_landmarks_pub_;
+  const rclcpp::Publisher<LandmarkCloudUpdateType>::SharedPtr vis_localizer_landmarks_delta_pub_;
   const rclcpp::Publisher<PointCloud2Type>::SharedPtr vis_localizer_observations_pub_;
   const rclcpp::Publisher<PointCloud2Type>::SharedPtr vis_localizer_loop_closure_pub_;
 
   // Slam Services
   const rclcpp::Service<SrvReset>::SharedPtr reset_srv_;
   const rclcpp::Service<SrvGetAllPoses>::SharedPtr get_all_poses_srv_;
+  const rclcpp::Service<SrvGetPosesAtTimes>::SharedPtr get_poses_at_times_srv_;
   const rclcpp::Service<SrvSetSlamPose>::SharedPtr set_slam_pose_srv_;
   const rclcpp::Service<SrvFilePath>::SharedPtr save_map_srv_;
   const rclcpp::Service<SrvFilePath>::SharedPtr load_map_srv_;
@@ -318,6 +439,9 @@ private:
   void CallbackGetAllPoses(
     const std::shared_ptr<SrvGetAllPoses::Request> req,
     std::shared_ptr<SrvGetAllPoses::Response> res);
+  void CallbackGetPosesAtTimes(
+    const std::shared_ptr<SrvGetPosesAtTimes::Request> req,
+    std::shared_ptr<SrvGetPosesAtTimes::Response> res);
   void CallbackSetSlamPose(
     const std::shared_ptr<SrvSetSlamPose::Request> req,
     std::shared_ptr<SrvSetSlamPose::Response> res);
@@ -340,9 +464,16 @@ private:
   struct VisualSlamImpl;
   std::unique_ptr<VisualSlamImpl> impl_;
 
+  // Drives the callbacks directly, see visual_slam_replay_bench.cpp.
+  friend class VisualSlamReplayBench;
+
   // Thread management for localization
   std::thread localization_thread_;
   std::atomic<bool> localization_thread_running_{false};
+
+  // GPU warm-up that runs in the background from the construction of the node, yields its
+  // duration in seconds. Only valid for the cuvslam backend.
+  std::shared_future<double> gpu_warm_up_;
 };
 
 }  // namespace visual_slam
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "isaac_ros_visual_slam/impl/allocation_counter.hpp"
+
+namespace
+{
+// Trivially initialized, so accessing it from within operator new does not allocate.
+thread_local uint64_t g_thread_heap_allocations = 0;
+}  // namespace
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+void CountHeapAllocation() noexcept
+{
+  g_thread_heap_allocations++;
+}
+
+uint64_t GetThreadHeapAllocations() noexcept
+{
+  return g_thread_heap_allocations;
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -22,6 +22,7 @@
 #include "isaac_ros_visual_slam/impl/types.hpp"
 #include "sensor_msgs/distortion_models.hpp"
 #include "rclcpp/logging.hpp"
+#include "rclcpp/time.hpp"
 
 namespace nvidia
 {
@@ -267,33 +268,75 @@ cuvslam::Image TocuVSLAMDepthImage(
   return cuvslam_depth_image;
 }
 
-// Helper function to pass IMU data to cuVSLAM
-cuvslam::ImuMeasurement TocuVSLAMImuMeasurement(
-  const ImuType::ConstSharedPtr & msg_imu, const int64_t & acqtime_ns)
+Eigen::Matrix3d TocuVSLAMImuRotation(const tf2::Matrix3x3 & imu_rotation_msg)
 {
-  cuvslam::ImuMeasurement measurement;
-
-  const auto & in_lin_acc = msg_imu->linear_acceleration;
-  const auto & in_ang_vel = msg_imu->angular_velocity;
-
-  const tf2::Vector3 ros_lin_acc(in_lin_acc.x, in_lin_acc.y, in_lin_acc.z);
-  const tf2::Vector3 ros_ang_vel(in_ang_vel.x, in_ang_vel.y, in_ang_vel.z);
+  // convert from ros frame to cuvslam after rotating into the imu frame
+  const tf2::Matrix3x3 rotation = cuvslam_pose_canonical.getBasis() * imu_rotation_msg;
+  Eigen::Matrix3d result;
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 3; col++) {
+      result(row, col) = rotation[row][col];
+    }
+  }
+  return result;
+}
 
-  // convert from ros frame to cuvslam
-  const tf2::Vector3 cuvslam_lin_acc = cuvslam_pose_canonical * ros_lin_acc;
-  const tf2::Vector3 cuvslam_ang_vel = cuvslam_pose_canonical * ros_ang_vel;
+// Helper function to pass IMU data to cuVSLAM
+void TocuVSLAMImuMeasurements(
+  const BatchView<ImuSample> & samples_imu, const Eigen::Matrix3d & rotation, ImuBatch & batch)
+{
+  const size_t num_samples = samples_imu.size();
+  batch.samples.resize(2 * 3 * num_samples);
+  batch.rotated_samples.resize(2 * 3 * num_samples);
+  batch.measurements.resize(num_samples);
+
+  // Gather linear accelerations into the first and angular velocities into the second half.
+  double * linear_accelerations = batch.samples.data();
+  double * angular_velocities = batch.samples.data() + 3 * num_samples;
+  for (size_t i = 0; i < num_samples; i++) {
+    const auto & in_lin_acc = samples_imu[i].msg->linear_acceleration;
+    const auto & in_ang_vel = samples_imu[i].msg->angular_velocity;
+    linear_accelerations[3 * i + 0] = in_lin_acc.x;
+    linear_accelerations[3 * i + 1] = in_lin_acc.y;
+    linear_accelerations[3 * i + 2] = in_lin_acc.z;
+    angular_velocities[3 * i + 0] = in_ang_vel.x;
+    angular_velocities[3 * i + 1] = in_ang_vel.y;
+    angular_velocities[3 * i + 2] = in_ang_vel.z;
+  }
 
-  // Set linear accelerations
-  measurement.linear_accelerations[0] = cuvslam_lin_acc.x();
-  measurement.linear_accelerations[1] = cuvslam_lin_acc.y();
-  measurement.linear_accelerations[2] = cuvslam_lin_acc.z();
-  // Set angular velocity
-  measurement.angular_velocities[0] = cuvslam_ang_vel.x();
-  measurement.angular_velocities[1] = cuvslam_ang_vel.y();
-  measurement.angular_velocities[2] = cuvslam_ang_vel.z();
+  // One vectorized product rotates all samples.
+  using Samples = Eigen::Matrix<double, 3, Eigen::Dynamic>;
+  Eigen::Map<Samples>(batch.rotated_samples.data(), 3, 2 * num_samples).noalias() =
+    rotation * Eigen::Map<const Samples>(batch.samples.data(), 3, 2 * num_samples);
+
+  const double * rotated_linear_accelerations = batch.rotated_samples.data();
+  const double * rotated_angular_velocities = batch.rotated_samples.data() + 3 * num_samples;
+  for (size_t i = 0; i < num_samples; i++) {
+    cuvslam::ImuMeasurement & measurement = batch.measurements[i];
+    for (int axis = 0; axis < 3; axis++) {
+      measurement.linear_accelerations[axis] = rotated_linear_accelerations[3 * i + axis];
+      measurement.angular_velocities[axis] = rotated_angular_velocities[3 * i + axis];
+    }
+    measurement.timestamp_ns = rclcpp::Time(samples_imu[i].msg->header.stamp).nanoseconds();
+  }
+}
 
-  measurement.timestamp_ns = acqtime_ns;
+cuvslam::ImuMeasurement TocuVSLAMImuMeasurement(
+  const ImuType & msg_imu, const Eigen::Matrix3d & rotation)
+{
+  const auto & in_lin_acc = msg_imu.linear_acceleration;
+  const auto & in_ang_vel = msg_imu.angular_velocity;
+  const Eigen::Vector3d lin_acc =
+    rotation * Eigen::Vector3d(in_lin_acc.x, in_lin_acc.y, in_lin_acc.z);
+  const Eigen::Vector3d ang_vel =
+    rotation * Eigen::Vector3d(in_ang_vel.x, in_ang_vel.y, in_ang_vel.z);
 
+  cuvslam::ImuMeasurement measurement;
+  for (int axis = 0; axis < 3; axis++) {
+    measurement.linear_accelerations[axis] = lin_acc[axis];
+    measurement.angular_velocities[axis] = ang_vel[axis];
+  }
+  measurement.timestamp_ns = rclcpp::Time(msg_imu.header.stamp).nanoseconds();
   return measurement;
 }
 
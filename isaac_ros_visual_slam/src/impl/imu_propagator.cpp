@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "isaac_ros_visual_slam/impl/imu_propagator.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+ImuPropagator::ImuPropagator(size_t buffer_size, int64_t max_propagation_time_ns)
+: max_propagation_time_ns_(max_propagation_time_ns),
+  base_rotation_imu_(tf2::Matrix3x3::getIdentity()),
+  measurements_(buffer_size)
+{
+}
+
+void ImuPropagator::SetBasePoseImu(const tf2::Transform & base_pose_imu)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  base_rotation_imu_ = base_pose_imu.getBasis();
+}
+
+void ImuPropagator::Anchor(
+  int64_t timestamp_ns, const tf2::Transform & pose, const tf2::Vector3 & linear_velocity,
+  const tf2::Vector3 & gravity)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const tf2::Matrix3x3 & odom_rotation_base = pose.getBasis();
+  State & state = state_.emplace();
+  state.timestamp_ns = timestamp_ns;
+  state.pose = pose;
+  state.linear_velocity = linear_velocity;
+  state.angular_velocity.setZero();
+  anchor_timestamp_ns_ = timestamp_ns;
+  gravity_ = odom_rotation_base * gravity;
+
+  // Catch up with the measurements that arrived while the frame was tracked.
+  for (size_t i = 0; i < measurements_.size(); i++) {
+    if (measurements_[i].timestamp_ns > timestamp_ns) {
+      Integrate(measurements_[i]);
+    }
+  }
+}
+
+std::optional<ImuPropagator::State> ImuPropagator::Add(
+  int64_t timestamp_ns, const tf2::Vector3 & angular_velocity,
+  const tf2::Vector3 & linear_acceleration)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Measurement measurement{
+    timestamp_ns, base_rotation_imu_ * angular_velocity,
+    base_rotation_imu_ * linear_acceleration};
+  measurements_.add(measurement);
+  if (!state_ || timestamp_ns <= state_->timestamp_ns ||
+    timestamp_ns - anchor_timestamp_ns_ > max_propagation_time_ns_)
+  {
+    return std::nullopt;
+  }
+  Integrate(measurement);
+  return state_;
+}
+
+void ImuPropagator::Reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  state_.reset();
+}
+
+void ImuPropagator::Integrate(const Measurement & measurement)
+{
+  State & state = *state_;
+  const double dt = (measurement.timestamp_ns - state.timestamp_ns) * 1e-9;
+  if (dt <= 0) {
+    return;
+  }
+  // The accelerometer measures the specific force, gravity has to be added back.
+  const tf2::Vector3 acceleration =
+    state.pose.getBasis() * measurement.linear_acceleration + gravity_;
+  state.pose.setOrigin(
+    state.pose.getOrigin() + state.linear_velocity * dt + acceleration * (0.5 * dt * dt));
+  state.linear_velocity += acceleration * dt;
+
+  const tf2::Vector3 rotation_vector = measurement.angular_velocity * dt;
+  const double angle = rotation_vector.length();
+  if (angle > 0) {
+    tf2::Quaternion rotation = state.pose.getRotation() *
+      tf2::Quaternion(rotation_vector / angle, angle);
+    rotation.normalize();
+    state.pose.setRotation(rotation);
+  }
+  state.angular_velocity = measurement.angular_velocity;
+  state.timestamp_ns = measurement.timestamp_ns;
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
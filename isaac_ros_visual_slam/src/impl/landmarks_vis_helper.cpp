@@ -15,16 +15,71 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <memory>
+#include <stdexcept>
 #include <string>
-#include <random>
 #include <utility>
 
-#include "isaac_ros_visual_slam/impl/has_subscribers.hpp"
+#include "Eigen/Core"
 #include "isaac_ros_visual_slam/impl/landmarks_vis_helper.hpp"
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
 #include "sensor_msgs/point_cloud2_iterator.hpp"
 
+namespace
+{
+
+// Layout of one point in the published clouds.
+struct LandmarkPoint
+{
+  float x;
+  float y;
+  float z;
+  uint32_t rgb;
+};
+static_assert(sizeof(LandmarkPoint) == 16, "LandmarkPoint must not be padded");
+
+// Mixes the bits of the landmark id, so that neighboring ids get unrelated colors. This is the
+// finalizer of MurmurHash3.
+uint64_t HashLandmarkId(uint64_t id)
+{
+  id ^= id >> 33;
+  id *= 0xff51afd7ed558ccdULL;
+  id ^= id >> 33;
+  id *= 0xc4ceb9fe1a85ec53ULL;
+  id ^= id >> 33;
+  return id;
+}
+
+// Maps 8 bits of the hash to a color channel in [92, 255].
+uint32_t Channel(uint64_t hash, int byte)
+{
+  return 92 + ((((hash >> (8 * byte)) & 0xFF) * 164) >> 8);
+}
+
+// Transforms and writes all landmarks. The affine transform is applied as a 4x4 float matrix
+// vector product, which Eigen vectorizes, and every point is written with a single 16 byte copy.
+template<class LandmarkList, class GetColor>
+void EncodePoints(
+  const LandmarkList & landmarks, const Eigen::Matrix4f & transform, uint8_t * data,
+  GetColor get_color)
+{
+  for (const auto & landmark : landmarks) {
+    const Eigen::Vector4f xyz(landmark.coords[0], landmark.coords[1], landmark.coords[2], 1.0f);
+    Eigen::Vector4f point = transform * xyz;
+    // The fourth lane carries the color bits.
+    const uint32_t rgb = 0xFF000000 | get_color(landmark);
+    std::memcpy(&point[3], &rgb, sizeof(rgb));
+    std::memcpy(data, point.data(), sizeof(LandmarkPoint));
+    data += sizeof(LandmarkPoint);
+  }
+}
+
+}  // namespace
+
 namespace nvidia
 {
 namespace isaac_ros
@@ -33,15 +88,29 @@ namespace visual_slam
 {
 
 LandmarksVisHelper::LandmarksVisHelper(
+  VisScheduler & scheduler,
+  SubscriberPresence & presence,
+  int priority,
   cuvslam::Slam::DataLayer layer,
   uint32_t max_landmarks_count,
   LandmarksVisHelper::ColorMode color_mode,
   uint32_t period_ms)
-: layer_(layer), max_landmarks_count_(max_landmarks_count), color_mode_(color_mode), period_ms_(
-    period_ms) {}
+: VisHelper(scheduler, presence, priority), layer_(layer),
+  max_landmarks_count_(max_landmarks_count), color_mode_(color_mode), period_ms_(period_ms) {}
 
 LandmarksVisHelper::~LandmarksVisHelper() {Exit();}
 
+void LandmarksVisHelper::SetDeltaPublisher(
+  const rclcpp::Publisher<LandmarkCloudUpdateType>::SharedPtr delta_publisher,
+  double keyframe_period_ms)
+{
+  delta_publisher_ = delta_publisher;
+  has_delta_subscribers_ = presence_.Track(delta_publisher);
+  delta_.Configure(
+    std::chrono::nanoseconds(static_cast<int64_t>(keyframe_period_ms * 1e6)),
+    max_landmarks_count_);
+}
+
 void LandmarksVisHelper::Init(
   const rclcpp::Publisher<PointCloud2Type>::SharedPtr publisher,
   std::shared_ptr<cuvslam::Slam> & cuvslam_slam,
@@ -51,8 +120,9 @@ void LandmarksVisHelper::Init(
 )
 {
   publisher_ = publisher;
+  has_subscribers_ = presence_.Track(publisher);
   VisHelper::Init(cuvslam_slam, canonical_pose_cuvslam, frame_id, logger);
-  thread_ = std::thread{&LandmarksVisHelper::Run, this};
+  Start(period_ms_);
 }
 
 void LandmarksVisHelper::Reset()
@@ -61,119 +131,148 @@ void LandmarksVisHelper::Reset()
     cuvslam_slam_->DisableReadingData(layer_);
   }
   publisher_.reset();
+  delta_publisher_.reset();
+  has_subscribers_ = nullptr;
+  has_delta_subscribers_ = nullptr;
+  delta_.Reset();
 }
 
 void LandmarksVisHelper::Run()
 {
-  std::unique_lock<std::mutex> locker(mutex_);
-  // cuvslam_slam_ will be null after Exit() was called
-  while (cuvslam_slam_) {
-    try {
-      cond_var_.wait_for(
-        locker,
-        std::chrono::milliseconds(period_ms_));
-      if (!cuvslam_slam_) {break;}
-      if (!rclcpp::ok()) {break;}
-      if (!HasSubscribers(publisher_)) {
-        // no subscribers so disable reading
-        cuvslam_slam_->DisableReadingData(layer_);
-        continue;
-      }
-
-      // enable reading
-      cuvslam_slam_->EnableReadingData(layer_, max_landmarks_count_);
-
-      // read data
-      std::shared_ptr<const cuvslam::Slam::Landmarks> landmarks =
-        cuvslam_slam_->ReadLandmarks(layer_);
-      if (last_timestamp_ns_ == landmarks->timestamp_ns) {
-        // don't need to publish now
-        continue;
-      }
-      last_timestamp_ns_ = landmarks->timestamp_ns;
+  try {
+    const bool publish_full = HasSubscribers(has_subscribers_);
+    const bool publish_delta = HasSubscribers(has_delta_subscribers_);
+    if (!publish_delta && delta_.HasKeyframe()) {
+      // Subscribers joining later need a keyframe first.
+      delta_.Reset();
+    }
+    if (!publish_full && !publish_delta) {
+      // no subscribers so disable reading
+      cuvslam_slam_->DisableReadingData(layer_);
+      return;
+    }
+
+    // enable reading
+    cuvslam_slam_->EnableReadingData(layer_, max_landmarks_count_);
 
+    // read data
+    std::shared_ptr<const cuvslam::Slam::Landmarks> landmarks =
+      cuvslam_slam_->ReadLandmarks(layer_);
+    // A layer that stopped changing still sends its periodic keyframes.
+    const auto now = std::chrono::steady_clock::now();
+    const bool changed = last_timestamp_ns_ != landmarks->timestamp_ns;
+    if (!changed && !(publish_delta && delta_.IsKeyframeDue(now))) {
+      // don't need to publish now
+      return;
+    }
+    last_timestamp_ns_ = landmarks->timestamp_ns;
+
+    if (publish_full && changed) {
       // publish points
-      pointcloud_msg_t pc_msg = std::make_unique<PointCloud2Type>();
-
-      pc_msg->header.frame_id = frame_id_;
-      pc_msg->header.stamp = rclcpp::Time(landmarks->timestamp_ns, RCL_SYSTEM_TIME);
-      pc_msg->height = 1;
-      pc_msg->width = landmarks->landmarks.size();
-
-      pc_msg->is_bigendian = false;
-      pc_msg->is_dense = false;
-
-      sensor_msgs::PointCloud2Modifier modifier(*pc_msg.get());
-      modifier.setPointCloud2Fields(
-        4,
-        "x", 1, sensor_msgs::msg::PointField::FLOAT32,
-        "y", 1, sensor_msgs::msg::PointField::FLOAT32,
-        "z", 1, sensor_msgs::msg::PointField::FLOAT32,
-        "rgb", 1, sensor_msgs::msg::PointField::UINT32);
-      modifier.resize(landmarks->landmarks.size());
-
-      sensor_msgs::PointCloud2Iterator<float> iter_x(*pc_msg.get(), "x");
-      sensor_msgs::PointCloud2Iterator<float> iter_y(*pc_msg.get(), "y");
-      sensor_msgs::PointCloud2Iterator<float> iter_z(*pc_msg.get(), "z");
-      sensor_msgs::PointCloud2Iterator<uint32_t> iter_rgb(*pc_msg.get(), "rgb");
-
-      for (uint32_t i = 0; i < landmarks->landmarks.size();
-        i++, ++iter_x, ++iter_y, ++iter_z, ++iter_rgb)
-      {
-        float w = landmarks->landmarks[i].weight;
-        tf2::Vector3 xyz(landmarks->landmarks[i].coords[0], landmarks->landmarks[i].coords[1],
-          landmarks->landmarks[i].coords[2]);
-        xyz = canonical_pose_cuvslam_ * xyz;
-
-        *iter_x = xyz[0];
-        *iter_y = xyz[1];
-        *iter_z = xyz[2];
-
-        std::mt19937 generator(landmarks->landmarks[i].id);
-        std::uniform_int_distribution<int> distribution(92, 255);
-        uint32_t rgb = 0xFF000000;
-        switch (color_mode_) {
-          case CM_RGB_MODE:
-            {
-              rgb |=
-                (distribution(generator) << 16) +
-                (distribution(generator) << 8) +
-                distribution(generator);
-              break;
-            }
-          case CM_BW_MODE:
-            {
-              int bw = distribution(generator);
-              rgb |= (bw << 16) + (bw << 8) + bw;
-              break;
-            }
-          case CM_RED_MODE:
-            {
-              int r = 255;
-              rgb |= r << 16;
-              break;
-            }
-          case CM_GREEN_MODE:
-            {
-              int green = distribution(generator);
-              rgb |= (42 << 16) + (green << 8) + 42;
-              break;
-            }
-          case CM_WEIGHT_BW_MODE:
-            {
-              int bw = w * 255;
-              rgb |= (bw << 16) + (bw << 8) + bw;
-              break;
-            }
-        }
-        *iter_rgb = rgb;
-      }
+      cloud_.header.frame_id = frame_id_;
+      cloud_.header.stamp = rclcpp::Time(landmarks->timestamp_ns, RCL_SYSTEM_TIME);
+      EncodeLandmarks(landmarks->landmarks, color_mode_, canonical_pose_cuvslam_, cloud_);
 
       // Pointcloud publishing
-      publisher_->publish(std::move(pc_msg));
-    } catch (const std::exception & e) {
-      RCLCPP_WARN(logger_, "LandmarksVisHelper has failed to run: %s", e.what());
+      publisher_->publish(cloud_);
+    }
+    if (publish_delta) {
+      PublishDelta(*landmarks, now);
+    }
+  } catch (const std::exception & e) {
+    RCLCPP_WARN(logger_, "LandmarksVisHelper has failed to run: %s", e.what());
+  }
+}
+
+void LandmarksVisHelper::PublishDelta(
+  const cuvslam::Slam::Landmarks & landmarks, std::chrono::steady_clock::time_point now)
+{
+  if (!delta_.Update(landmarks.landmarks, now)) {
+    return;
+  }
+  update_.ids.clear();
+  for (const auto & landmark : delta_.Changed()) {
+    update_.ids.push_back(landmark.id);
+  }
+  update_.removed_ids.assign(delta_.RemovedIds().begin(), delta_.RemovedIds().end());
+
+  update_.header.frame_id = frame_id_;
+  update_.header.stamp = rclcpp::Time(landmarks.timestamp_ns, RCL_SYSTEM_TIME);
+  update_.keyframe = delta_.IsKeyframe();
+  update_.cloud.header = update_.header;
+  EncodeLandmarks(delta_.Changed(), color_mode_, canonical_pose_cuvslam_, update_.cloud);
+  delta_publisher_->publish(update_);
+  update_.sequence++;
+}
+
+void LandmarksVisHelper::EncodeLandmarks(
+  const LandmarkList & landmarks, ColorMode color_mode,
+  const tf2::Transform & canonical_pose_cuvslam, PointCloud2Type & cloud)
+{
+  cloud.height = 1;
+  cloud.width = landmarks.size();
+  cloud.is_bigendian = false;
+  cloud.is_dense = false;
+
+  if (cloud.fields.size() != 4) {
+    sensor_msgs::PointCloud2Modifier modifier(cloud);
+    modifier.setPointCloud2Fields(
+      4,
+      "x", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "y", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "z", 1, sensor_msgs::msg::PointField::FLOAT32,
+      "rgb", 1, sensor_msgs::msg::PointField::UINT32);
+  }
+  if (cloud.point_step != sizeof(LandmarkPoint)) {
+    throw std::logic_error("Unexpected point cloud layout");
+  }
+  cloud.row_step = cloud.width * cloud.point_step;
+  // Only grows the buffer, existing bytes are not cleared because every point is overwritten.
+  cloud.data.resize(cloud.row_step);
+
+  const tf2::Matrix3x3 & basis = canonical_pose_cuvslam.getBasis();
+  const tf2::Vector3 & origin = canonical_pose_cuvslam.getOrigin();
+  Eigen::Matrix4f transform = Eigen::Matrix4f::Identity();
+  for (int row = 0; row < 3; row++) {
+    for (int col = 0; col < 3; col++) {
+      transform(row, col) = basis[row][col];
     }
+    transform(row, 3) = origin[row];
+  }
+
+  uint8_t * data = cloud.data.data();
+  switch (color_mode) {
+    case CM_RGB_MODE:
+      EncodePoints(
+        landmarks, transform, data, [](const auto & landmark) {
+          const uint64_t hash = HashLandmarkId(landmark.id);
+          return (Channel(hash, 0) << 16) + (Channel(hash, 1) << 8) + Channel(hash, 2);
+        });
+      break;
+    case CM_BW_MODE:
+      EncodePoints(
+        landmarks, transform, data, [](const auto & landmark) {
+          const uint32_t bw = Channel(HashLandmarkId(landmark.id), 0);
+          return (bw << 16) + (bw << 8) + bw;
+        });
+      break;
+    case CM_RED_MODE:
+      EncodePoints(landmarks, transform, data, [](const auto &) {return uint32_t{255} << 16;});
+      break;
+    case CM_GREEN_MODE:
+      EncodePoints(
+        landmarks, transform, data, [](const auto & landmark) {
+          const uint32_t green = Channel(HashLandmarkId(landmark.id), 0);
+          return (42u << 16) + (green << 8) + 42u;
+        });
+      break;
+    case CM_WEIGHT_BW_MODE:
+      EncodePoints(
+        landmarks, transform, data, [](const auto & landmark) {
+          const uint32_t bw = static_cast<int>(landmark.weight * 255);
+          return (bw << 16) + (bw << 8) + bw;
+        });
+      break;
   }
 }
 
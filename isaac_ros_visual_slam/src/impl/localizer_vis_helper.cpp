@@ -20,8 +20,8 @@
 #include <vector>
 
 #include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
-#include "isaac_ros_visual_slam/impl/has_subscribers.hpp"
 #include "isaac_ros_visual_slam/impl/localizer_vis_helper.hpp"
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
 
 namespace nvidia
@@ -34,9 +34,13 @@ namespace visual_slam
 // LocalizerVisHelper
 
 LocalizerVisHelper::LocalizerVisHelper(
+  VisScheduler & scheduler,
+  SubscriberPresence & presence,
+  int priority,
   uint32_t max_items_count,
   uint32_t period_ms)
-: max_items_count_(max_items_count), period_ms_(period_ms)
+: VisHelper(scheduler, presence, priority), max_items_count_(max_items_count),
+  period_ms_(period_ms)
 {
 }
 
@@ -53,9 +57,10 @@ void LocalizerVisHelper::Init(
   const rclcpp::Logger & logger)
 {
   publisher_localizer_probes_ = publisher_localizer_probes;
+  has_localizer_probes_subscribers_ = presence_.Track(publisher_localizer_probes);
 
   VisHelper::Init(cuvslam_slam, canonical_pose_cuvslam, frame_id, logger);
-  thread_ = std::thread{&LocalizerVisHelper::Run, this};
+  Start(period_ms_);
 }
 
 void LocalizerVisHelper::Reset()
@@ -64,6 +69,7 @@ void LocalizerVisHelper::Reset()
     cuvslam_slam_->DisableReadingData(cuvslam::Slam::DataLayer::LocalizerProbes);
   }
   publisher_localizer_probes_.reset();
+  has_localizer_probes_subscribers_ = nullptr;
   localization_finished_ = false;
   have_result_pose_ = false;
   last_timestamp_ns_ = 0;
@@ -82,186 +88,177 @@ void LocalizerVisHelper::SetResult(bool succeeded, const tf2::Transform & pose)
 
 void LocalizerVisHelper::Run()
 {
-  std::unique_lock<std::mutex> locker(mutex_);
-  // cuvslam_slam_ will be null after Exit() was called
-  while (cuvslam_slam_) {
-    try {
-      if (reset_required_) {
-        // reset all data
-        MarkerArrayType markers;
-        markers.markers.resize(1);
-        MarkerType & marker_probes = markers.markers[0];
-        marker_probes.action = MarkerType::DELETEALL;
-        publisher_localizer_probes_->publish(markers);
-        reset_required_ = false;
-      }
-      cond_var_.wait_for(
-        locker,
-        std::chrono::milliseconds(period_ms_));
-      if (!cuvslam_slam_) {break;}
-      if (!rclcpp::ok()) {break;}
-      if (!HasSubscribers(publisher_localizer_probes_)) {
-        // no subscribers so disable reading
-        cuvslam_slam_->DisableReadingData(cuvslam::Slam::DataLayer::LocalizerProbes);
-        continue;
-      }
-      // enable reading
-      cuvslam_slam_->EnableReadingData(cuvslam::Slam::DataLayer::LocalizerProbes, max_items_count_);
-      // read data
-      std::shared_ptr<const cuvslam::Slam::LocalizerProbes> localizer_probes =
-        cuvslam_slam_->ReadLocalizerProbes();
-      if (last_timestamp_ns_ == localizer_probes->timestamp_ns &&
-        last_num_probes_ == localizer_probes->probes.size())
-      {
-      // don't need to publish now
-        continue;
-      }
+  try {
+    if (reset_required_) {
+      // reset all data
+      MarkerArrayType markers;
+      markers.markers.resize(1);
+      MarkerType & marker_probes = markers.markers[0];
+      marker_probes.action = MarkerType::DELETEALL;
+      publisher_localizer_probes_->publish(markers);
+      reset_required_ = false;
+    }
+    if (!HasSubscribers(has_localizer_probes_subscribers_)) {
+      // no subscribers so disable reading
+      cuvslam_slam_->DisableReadingData(cuvslam::Slam::DataLayer::LocalizerProbes);
+      return;
+    }
+    // enable reading
+    cuvslam_slam_->EnableReadingData(cuvslam::Slam::DataLayer::LocalizerProbes, max_items_count_);
+    // read data
+    std::shared_ptr<const cuvslam::Slam::LocalizerProbes> localizer_probes =
+      cuvslam_slam_->ReadLocalizerProbes();
+    if (last_timestamp_ns_ == localizer_probes->timestamp_ns &&
+      last_num_probes_ == localizer_probes->probes.size())
+    {
+    // don't need to publish now
+      return;
+    }
 
-      last_timestamp_ns_ = localizer_probes->timestamp_ns;
-      last_num_probes_ = localizer_probes->probes.size();
-      rclcpp::Time stamp(localizer_probes->timestamp_ns, RCL_SYSTEM_TIME);
+    last_timestamp_ns_ = localizer_probes->timestamp_ns;
+    last_num_probes_ = localizer_probes->probes.size();
+    rclcpp::Time stamp(localizer_probes->timestamp_ns, RCL_SYSTEM_TIME);
 
-      const float scale = localizer_probes->size;
-      const tf2::Vector3 zero(0, 0, 0);
-      const tf2::Vector3 one(scale, 0, 0);
-      const tf2::Vector3 color_max(1, 1, 1);
-      tf2::Vector3 color_in_progress(0.10, 0.15, 1);
-      tf2::Vector3 color_successful(0.15, 0.5, 0.10);
-      tf2::Vector3 color_failed(0.5, 0.1, 0.15);
+    const float scale = localizer_probes->size;
+    const tf2::Vector3 zero(0, 0, 0);
+    const tf2::Vector3 one(scale, 0, 0);
+    const tf2::Vector3 color_max(1, 1, 1);
+    tf2::Vector3 color_in_progress(0.10, 0.15, 1);
+    tf2::Vector3 color_successful(0.15, 0.5, 0.10);
+    tf2::Vector3 color_failed(0.5, 0.1, 0.15);
 
-      tf2::Vector3 color_min = color_in_progress;
-      if (localization_finished_ && have_result_pose_) {
-        color_min = color_successful;
-      }
-      if (localization_finished_ && !have_result_pose_) {
-        color_min = color_failed;
-      }
+    tf2::Vector3 color_min = color_in_progress;
+    if (localization_finished_ && have_result_pose_) {
+      color_min = color_successful;
+    }
+    if (localization_finished_ && !have_result_pose_) {
+      color_min = color_failed;
+    }
 
-      if (true) {
-        MarkerArrayType markers;
-        markers.markers.resize(2);
-        {
-          MarkerType & marker_probes = markers.markers[0];
-          marker_probes.header.frame_id = frame_id_;
-          marker_probes.header.stamp = stamp;
-          marker_probes.ns = "probes";
-          marker_probes.id = 0;
-          marker_probes.action = MarkerType::ADD;
-          marker_probes.type = MarkerType::LINE_LIST;
-          marker_probes.pose.position.x = 0;
-          marker_probes.pose.position.y = 0;
-          marker_probes.pose.position.z = 0;
-          marker_probes.pose.orientation.x = 0.0;
-          marker_probes.pose.orientation.y = 0.0;
-          marker_probes.pose.orientation.z = 0.0;
-          marker_probes.pose.orientation.w = 1.0;
-          marker_probes.scale.x = 0.003;
-          marker_probes.scale.y = 0.003;
-          marker_probes.scale.z = 0.003;
-          marker_probes.color.a = 0.25;
-          marker_probes.color.r = 1.0;
-          marker_probes.color.g = 1.0;
-          marker_probes.color.b = 1.0;
-          marker_probes.points.resize(localizer_probes->probes.size() * 2);
-          marker_probes.colors.resize(localizer_probes->probes.size() * 2);
-          if (localizer_probes->probes.size() == 0) {
-            marker_probes.action = MarkerType::DELETE;
-          }
-          for (uint32_t i = 0; i < localizer_probes->probes.size(); i++) {
-            const cuvslam::Slam::LocalizerProbe & probe = localizer_probes->probes[i];
+    if (true) {
+      MarkerArrayType markers;
+      markers.markers.resize(2);
+      {
+        MarkerType & marker_probes = markers.markers[0];
+        marker_probes.header.frame_id = frame_id_;
+        marker_probes.header.stamp = stamp;
+        marker_probes.ns = "probes";
+        marker_probes.id = 0;
+        marker_probes.action = MarkerType::ADD;
+        marker_probes.type = MarkerType::LINE_LIST;
+        marker_probes.pose.position.x = 0;
+        marker_probes.pose.position.y = 0;
+        marker_probes.pose.position.z = 0;
+        marker_probes.pose.orientation.x = 0.0;
+        marker_probes.pose.orientation.y = 0.0;
+        marker_probes.pose.orientation.z = 0.0;
+        marker_probes.pose.orientation.w = 1.0;
+        marker_probes.scale.x = 0.003;
+        marker_probes.scale.y = 0.003;
+        marker_probes.scale.z = 0.003;
+        marker_probes.color.a = 0.25;
+        marker_probes.color.r = 1.0;
+        marker_probes.color.g = 1.0;
+        marker_probes.color.b = 1.0;
+        marker_probes.points.resize(localizer_probes->probes.size() * 2);
+        marker_probes.colors.resize(localizer_probes->probes.size() * 2);
+        if (localizer_probes->probes.size() == 0) {
+          marker_probes.action = MarkerType::DELETE;
+        }
+        for (uint32_t i = 0; i < localizer_probes->probes.size(); i++) {
+          const cuvslam::Slam::LocalizerProbe & probe = localizer_probes->probes[i];
 
-            tf2::Transform guess_pose_cuvslam = FromcuVSLAMPose(probe.guess_pose);
-            tf2::Vector3 origin = guess_pose_cuvslam * tf2::Vector3(
-            0, 0, -localizer_probes->size * 0.05);
-            guess_pose_cuvslam.setOrigin(origin);
-            const tf2::Transform guess_pose__ros{ChangeBasis(
-              canonical_pose_cuvslam_,
-              guess_pose_cuvslam)};
+          tf2::Transform guess_pose_cuvslam = FromcuVSLAMPose(probe.guess_pose);
+          tf2::Vector3 origin = guess_pose_cuvslam * tf2::Vector3(
+          0, 0, -localizer_probes->size * 0.05);
+          guess_pose_cuvslam.setOrigin(origin);
+          const tf2::Transform guess_pose__ros{ChangeBasis(
+            canonical_pose_cuvslam_,
+            guess_pose_cuvslam)};
 
-            tf2::Vector3 p1 = guess_pose__ros * zero;
-            tf2::Vector3 p2 = guess_pose__ros * (one * 0.4);
+          tf2::Vector3 p1 = guess_pose__ros * zero;
+          tf2::Vector3 p2 = guess_pose__ros * (one * 0.4);
 
-            geometry_msgs::msg::Point pp1;
-            pp1.x = p1[0]; pp1.y = p1[1]; pp1.z = p1[2];
-            geometry_msgs::msg::Point pp2;
-            pp2.x = p2[0]; pp2.y = p2[1]; pp2.z = p2[2];
+          geometry_msgs::msg::Point pp1;
+          pp1.x = p1[0]; pp1.y = p1[1]; pp1.z = p1[2];
+          geometry_msgs::msg::Point pp2;
+          pp2.x = p2[0]; pp2.y = p2[1]; pp2.z = p2[2];
 
-            marker_probes.points[i * 2 + 0] = pp1;
-            marker_probes.points[i * 2 + 1] = pp2;
+          marker_probes.points[i * 2 + 0] = pp1;
+          marker_probes.points[i * 2 + 1] = pp2;
 
-            float w = std::max(std::min(probe.weight, 1.f), 0.25f);
-            tf2::Vector3 c = color_max * w + color_min * (1 - w);
-            std_msgs::msg::ColorRGBA color;
-            color.r = c[0]; color.g = c[1]; color.b = c[2];
-            color.a = 1;
+          float w = std::max(std::min(probe.weight, 1.f), 0.25f);
+          tf2::Vector3 c = color_max * w + color_min * (1 - w);
+          std_msgs::msg::ColorRGBA color;
+          color.r = c[0]; color.g = c[1]; color.b = c[2];
+          color.a = 1;
 
-            marker_probes.colors[i * 2 + 0] = color;
-            marker_probes.colors[i * 2 + 1] = color;
-          }
+          marker_probes.colors[i * 2 + 0] = color;
+          marker_probes.colors[i * 2 + 1] = color;
         }
-        {
-          MarkerType & marker_probes = markers.markers[1];
-          marker_probes.header.frame_id = frame_id_;
-          marker_probes.header.stamp = stamp;
-          marker_probes.ns = "result";
-          marker_probes.id = 0;
-          marker_probes.action = MarkerType::ADD;
-          marker_probes.type = MarkerType::LINE_STRIP;
-          marker_probes.pose.position.x = 0;
-          marker_probes.pose.position.y = 0;
-          marker_probes.pose.position.z = 0;
-          marker_probes.pose.orientation.x = 0.0;
-          marker_probes.pose.orientation.y = 0.0;
-          marker_probes.pose.orientation.z = 0.0;
-          marker_probes.pose.orientation.w = 1.0;
-          marker_probes.scale.x = 0.1;
-          marker_probes.scale.y = 0.1;
-          marker_probes.scale.z = 0.1;
-          marker_probes.color.a = 0.25;
-          marker_probes.color.r = 1.0;
-          marker_probes.color.g = 1.0;
-          marker_probes.color.b = 1.0;
-          std::vector<tf2::Vector3> line_strip;
-          std::vector<tf2::Vector3> line_colors;
-          if (have_result_pose_) {
-            line_strip.push_back(result_pose_ * zero);
-            line_strip.push_back(result_pose_ * tf2::Vector3(scale, 0, 0));
-            line_colors.push_back(tf2::Vector3(1, 0, 0));
-            line_colors.push_back(tf2::Vector3(1, 0, 0));
+      }
+      {
+        MarkerType & marker_probes = markers.markers[1];
+        marker_probes.header.frame_id = frame_id_;
+        marker_probes.header.stamp = stamp;
+        marker_probes.ns = "result";
+        marker_probes.id = 0;
+        marker_probes.action = MarkerType::ADD;
+        marker_probes.type = MarkerType::LINE_STRIP;
+        marker_probes.pose.position.x = 0;
+        marker_probes.pose.position.y = 0;
+        marker_probes.pose.position.z = 0;
+        marker_probes.pose.orientation.x = 0.0;
+        marker_probes.pose.orientation.y = 0.0;
+        marker_probes.pose.orientation.z = 0.0;
+        marker_probes.pose.orientation.w = 1.0;
+        marker_probes.scale.x = 0.1;
+        marker_probes.scale.y = 0.1;
+        marker_probes.scale.z = 0.1;
+        marker_probes.color.a = 0.25;
+        marker_probes.color.r = 1.0;
+        marker_probes.color.g = 1.0;
+        marker_probes.color.b = 1.0;
+        std::vector<tf2::Vector3> line_strip;
+        std::vector<tf2::Vector3> line_colors;
+        if (have_result_pose_) {
+          line_strip.push_back(result_pose_ * zero);
+          line_strip.push_back(result_pose_ * tf2::Vector3(scale, 0, 0));
+          line_colors.push_back(tf2::Vector3(1, 0, 0));
+          line_colors.push_back(tf2::Vector3(1, 0, 0));
 
-            line_strip.push_back(result_pose_ * zero);
-            line_strip.push_back(result_pose_ * tf2::Vector3(0, scale, 0));
-            line_colors.push_back(tf2::Vector3(0, 1, 0));
-            line_colors.push_back(tf2::Vector3(0, 1, 0));
+          line_strip.push_back(result_pose_ * zero);
+          line_strip.push_back(result_pose_ * tf2::Vector3(0, scale, 0));
+          line_colors.push_back(tf2::Vector3(0, 1, 0));
+          line_colors.push_back(tf2::Vector3(0, 1, 0));
 
-            line_strip.push_back(result_pose_ * zero);
-            line_strip.push_back(result_pose_ * tf2::Vector3(0, 0, scale));
-            line_colors.push_back(tf2::Vector3(0, 0, 1));
-            line_colors.push_back(tf2::Vector3(0, 0, 1));
-          } else {
-            marker_probes.action = MarkerType::DELETE;
-          }
-          marker_probes.points.resize(line_strip.size());
-          marker_probes.colors.resize(line_strip.size());
+          line_strip.push_back(result_pose_ * zero);
+          line_strip.push_back(result_pose_ * tf2::Vector3(0, 0, scale));
+          line_colors.push_back(tf2::Vector3(0, 0, 1));
+          line_colors.push_back(tf2::Vector3(0, 0, 1));
+        } else {
+          marker_probes.action = MarkerType::DELETE;
+        }
+        marker_probes.points.resize(line_strip.size());
+        marker_probes.colors.resize(line_strip.size());
 
-          for (size_t i = 0; i < line_strip.size(); i++) {
-            auto & p = line_strip[i];
-            geometry_msgs::msg::Point pp;
-            pp.x = p[0]; pp.y = p[1]; pp.z = p[2];
-            marker_probes.points[i] = pp;
+        for (size_t i = 0; i < line_strip.size(); i++) {
+          auto & p = line_strip[i];
+          geometry_msgs::msg::Point pp;
+          pp.x = p[0]; pp.y = p[1]; pp.z = p[2];
+          marker_probes.points[i] = pp;
 
-            auto & c = line_colors[i];
-            std_msgs::msg::ColorRGBA color;
-            color.r = c[0]; color.g = c[1]; color.b = c[2];
-            color.a = 1;
-            marker_probes.colors[i] = color;
-          }
+          auto & c = line_colors[i];
+          std_msgs::msg::ColorRGBA color;
+          color.r = c[0]; color.g = c[1]; color.b = c[2];
+          color.a = 1;
+          marker_probes.colors[i] = color;
         }
-        publisher_localizer_probes_->publish(markers);
       }
-    } catch (const std::exception & e) {
-      RCLCPP_WARN(logger_, "LocalizerVisHelper has failed to run: %s", e.what());
+      publisher_localizer_probes_->publish(markers);
     }
+  } catch (const std::exception & e) {
+    RCLCPP_WARN(logger_, "LocalizerVisHelper has failed to run: %s", e.what());
   }
 }
 
@@ -17,7 +17,7 @@
 
 #include <math.h>
 
-#include <cstring>
+#include <algorithm>
 #include <vector>
 
 #include "isaac_ros_visual_slam/impl/pose_cache.hpp"
@@ -71,20 +71,17 @@ void getTranslationAndEulerAngles(
   }
 }
 
+// Number of poses used for the velocity and the minimum number of samples for a covariance.
+constexpr size_t kNumVelocityPoses = 10;
+constexpr size_t kMinNumCovarianceSamples = 10;
+
 void QuaternionCovToRollPitchYawCov(
-  const std::array<double, 7 * 7> & quat_cov,
+  const Eigen::Matrix<double, 7, 7> & quat_cov,
   const tf2::Quaternion & mean_quat,
   std::array<double, 6 * 6> & cov)
 {
   // Jacobian
-  double J[6][7];
-
-  // Set identity;
-  for (int i = 0; i < 6; i++) {
-    for (int j = 0; j < 7; j++) {
-      J[i][j] = i == j ? 1 : 0;
-    }
-  }
+  Eigen::Matrix<double, 6, 7> J = Eigen::Matrix<double, 6, 7>::Identity();
 
   double determinant = mean_quat.w() * mean_quat.y() - mean_quat.x() * mean_quat.z();
 
@@ -99,76 +96,72 @@ void QuaternionCovToRollPitchYawCov(
     double t6 = 2.0 * (mean_quat.w() * mean_quat.z() + mean_quat.x() * mean_quat.y());
     double t7 = 1 / (t5 * t5 + t6 * t6);
 
-    J[3][3] = (2 * mean_quat.w() * t1 + 4 * mean_quat.x() * t2) * t3;      // d roll / d q.x
-    J[3][4] = (2 * mean_quat.z() * t1 + 4 * mean_quat.y() * t2) * t3;      // d roll / d q.y
-    J[3][5] = 2 * mean_quat.y() * t1 * t3;                                 // d roll / d q.z
-    J[3][6] = 2 * mean_quat.x() * t1 * t3;                                 // d roll / d q.w
+    J(3, 3) = (2 * mean_quat.w() * t1 + 4 * mean_quat.x() * t2) * t3;      // d roll / d q.x
+    J(3, 4) = (2 * mean_quat.z() * t1 + 4 * mean_quat.y() * t2) * t3;      // d roll / d q.y
+    J(3, 5) = 2 * mean_quat.y() * t1 * t3;                                 // d roll / d q.z
+    J(3, 6) = 2 * mean_quat.x() * t1 * t3;                                 // d roll / d q.w
 
-    J[4][3] = -2 * mean_quat.z() * t4;                                     // d pitch / d q.x
-    J[4][4] = 2 * mean_quat.w() * t4;                                      // d pitch / d q.y
-    J[4][5] = -2 * mean_quat.x() * t4;                                     // d pitch / d q.z
-    J[4][6] = 2 * mean_quat.y() * t4;                                      // d pitch / d q.w
+    J(4, 3) = -2 * mean_quat.z() * t4;                                     // d pitch / d q.x
+    J(4, 4) = 2 * mean_quat.w() * t4;                                      // d pitch / d q.y
+    J(4, 5) = -2 * mean_quat.x() * t4;                                     // d pitch / d q.z
+    J(4, 6) = 2 * mean_quat.y() * t4;                                      // d pitch / d q.w
 
-    J[5][3] = 2 * mean_quat.y() * t5 * t7;                                 // d yaw / d q.x
-    J[5][4] = (2 * mean_quat.x() * t5 + 4 * mean_quat.y() * t6) * t7;      // d yaw / d q.y
-    J[5][5] = (2 * mean_quat.w() * t5 + 4 * mean_quat.z() * t6) * t7;      // d yaw / d q.z
-    J[5][6] = 2 * mean_quat.z() * t5 * t7;                                 // d yaw / d q.w
+    J(5, 3) = 2 * mean_quat.y() * t5 * t7;                                 // d yaw / d q.x
+    J(5, 4) = (2 * mean_quat.x() * t5 + 4 * mean_quat.y() * t6) * t7;      // d yaw / d q.y
+    J(5, 5) = (2 * mean_quat.w() * t5 + 4 * mean_quat.z() * t6) * t7;      // d yaw / d q.z
+    J(5, 6) = 2 * mean_quat.z() * t5 * t7;                                 // d yaw / d q.w
   } else {
     double t1 = mean_quat.w() * mean_quat.w();
     double t2 = mean_quat.x() * mean_quat.x();
     double t4 = 1 / (t1 + t2);
 
-    J[3][3] = 0;
-    J[3][4] = 0;
-    J[3][5] = 0;
-    J[3][6] = 0;
+    J(3, 3) = 0;
+    J(3, 4) = 0;
+    J(3, 5) = 0;
+    J(3, 6) = 0;
 
-    J[4][3] = 0;
-    J[4][4] = 0;
-    J[4][5] = 0;
-    J[4][6] = 0;
+    J(4, 3) = 0;
+    J(4, 4) = 0;
+    J(4, 5) = 0;
+    J(4, 6) = 0;
 
-    J[5][4] = 0;
-    J[5][5] = 0;
+    J(5, 4) = 0;
+    J(5, 5) = 0;
 
     if (determinant < 0) {
       // roll  = 0
       // pitch = -M_PI/2.0
       // yaw   = 2.0 * atan2(q.x(), q.w())
 
-      J[5][3] = 2 * mean_quat.w() * t4;         // d yaw / d q.x
-      J[5][6] = -2 * mean_quat.x() * t4;        // d yaw / d q.w
+      J(5, 3) = 2 * mean_quat.w() * t4;         // d yaw / d q.x
+      J(5, 6) = -2 * mean_quat.x() * t4;        // d yaw / d q.w
     } else {
       // roll  = 0;
       // pitch = M_PI/2.0;
       // yaw   = -2.0 * atan2(q.x(), q.w());
-      J[5][3] = -2 * mean_quat.w() * t4;        // d yaw / d q.x
-      J[5][6] = 2 * mean_quat.x() * t4;         // d yaw / d q.w
+      J(5, 3) = -2 * mean_quat.w() * t4;        // d yaw / d q.x
+      J(5, 6) = 2 * mean_quat.x() * t4;         // d yaw / d q.w
     }
   }
 
   // Calculate J * covariance * J.transpose()
-  {
-    double cov_J_transposed[7][6];     //  covariance * J.transpose()
-    for (int i = 0; i < 7; i++) {
-      for (int j = 0; j < 6; j++) {
-        double t = 0;
-        for (int k = 0; k < 7; k++) {
-          t += quat_cov[i * 7 + k] * J[j][k] /*J transposed*/;
-        }
-        cov_J_transposed[i][j] = t;
-      }
-    }
+  Eigen::Map<Eigen::Matrix<double, 6, 6, Eigen::RowMajor>>(cov.data()).noalias() =
+    J * quat_cov * J.transpose();
+}
 
-    for (int i = 0; i < 6; i++) {
-      for (int j = 0; j < 6; j++) {
-        double t = 0;
-        for (int k = 0; k < 7; k++) {
-          t += J[i][k] * cov_J_transposed[k][j];
-        }
-        cov[i * 6 + j] = t;
-      }
-    }
+// Recomputes the statistics from all samples of a window once every window_size adds.
+template<class Statistics, class GetSample>
+void MaybeRecompute(
+  size_t window_size, size_t size, size_t & num_adds_since_recompute, Statistics & statistics,
+  GetSample get_sample)
+{
+  if (++num_adds_since_recompute < window_size) {
+    return;
+  }
+  num_adds_since_recompute = 0;
+  statistics.Reset();
+  for (size_t i = 0; i < size; i++) {
+    statistics.Add(get_sample(i));
   }
 }
 }  //  namespace
@@ -179,17 +172,53 @@ namespace isaac_ros
 {
 namespace visual_slam
 {
+PoseCache::PoseCache(size_t window_size)
+: window_size_(std::max<size_t>(window_size, 2))
+{
+  poses_.reserve(window_size_);
+}
+
 void PoseCache::Reset()
 {
   poses_.clear();
+  head_ = 0;
+  num_adds_since_recompute_ = 0;
+  prev_axis_ = {0, 0, 0};
+  statistics_.Reset();
 }
+
+const PoseCache::Entry & PoseCache::At(size_t index) const
+{
+  const size_t position = head_ + index;
+  return poses_[position < poses_.size() ? position : position - poses_.size()];
+}
+
 void PoseCache::Add(int64_t timestamp, const tf2::Transform & pose)
 {
-  poses_.push_back({timestamp, pose});
+  const tf2::Vector3 & translate = pose.getOrigin();
+  tf2::Quaternion q = pose.getRotation();
+  q.normalize();
+
+  if (prev_axis_.dot(q.getAxis()) < 0) {
+    q *= -1;
+  }
+  prev_axis_ = q.getAxis();
 
-  while (poses_.size() > num_poses_to_keep_) {
-    poses_.pop_front();
+  Entry entry{timestamp, pose, Sample()};
+  entry.sample << translate[0], translate[1], translate[2], q.x(), q.y(), q.z(), q.w();
+
+  if (poses_.size() < window_size_) {
+    poses_.push_back(entry);
+  } else {
+    // Replace the oldest pose.
+    statistics_.Remove(poses_[head_].sample);
+    poses_[head_] = entry;
+    head_ = head_ + 1 == poses_.size() ? 0 : head_ + 1;
   }
+  statistics_.Add(entry.sample);
+  MaybeRecompute(
+    window_size_, poses_.size(), num_adds_since_recompute_, statistics_,
+    [this](size_t i) -> const Sample & {return At(i).sample;});
 }
 
 bool PoseCache::GetVelocity(
@@ -206,11 +235,11 @@ bool PoseCache::GetVelocity(
     return false;
   }
   // diff
-  auto & it0 = poses_.front();
-  auto & it1 = poses_.back();
+  const Entry & it0 = At(poses_.size() - std::min(poses_.size(), kNumVelocityPoses));
+  const Entry & it1 = At(poses_.size() - 1);
 
-  const tf2::Transform dp = it0.second.inverse() * it1.second;
-  const double dt = (it1.first - it0.first) * 1e-9;
+  const tf2::Transform dp = it0.pose.inverse() * it1.pose;
+  const double dt = (it1.timestamp - it0.timestamp) * 1e-9;
   const double dt_inv = 1. / dt;
 
   getTranslationAndEulerAngles(dp, x, y, z, roll, pitch, yaw);
@@ -224,111 +253,79 @@ bool PoseCache::GetVelocity(
   return true;
 }
 
-bool PoseCache::GetCovariance(std::array<double, 6 * 6> & cov) const
+bool PoseCache::GetLinearVelocity(tf2::Vector3 & linear_velocity) const
 {
-  if (poses_.size() < 10) {
+  if (poses_.size() < 2) {
+    linear_velocity.setZero();
     return false;
   }
+  const Entry & it0 = At(poses_.size() - std::min(poses_.size(), kNumVelocityPoses));
+  const Entry & it1 = At(poses_.size() - 1);
+  const double dt = (it1.timestamp - it0.timestamp) * 1e-9;
+  linear_velocity = (it1.pose.getOrigin() - it0.pose.getOrigin()) / dt;
+  return true;
+}
 
-  std::array<double, 7 * 7> pose_quat_covariance;
-  pose_quat_covariance.fill(0.0);
-
-  tf2::Quaternion mean_quat;
-  {
-    std::array<double, 7> mean;
-    mean.fill(0.0);
-
-    tf2::Vector3 prev_axis = {0, 0, 0};
-    for (const auto & pair : poses_) {
-      const tf2::Transform & pose = pair.second;
-      const tf2::Vector3 & translate = pose.getOrigin();
-      tf2::Quaternion q = pose.getRotation();
-      q.normalize();
-
-      if (prev_axis.dot(q.getAxis()) < 0) {
-        q *= -1;
-      }
-      prev_axis = q.getAxis();
-
-      double vect[7] = {
-        translate[0], translate[1], translate[2], q.x(), q.y(), q.z(), q.w()
-      };
-
-      for (int i = 0; i < 7; i++) {
-        mean[i] += vect[i];
-        for (int j = 0; j < 7; j++) {
-          pose_quat_covariance[i * 7 + j] += vect[i] * vect[j];
-        }
-      }
-    }
-
-    for (int i = 0; i < 7; i++) {
-      mean[i] /= poses_.size();
-    }
-
-    for (int i = 0; i < 7; i++) {
-      for (int j = 0; j < 7; j++) {
-        pose_quat_covariance[i * 7 + j] = pose_quat_covariance[i * 7 + j] / poses_.size() -
-          mean[i] * mean[j];
-      }
-    }
-
-    mean_quat = tf2::Quaternion(mean[3], mean[4], mean[5], mean[6]);
-    mean_quat.normalize();
+bool PoseCache::GetCovariance(std::array<double, 6 * 6> & cov) const
+{
+  if (poses_.size() < std::min(window_size_, kMinNumCovarianceSamples)) {
+    return false;
   }
 
-  QuaternionCovToRollPitchYawCov(pose_quat_covariance, mean_quat, cov);
+  // The mean quaternion does not depend on the sign of the first quaternion in the window: the
+  // covariance and the jacobian flip their signs together.
+  const Sample & mean = statistics_.Mean();
+  tf2::Quaternion mean_quat(mean[3], mean[4], mean[5], mean[6]);
+  mean_quat.normalize();
+
+  QuaternionCovToRollPitchYawCov(statistics_.Covariance(), mean_quat, cov);
   return true;
 }
 
+VelocityCache::VelocityCache(size_t window_size)
+: window_size_(std::max<size_t>(window_size, 2))
+{
+  velocities_.reserve(window_size_);
+}
+
 void VelocityCache::Reset()
 {
   velocities_.clear();
+  head_ = 0;
+  num_adds_since_recompute_ = 0;
+  statistics_.Reset();
 }
 
 void VelocityCache::Add(
   const double & x, const double & y, const double & z, const double & roll,
   const double & pitch, const double & yaw)
 {
-  velocities_.push_back(
-        {
-          x, y, z,
-          roll, pitch, yaw
-        });
-
-  while (velocities_.size() > num_velocities_to_keep_) {
-    velocities_.pop_front();
+  Sample velocity;
+  velocity << x, y, z, roll, pitch, yaw;
+
+  if (velocities_.size() < window_size_) {
+    velocities_.push_back(velocity);
+  } else {
+    // Replace the oldest velocity.
+    statistics_.Remove(velocities_[head_]);
+    velocities_[head_] = velocity;
+    head_ = head_ + 1 == velocities_.size() ? 0 : head_ + 1;
   }
+  statistics_.Add(velocity);
+  // The order of the samples does not matter for the statistics.
+  MaybeRecompute(
+    window_size_, velocities_.size(), num_adds_since_recompute_, statistics_,
+    [this](size_t i) -> const Sample & {return velocities_[i];});
 }
 
 bool VelocityCache::GetCovariance(std::array<double, 6 * 6> & cov) const
 {
-  if (velocities_.size() < 10) {
+  if (velocities_.size() < std::min(window_size_, kMinNumCovarianceSamples)) {
     return false;
   }
 
-  std::array<double, 7> mean;
-  mean.fill(0.0);
-
-  for (const auto & vect : velocities_) {
-    for (int i = 0; i < 6; i++) {
-      mean[i] += vect[i];
-      for (int j = 0; j < 6; j++) {
-        cov[i * 6 + j] += vect[i] * vect[j];
-      }
-    }
-  }
-
-  for (int i = 0; i < 6; i++) {
-    mean[i] /= velocities_.size();
-  }
-
-  for (int i = 0; i < 6; i++) {
-    for (int j = 0; j < 6; j++) {
-      cov[i * 6 + j] = cov[i * 6 + j] / velocities_.size() - mean[i] * mean[j];
-    }
-  }
-
+  Eigen::Map<Eigen::Matrix<double, 6, 6, Eigen::RowMajor>>(cov.data()) =
+    statistics_.Covariance();
   return true;
 }
 
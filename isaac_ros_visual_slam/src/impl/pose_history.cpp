@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/pose_history.hpp"
+#include "isaac_ros_visual_slam/impl/sensor_time.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+PoseHistory::PoseHistory(size_t capacity, int64_t max_extrapolation_ns)
+: capacity_(std::max<size_t>(capacity, 2)), max_extrapolation_ns_(max_extrapolation_ns)
+{
+  entries_.reserve(capacity_);
+}
+
+void PoseHistory::Reset()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  head_ = 0;
+  lost_ = false;
+}
+
+const PoseHistory::Entry & PoseHistory::At(size_t index) const
+{
+  const size_t position = head_ + index;
+  return entries_[position < entries_.size() ? position : position - entries_.size()];
+}
+
+void PoseHistory::Add(
+  int64_t timestamp, const tf2::Transform & odom_pose, const tf2::Transform & map_pose)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Entry entry{
+    timestamp, {odom_pose.getOrigin(), odom_pose.getRotation()},
+    {map_pose.getOrigin(), map_pose.getRotation()}, lost_};
+  lost_ = false;
+
+  if (!entries_.empty()) {
+    // The newest entry is right before head_ in the ring.
+    Entry & last = entries_[head_ == 0 ? entries_.size() - 1 : head_ - 1];
+    if (timestamp == last.timestamp) {
+      entry.follows_gap = entry.follows_gap || last.follows_gap;
+      last = entry;
+      return;
+    }
+    if (IsTimeJumpBack(timestamp, last.timestamp)) {
+      entries_.clear();
+      head_ = 0;
+    }
+  }
+
+  if (entries_.size() < capacity_) {
+    entries_.push_back(entry);
+  } else {
+    entries_[head_] = entry;
+    head_ = head_ + 1 < capacity_ ? head_ + 1 : 0;
+  }
+}
+
+void PoseHistory::MarkDiscontinuity()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  lost_ = true;
+}
+
+size_t PoseHistory::GetPoses(
+  Frame frame, const std::vector<int64_t> & timestamps,
+  std::vector<std::optional<tf2::Transform>> & poses) const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  poses.resize(timestamps.size());
+  size_t num_found = 0;
+  for (size_t i = 0; i < timestamps.size(); i++) {
+    poses[i] = GetPose(frame, timestamps[i]);
+    num_found += poses[i].has_value();
+  }
+  return num_found;
+}
+
+std::optional<tf2::Transform> PoseHistory::GetPose(Frame frame, int64_t timestamp) const
+{
+  const size_t size = entries_.size();
+  if (size == 0) {
+    return std::nullopt;
+  }
+
+  // Index of the first entry not older than timestamp.
+  size_t lower = 0;
+  size_t upper = size;
+  while (lower < upper) {
+    const size_t middle = lower + (upper - lower) / 2;
+    if (At(middle).timestamp < timestamp) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+
+  if (lower < size && At(lower).timestamp == timestamp) {
+    const Pose & pose = frame == Frame::kOdom ? At(lower).odom : At(lower).map;
+    return tf2::Transform(pose.rotation, pose.origin);
+  }
+  if (lower == 0) {
+    // Before the oldest pose.
+    if (size < 2 || At(1).follows_gap ||
+      At(0).timestamp - timestamp > max_extrapolation_ns_)
+    {
+      return std::nullopt;
+    }
+    return Interpolate(frame, At(0), At(1), timestamp);
+  }
+  if (lower == size) {
+    // After the newest pose.
+    if (lost_ || size < 2 || At(size - 1).follows_gap ||
+      timestamp - At(size - 1).timestamp > max_extrapolation_ns_)
+    {
+      return std::nullopt;
+    }
+    return Interpolate(frame, At(size - 2), At(size - 1), timestamp);
+  }
+  if (At(lower).follows_gap) {
+    return std::nullopt;
+  }
+  return Interpolate(frame, At(lower - 1), At(lower), timestamp);
+}
+
+tf2::Transform PoseHistory::Interpolate(
+  Frame frame, const Entry & a, const Entry & b, int64_t timestamp)
+{
+  const Pose & pose_a = frame == Frame::kOdom ? a.odom : a.map;
+  const Pose & pose_b = frame == Frame::kOdom ? b.odom : b.map;
+  // Outside of [0, 1] for extrapolation, slerp and lerp continue the motion between a and b.
+  const double t = static_cast<double>(timestamp - a.timestamp) / (b.timestamp - a.timestamp);
+  tf2::Quaternion rotation = pose_a.rotation.slerp(pose_b.rotation, t);
+  rotation.normalize();
+  return tf2::Transform(rotation, pose_a.origin.lerp(pose_b.origin, t));
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -21,8 +21,8 @@
 #include <utility>
 
 #include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
-#include "isaac_ros_visual_slam/impl/has_subscribers.hpp"
 #include "isaac_ros_visual_slam/impl/posegraph_vis_helper.hpp"
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
 
@@ -35,10 +35,14 @@ namespace visual_slam
 
 // PoseGraphVisHelper
 PoseGraphVisHelper::PoseGraphVisHelper(
+  VisScheduler & scheduler,
+  SubscriberPresence & presence,
+  int priority,
   cuvslam::Slam::DataLayer layer,
   uint32_t max_items_count,
   uint32_t period_ms)
-: layer_(layer), max_items_count_(max_items_count), period_ms_(period_ms)
+: VisHelper(scheduler, presence, priority), layer_(layer), max_items_count_(max_items_count),
+  period_ms_(period_ms)
 {
 }
 
@@ -59,9 +63,12 @@ void PoseGraphVisHelper::Init(
   publisher_nodes_ = publisher_nodes;
   publisher_edges_ = publisher_edges;
   publisher_edges2_ = publisher_edges2;
+  has_nodes_subscribers_ = presence_.Track(publisher_nodes);
+  has_edges_subscribers_ = presence_.Track(publisher_edges);
+  has_edges2_subscribers_ = presence_.Track(publisher_edges2);
 
   VisHelper::Init(cuvslam_slam, canonical_pose_cuvslam, frame_id, logger);
-  thread_ = std::thread{&PoseGraphVisHelper::Run, this};
+  Start(period_ms_);
 }
 
 void PoseGraphVisHelper::Reset()
@@ -72,195 +79,188 @@ void PoseGraphVisHelper::Reset()
   publisher_nodes_.reset();
   publisher_edges_.reset();
   publisher_edges2_.reset();
+  has_nodes_subscribers_ = nullptr;
+  has_edges_subscribers_ = nullptr;
+  has_edges2_subscribers_ = nullptr;
 }
 
 void PoseGraphVisHelper::Run()
 {
-  std::unique_lock<std::mutex> locker(mutex_);
-  // cuvslam_slam_ will be null after Exit() was called
-  while (cuvslam_slam_) {
-    try {
-      cond_var_.wait_for(
-      locker,
-      std::chrono::milliseconds(period_ms_));
-      if (!cuvslam_slam_) {break;}
-      if (!rclcpp::ok()) {break;}
-
-      bool has_subnumber_nodes = HasSubscribers(publisher_nodes_);
-      bool has_subnumber_edges = HasSubscribers(publisher_edges_);
-      bool has_subnumber_edges2 = HasSubscribers(publisher_edges2_);
-      if (!has_subnumber_nodes && !has_subnumber_edges && !has_subnumber_edges2) {
-      // no subscribers so disable reading
-        cuvslam_slam_->DisableReadingData(layer_);
-        continue;
-      }
+  try {
+    bool has_subnumber_nodes = HasSubscribers(has_nodes_subscribers_);
+    bool has_subnumber_edges = HasSubscribers(has_edges_subscribers_);
+    bool has_subnumber_edges2 = HasSubscribers(has_edges2_subscribers_);
+    if (!has_subnumber_nodes && !has_subnumber_edges && !has_subnumber_edges2) {
+    // no subscribers so disable reading
+      cuvslam_slam_->DisableReadingData(layer_);
+      return;
+    }
 
-      // enable reading
-      cuvslam_slam_->EnableReadingData(layer_, max_items_count_);
-      // read data
-      std::shared_ptr<const cuvslam::Slam::PoseGraph> pose_graph =
-        cuvslam_slam_->ReadPoseGraph();
-      if (last_timestamp_ns_ == pose_graph->timestamp_ns) {
-        // Don't need to publish now
-        continue;
-      }
-      last_timestamp_ns_ = pose_graph->timestamp_ns;
-      rclcpp::Time stamp(last_timestamp_ns_, RCL_SYSTEM_TIME);
+    // enable reading
+    cuvslam_slam_->EnableReadingData(layer_, max_items_count_);
+    // read data
+    std::shared_ptr<const cuvslam::Slam::PoseGraph> pose_graph =
+      cuvslam_slam_->ReadPoseGraph();
+    if (last_timestamp_ns_ == pose_graph->timestamp_ns) {
+      // Don't need to publish now
+      return;
+    }
+    last_timestamp_ns_ = pose_graph->timestamp_ns;
+    rclcpp::Time stamp(last_timestamp_ns_, RCL_SYSTEM_TIME);
 
-      if (has_subnumber_nodes) {
-        // Publish nodes
-        nodes_msg_t msg = std::make_unique<PoseArrayType>();
+    if (has_subnumber_nodes) {
+      // Publish nodes
+      nodes_msg_t msg = std::make_unique<PoseArrayType>();
 
-        msg->header.frame_id = frame_id_;
-        msg->header.stamp = stamp;
-        msg->poses.resize(pose_graph->nodes.size());
+      msg->header.frame_id = frame_id_;
+      msg->header.stamp = stamp;
+      msg->poses.resize(pose_graph->nodes.size());
 
-        for (uint32_t i = 0; i < pose_graph->nodes.size(); i++) {
-          const cuvslam::Pose & cuvslam_pose = pose_graph->nodes[i].node_pose;
+      for (uint32_t i = 0; i < pose_graph->nodes.size(); i++) {
+        const cuvslam::Pose & cuvslam_pose = pose_graph->nodes[i].node_pose;
 
-          // Change of basis vectors for pose
-          const tf2::Transform ros_pos{ChangeBasis(
-            canonical_pose_cuvslam_,
-            FromcuVSLAMPose(cuvslam_pose))};
+        // Change of basis vectors for pose
+        const tf2::Transform ros_pos{ChangeBasis(
+          canonical_pose_cuvslam_,
+          FromcuVSLAMPose(cuvslam_pose))};
 
-          PoseType dst;
-          tf2::toMsg(ros_pos, dst);
-          msg->poses[i] = dst;
-        }
-      // publishing
-        publisher_nodes_->publish(std::move(msg));
+        PoseType dst;
+        tf2::toMsg(ros_pos, dst);
+        msg->poses[i] = dst;
       }
+    // publishing
+      publisher_nodes_->publish(std::move(msg));
+    }
 
-    // build nodes_index if required
-      std::map<uint64_t, int> nodes_index;
-      if (has_subnumber_edges || has_subnumber_edges2) {
-        for (uint32_t i = 0; i < pose_graph->nodes.size(); i++) {
-          const cuvslam::Slam::PoseGraphNode & node = pose_graph->nodes[i];
-          nodes_index[node.id] = i;
-        }
+  // build nodes_index if required
+    std::map<uint64_t, int> nodes_index;
+    if (has_subnumber_edges || has_subnumber_edges2) {
+      for (uint32_t i = 0; i < pose_graph->nodes.size(); i++) {
+        const cuvslam::Slam::PoseGraphNode & node = pose_graph->nodes[i];
+        nodes_index[node.id] = i;
       }
+    }
 
-      if (has_subnumber_edges) {
-        MarkerType marker_edges;
-        marker_edges.header.frame_id = frame_id_;
-        marker_edges.header.stamp = stamp;
-        marker_edges.ns = "edges";
-        marker_edges.id = 0;
-        marker_edges.action = MarkerType::ADD;
-        marker_edges.type = MarkerType::LINE_LIST;
-        marker_edges.pose.position.x = 0;
-        marker_edges.pose.position.y = 0;
-        marker_edges.pose.position.z = 0;
-        marker_edges.pose.orientation.x = 0.0;
-        marker_edges.pose.orientation.y = 0.0;
-        marker_edges.pose.orientation.z = 0.0;
-        marker_edges.pose.orientation.w = 1.0;
-        marker_edges.scale.x = 0.0033;
-        marker_edges.scale.y = 0.01;
-        marker_edges.scale.z = 0.01;
-        marker_edges.color.a = 0.25;
-        marker_edges.color.r = 1.0;
-        marker_edges.color.g = 1.0;
-        marker_edges.color.b = 1.0;
-        marker_edges.points.resize(pose_graph->edges.size() * 2);
+    if (has_subnumber_edges) {
+      MarkerType marker_edges;
+      marker_edges.header.frame_id = frame_id_;
+      marker_edges.header.stamp = stamp;
+      marker_edges.ns = "edges";
+      marker_edges.id = 0;
+      marker_edges.action = MarkerType::ADD;
+      marker_edges.type = MarkerType::LINE_LIST;
+      marker_edges.pose.position.x = 0;
+      marker_edges.pose.position.y = 0;
+      marker_edges.pose.position.z = 0;
+      marker_edges.pose.orientation.x = 0.0;
+      marker_edges.pose.orientation.y = 0.0;
+      marker_edges.pose.orientation.z = 0.0;
+      marker_edges.pose.orientation.w = 1.0;
+      marker_edges.scale.x = 0.0033;
+      marker_edges.scale.y = 0.01;
+      marker_edges.scale.z = 0.01;
+      marker_edges.color.a = 0.25;
+      marker_edges.color.r = 1.0;
+      marker_edges.color.g = 1.0;
+      marker_edges.color.b = 1.0;
+      marker_edges.points.resize(pose_graph->edges.size() * 2);
 
-        for (uint32_t i = 0; i < pose_graph->edges.size(); i++) {
-          const cuvslam::Slam::PoseGraphEdge & edge = pose_graph->edges[i];
-          auto it_from = nodes_index.find(edge.node_from);
-          auto it_to = nodes_index.find(edge.node_to);
-          if (it_from == nodes_index.end() || it_to == nodes_index.end() ) {
-            continue;
-          }
+      for (uint32_t i = 0; i < pose_graph->edges.size(); i++) {
+        const cuvslam::Slam::PoseGraphEdge & edge = pose_graph->edges[i];
+        auto it_from = nodes_index.find(edge.node_from);
+        auto it_to = nodes_index.find(edge.node_to);
+        if (it_from == nodes_index.end() || it_to == nodes_index.end() ) {
+          continue;
+        }
 
-          const cuvslam::Pose & node_from = pose_graph->nodes[it_from->second].node_pose;
-          const cuvslam::Pose & node_to = pose_graph->nodes[it_to->second].node_pose;
-          const tf2::Transform ros_from{ChangeBasis(
-            canonical_pose_cuvslam_,
-            FromcuVSLAMPose(node_from))};
-          const tf2::Transform ros_to{ChangeBasis(canonical_pose_cuvslam_,
-                    FromcuVSLAMPose(node_to))};
-          tf2::Vector3 zero(0, 0, 0);
-          tf2::Vector3 p1 = ros_from * zero;
-          tf2::Vector3 p2 = ros_to * zero;
+        const cuvslam::Pose & node_from = pose_graph->nodes[it_from->second].node_pose;
+        const cuvslam::Pose & node_to = pose_graph->nodes[it_to->second].node_pose;
+        const tf2::Transform ros_from{ChangeBasis(
+          canonical_pose_cuvslam_,
+          FromcuVSLAMPose(node_from))};
+        const tf2::Transform ros_to{ChangeBasis(canonical_pose_cuvslam_,
+                  FromcuVSLAMPose(node_to))};
+        tf2::Vector3 zero(0, 0, 0);
+        tf2::Vector3 p1 = ros_from * zero;
+        tf2::Vector3 p2 = ros_to * zero;
 
-          geometry_msgs::msg::Point pp1;
-          pp1.x = p1[0];
-          pp1.y = p1[1];
-          pp1.z = p1[2];
-          geometry_msgs::msg::Point pp2;
-          pp2.x = p2[0];
-          pp2.y = p2[1];
-          pp2.z = p2[2];
+        geometry_msgs::msg::Point pp1;
+        pp1.x = p1[0];
+        pp1.y = p1[1];
+        pp1.z = p1[2];
+        geometry_msgs::msg::Point pp2;
+        pp2.x = p2[0];
+        pp2.y = p2[1];
+        pp2.z = p2[2];
 
-          marker_edges.points[i * 2 + 0] = pp1;
-          marker_edges.points[i * 2 + 1] = pp2;
-        }
-        // publishing
-        publisher_edges_->publish(std::move(marker_edges));
+        marker_edges.points[i * 2 + 0] = pp1;
+        marker_edges.points[i * 2 + 1] = pp2;
       }
+      // publishing
+      publisher_edges_->publish(std::move(marker_edges));
+    }
 
-      if (has_subnumber_edges2) {
-        MarkerType marker_edges_transform;
-        marker_edges_transform.header.frame_id = frame_id_;
-        marker_edges_transform.header.stamp = stamp;
-        marker_edges_transform.ns = "edges";
-        marker_edges_transform.id = 1;
-        marker_edges_transform.action = MarkerType::ADD;
-        marker_edges_transform.type = MarkerType::LINE_LIST;
-        marker_edges_transform.pose.position.x = 0;
-        marker_edges_transform.pose.position.y = 0;
-        marker_edges_transform.pose.position.z = 0;
-        marker_edges_transform.pose.orientation.x = 0.0;
-        marker_edges_transform.pose.orientation.y = 0.0;
-        marker_edges_transform.pose.orientation.z = 0.0;
-        marker_edges_transform.pose.orientation.w = 1.0;
-        marker_edges_transform.scale.x = 0.0033;
-        marker_edges_transform.scale.y = 0.01;
-        marker_edges_transform.scale.z = 0.01;
-        marker_edges_transform.color.a = 0.25;
-        marker_edges_transform.color.r = 1.0;
-        marker_edges_transform.color.g = 0.3;
-        marker_edges_transform.color.b = 0.2;
-        marker_edges_transform.points.resize(pose_graph->edges.size() * 2);
+    if (has_subnumber_edges2) {
+      MarkerType marker_edges_transform;
+      marker_edges_transform.header.frame_id = frame_id_;
+      marker_edges_transform.header.stamp = stamp;
+      marker_edges_transform.ns = "edges";
+      marker_edges_transform.id = 1;
+      marker_edges_transform.action = MarkerType::ADD;
+      marker_edges_transform.type = MarkerType::LINE_LIST;
+      marker_edges_transform.pose.position.x = 0;
+      marker_edges_transform.pose.position.y = 0;
+      marker_edges_transform.pose.position.z = 0;
+      marker_edges_transform.pose.orientation.x = 0.0;
+      marker_edges_transform.pose.orientation.y = 0.0;
+      marker_edges_transform.pose.orientation.z = 0.0;
+      marker_edges_transform.pose.orientation.w = 1.0;
+      marker_edges_transform.scale.x = 0.0033;
+      marker_edges_transform.scale.y = 0.01;
+      marker_edges_transform.scale.z = 0.01;
+      marker_edges_transform.color.a = 0.25;
+      marker_edges_transform.color.r = 1.0;
+      marker_edges_transform.color.g = 0.3;
+      marker_edges_transform.color.b = 0.2;
+      marker_edges_transform.points.resize(pose_graph->edges.size() * 2);
 
-        for (uint32_t i = 0; i < pose_graph->edges.size(); i++) {
-          const cuvslam::Slam::PoseGraphEdge & edge = pose_graph->edges[i];
-          auto it_from = nodes_index.find(edge.node_from);
-          if (it_from == nodes_index.end()) {
-            continue;
-          }
+      for (uint32_t i = 0; i < pose_graph->edges.size(); i++) {
+        const cuvslam::Slam::PoseGraphEdge & edge = pose_graph->edges[i];
+        auto it_from = nodes_index.find(edge.node_from);
+        if (it_from == nodes_index.end()) {
+          continue;
+        }
 
-          const cuvslam::Pose & node_from = pose_graph->nodes[it_from->second].node_pose;
-          const tf2::Transform ros_from{ChangeBasis(
-            canonical_pose_cuvslam_,
-            FromcuVSLAMPose(node_from))};
-          tf2::Vector3 zero(0, 0, 0);
-          tf2::Vector3 p1 = ros_from * zero;
+        const cuvslam::Pose & node_from = pose_graph->nodes[it_from->second].node_pose;
+        const tf2::Transform ros_from{ChangeBasis(
+          canonical_pose_cuvslam_,
+          FromcuVSLAMPose(node_from))};
+        tf2::Vector3 zero(0, 0, 0);
+        tf2::Vector3 p1 = ros_from * zero;
 
-          geometry_msgs::msg::Point pp1;
-          pp1.x = p1[0];
-          pp1.y = p1[1];
-          pp1.z = p1[2];
+        geometry_msgs::msg::Point pp1;
+        pp1.x = p1[0];
+        pp1.y = p1[1];
+        pp1.z = p1[2];
 
-          const tf2::Transform ros_transform{ChangeBasis(
-            canonical_pose_cuvslam_,
-            FromcuVSLAMPose(edge.transform))};
-          tf2::Vector3 p3 = ros_transform * zero;
-          p3 = ros_from * p3;
-          geometry_msgs::msg::Point pp3;
-          pp3.x = p3[0];
-          pp3.y = p3[1];
-          pp3.z = p3[2];
+        const tf2::Transform ros_transform{ChangeBasis(
+          canonical_pose_cuvslam_,
+          FromcuVSLAMPose(edge.transform))};
+        tf2::Vector3 p3 = ros_transform * zero;
+        p3 = ros_from * p3;
+        geometry_msgs::msg::Point pp3;
+        pp3.x = p3[0];
+        pp3.y = p3[1];
+        pp3.z = p3[2];
 
-          marker_edges_transform.points[i * 2 + 0] = pp1;
-          marker_edges_transform.points[i * 2 + 1] = pp3;
-        }
-        // publishing
-        publisher_edges2_->publish(std::move(marker_edges_transform));
+        marker_edges_transform.points[i * 2 + 0] = pp1;
+        marker_edges_transform.points[i * 2 + 1] = pp3;
       }
-    } catch (const std::exception & e) {
-      RCLCPP_WARN(logger_, "PoseGraphVisHelper has failed to run: %s", e.what());
+      // publishing
+      publisher_edges2_->publish(std::move(marker_edges_transform));
     }
+  } catch (const std::exception & e) {
+    RCLCPP_WARN(logger_, "PoseGraphVisHelper has failed to run: %s", e.what());
   }
 }
 
@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/rig_cache.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+constexpr char kMagic[8] = {'V', 'S', 'L', 'A', 'M', 'R', 'I', 'G'};
+constexpr uint32_t kVersion = 1;
+
+// FNV-1a, stable across processes unlike std::hash.
+class Hasher
+{
+public:
+  void Add(const void * data, size_t size)
+  {
+    const auto * bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash_ = (hash_ ^ bytes[i]) * 1099511628211ULL;
+    }
+  }
+  template<class T>
+  void Add(const T & value) {Add(&value, sizeof(value));}
+  void Add(const std::string & value)
+  {
+    Add(value.size());
+    Add(value.data(), value.size());
+  }
+  template<class T>
+  void AddArray(const T & values)
+  {
+    Add(values.size());
+    Add(values.data(), values.size() * sizeof(values[0]));
+  }
+
+  uint64_t Get() const {return hash_;}
+
+private:
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+class Writer
+{
+public:
+  explicit Writer(const std::string & path)
+  : stream_(path, std::ios::binary | std::ios::trunc) {}
+
+  bool Ok() const {return static_cast<bool>(stream_);}
+
+  template<class T>
+  void Write(const T & value)
+  {
+    stream_.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+  void Write(const void * data, size_t size)
+  {
+    Write<uint64_t>(size);
+    stream_.write(static_cast<const char *>(data), size);
+  }
+  void Write(const std::string & value) {Write(value.data(), value.size());}
+
+  template<class MessageT>
+  void WriteMessage(const MessageT & msg)
+  {
+    rclcpp::SerializedMessage serialized;
+    rclcpp::Serialization<MessageT>().serialize_message(&msg, &serialized);
+    const rcl_serialized_message_t & buffer = serialized.get_rcl_serialized_message();
+    Write(buffer.buffer, buffer.buffer_length);
+  }
+
+  void Close() {stream_.close();}
+
+private:
+  std::ofstream stream_;
+};
+
+class Reader
+{
+public:
+  explicit Reader(const std::string & path)
+  : stream_(path, std::ios::binary) {}
+
+  bool Ok() const {return static_cast<bool>(stream_);}
+
+  template<class T>
+  T Read()
+  {
+    T value{};
+    stream_.read(reinterpret_cast<char *>(&value), sizeof(value));
+    Check();
+    return value;
+  }
+  std::string ReadString()
+  {
+    std::string value(ReadSize(), '\0');
+    stream_.read(value.data(), value.size());
+    Check();
+    return value;
+  }
+
+  template<class MessageT>
+  std::shared_ptr<MessageT> ReadMessage()
+  {
+    const size_t size = ReadSize();
+    rclcpp::SerializedMessage serialized(size);
+    rcl_serialized_message_t & buffer = serialized.get_rcl_serialized_message();
+    stream_.read(reinterpret_cast<char *>(buffer.buffer), size);
+    Check();
+    buffer.buffer_length = size;
+    auto msg = std::make_shared<MessageT>();
+    rclcpp::Serialization<MessageT>().deserialize_message(&serialized, msg.get());
+    return msg;
+  }
+
+private:
+  // Sizes are bounded, so that a corrupt file does not allocate arbitrary amounts of memory.
+  size_t ReadSize()
+  {
+    constexpr uint64_t kMaxSize = 1 << 20;
+    const uint64_t size = Read<uint64_t>();
+    if (size > kMaxSize) {
+      throw std::runtime_error("corrupt rig cache");
+    }
+    return size;
+  }
+
+  void Check()
+  {
+    if (!stream_) {
+      throw std::runtime_error("truncated rig cache");
+    }
+  }
+
+  std::ifstream stream_;
+};
+
+}  // namespace
+
+RigCache::RigCache(const std::string & directory, const std::vector<std::string> & config)
+{
+  Hasher hasher;
+  for (const std::string & part : config) {
+    hasher.Add(part);
+  }
+  config_hash_ = hasher.Get();
+  char file_name[32];
+  std::snprintf(file_name, sizeof(file_name), "rig_%016" PRIx64 ".bin", config_hash_);
+  path_ = (std::filesystem::path(directory) / file_name).string();
+}
+
+bool RigCache::Exists() const
+{
+  std::error_code error;
+  return std::filesystem::exists(path_, error);
+}
+
+RigCache::Contents RigCache::Load() const
+{
+  Reader reader(path_);
+  if (!reader.Ok()) {
+    throw std::runtime_error("could not open " + path_);
+  }
+  const auto magic = reader.Read<std::array<char, sizeof(kMagic)>>();
+  if (std::memcmp(magic.data(), kMagic, sizeof(kMagic)) != 0 ||
+    reader.Read<uint32_t>() != kVersion || reader.Read<uint64_t>() != config_hash_)
+  {
+    throw std::runtime_error(path_ + " was written by a different version or configuration");
+  }
+
+  Contents contents;
+  const uint32_t num_cameras = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_cameras; i++) {
+    const int32_t index = reader.Read<int32_t>();
+    contents.camera_infos[index] = reader.ReadMessage<CameraInfoType>();
+  }
+  if (reader.Read<uint8_t>() != 0) {
+    contents.imu = reader.ReadMessage<ImuType>();
+  }
+  const uint32_t num_transforms = reader.Read<uint32_t>();
+  for (uint32_t i = 0; i < num_transforms; i++) {
+    std::string target = reader.ReadString();
+    std::string source = reader.ReadString();
+    const auto values = reader.Read<std::array<double, 7>>();
+    contents.transforms[{std::move(target), std::move(source)}] = tf2::Transform(
+      tf2::Quaternion(values[3], values[4], values[5], values[6]),
+      tf2::Vector3(values[0], values[1], values[2]));
+  }
+  return contents;
+}
+
+void RigCache::Save(const Contents & contents) const
+{
+  // Written next to the cache and renamed, so that readers never see a partial file.
+  const std::string temporary_path = path_ + ".tmp";
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(path_).parent_path(), error);
+  Writer writer(temporary_path);
+  if (!writer.Ok()) {
+    throw std::runtime_error("could not create " + temporary_path);
+  }
+  writer.Write(kMagic);
+  writer.Write(kVersion);
+  writer.Write(config_hash_);
+  writer.Write(static_cast<uint32_t>(contents.camera_infos.size()));
+  for (const auto & [index, camera_info] : contents.camera_infos) {
+    writer.Write(static_cast<int32_t>(index));
+    writer.WriteMessage(*camera_info);
+  }
+  writer.Write(static_cast<uint8_t>(contents.imu != nullptr));
+  if (contents.imu) {
+    writer.WriteMessage(*contents.imu);
+  }
+  writer.Write(static_cast<uint32_t>(contents.transforms.size()));
+  for (const auto & [frames, transform] : contents.transforms) {
+    writer.Write(frames.first);
+    writer.Write(frames.second);
+    const tf2::Vector3 & origin = transform.getOrigin();
+    const tf2::Quaternion rotation = transform.getRotation();
+    writer.Write(
+      std::array<double, 7>{origin.x(), origin.y(), origin.z(), rotation.x(), rotation.y(),
+        rotation.z(), rotation.w()});
+  }
+  writer.Close();
+  if (!writer.Ok()) {
+    throw std::runtime_error("could not write " + temporary_path);
+  }
+  std::filesystem::rename(temporary_path, path_, error);
+  if (error) {
+    throw std::runtime_error("could not rename " + temporary_path + ": " + error.message());
+  }
+}
+
+void RigCache::Remove() const
+{
+  std::error_code error;
+  std::filesystem::remove(path_, error);
+}
+
+uint64_t RigCache::HashCameraInfo(const CameraInfoType & msg)
+{
+  Hasher hasher;
+  hasher.Add(msg.header.frame_id);
+  hasher.Add(msg.width);
+  hasher.Add(msg.height);
+  hasher.Add(msg.distortion_model);
+  hasher.AddArray(msg.d);
+  hasher.AddArray(msg.k);
+  hasher.AddArray(msg.r);
+  hasher.AddArray(msg.p);
+  hasher.Add(msg.roi.x_offset);
+  hasher.Add(msg.roi.y_offset);
+  hasher.Add(msg.roi.width);
+  hasher.Add(msg.roi.height);
+  return hasher.Get();
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
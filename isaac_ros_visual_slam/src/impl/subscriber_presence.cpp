@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <memory>
+
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+SubscriberPresence::SubscriberPresence(
+  rclcpp::Node & node, std::chrono::milliseconds refresh_period)
+: node_(node), refresh_period_(refresh_period)
+{
+  thread_ = std::thread{&SubscriberPresence::Run, this};
+}
+
+SubscriberPresence::~SubscriberPresence()
+{
+  stop_ = true;
+  // Wakes up the thread, it waits for graph changes.
+  node_.get_node_graph_interface()->notify_graph_change();
+  thread_.join();
+}
+
+const std::atomic<bool> * SubscriberPresence::Track(
+  const std::shared_ptr<rclcpp::PublisherBase> & publisher)
+{
+  if (!publisher) {
+    return &no_subscribers_;
+  }
+  return &GetEntry(publisher).has_subscribers;
+}
+
+const std::atomic<bool> * SubscriberPresence::TrackIntraProcess(
+  const std::shared_ptr<rclcpp::PublisherBase> & publisher)
+{
+  if (!publisher) {
+    return &no_subscribers_;
+  }
+  return &GetEntry(publisher).has_intra_process_subscribers;
+}
+
+SubscriberPresence::Entry & SubscriberPresence::GetEntry(
+  const std::shared_ptr<rclcpp::PublisherBase> & publisher)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Entry & entry : entries_) {
+    if (entry.publisher == publisher) {
+      return entry;
+    }
+  }
+  Entry & entry = entries_.emplace_back();
+  entry.publisher = publisher;
+  Count(entry);
+  return entry;
+}
+
+void SubscriberPresence::Count(Entry & entry)
+{
+  try {
+    const size_t num_intra_process_subscribers =
+      entry.publisher->get_intra_process_subscription_count();
+    const size_t num_subscribers =
+      entry.publisher->get_subscription_count() + num_intra_process_subscribers;
+    entry.has_subscribers.store(num_subscribers != 0, std::memory_order_relaxed);
+    entry.has_intra_process_subscribers.store(
+      num_intra_process_subscribers != 0, std::memory_order_relaxed);
+  } catch (...) {
+    rcutils_reset_error();
+    RCLCPP_DEBUG(
+      rclcpp::get_logger("SubscriberPresence"), "Exception while counting subscribers");
+    entry.has_subscribers.store(false, std::memory_order_relaxed);
+    entry.has_intra_process_subscribers.store(false, std::memory_order_relaxed);
+  }
+}
+
+void SubscriberPresence::Refresh()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (Entry & entry : entries_) {
+    Count(entry);
+  }
+}
+
+void SubscriberPresence::Run()
+{
+  const rclcpp::Event::SharedPtr graph_event = node_.get_graph_event();
+  while (!stop_ && rclcpp::ok()) {
+    Refresh();
+    try {
+      node_.wait_for_graph_change(graph_event, refresh_period_);
+    } catch (const std::exception & e) {
+      RCLCPP_WARN(node_.get_logger(), "Waiting for graph changes has failed: %s", e.what());
+      std::this_thread::sleep_for(refresh_period_);
+    }
+    graph_event->check_and_clear();
+  }
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+#include "isaac_ros_visual_slam/impl/sync_tuner.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+// Weight of a new sample in the running means, and the rate at which peaks decay to the mean.
+constexpr double kAlpha = 1.0 / 64;
+constexpr double kPeakDecay = 1.0 / 512;
+
+// Number of samples a running statistic needs before it is trusted.
+constexpr uint64_t kMinNumSamples = 32;
+
+// Number of images between two retunes.
+constexpr uint64_t kRetunePeriod = 300;
+
+// The matching threshold is this factor above the skew, and never reaches half a period, where
+// images of neighbouring frames would be matched.
+constexpr double kSkewMargin = 1.5;
+constexpr double kMaxThresholdOfPeriod = 0.45;
+
+// Deviations added to the means to cover the tail of their distributions.
+constexpr double kNumDeviations = 4.0;
+
+// Frame sets that may be in flight in addition to the ones covered by the wait.
+constexpr size_t kBufferMargin = 2;
+
+// Relative change of the matching threshold that is applied. Smaller changes are not worth
+// rebuilding the synchronizer.
+constexpr double kThresholdHysteresis = 0.25;
+
+constexpr double kNsToMs = 1e-6;
+
+}  // namespace
+
+void SyncTuner::RunningStatistic::Add(double value)
+{
+  if (count == 0) {
+    mean = value;
+    peak = value;
+  } else {
+    deviation += kAlpha * (std::abs(value - mean) - deviation);
+    mean += kAlpha * (value - mean);
+    peak = std::max(value, peak + kPeakDecay * (mean - peak));
+  }
+  count++;
+}
+
+SyncTuner::SyncTuner(
+  size_t num_streams, const Config & config, const Config & min, const Config & max)
+: min_(min), max_(max), streams_(num_streams), config_(config) {}
+
+void SyncTuner::AddImage(int index, int64_t timestamp)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index < 0 || static_cast<size_t>(index) >= streams_.size()) {
+    return;
+  }
+  Stream & stream = streams_[index];
+  if (stream.last_timestamp >= 0 && timestamp > stream.last_timestamp) {
+    const double period = static_cast<double>(timestamp - stream.last_timestamp);
+    // A gap of dropped frames is not a period.
+    if (stream.period.count < kMinNumSamples || period < 1.5 * stream.period.mean) {
+      stream.period.Add(period);
+    }
+  }
+  stream.last_timestamp = timestamp;
+  num_images_since_retune_++;
+
+  // Skew to the frame of every other stream that is closest to this image: either its latest
+  // image, or the next one it is expected to deliver.
+  double skew = -1.0;
+  for (size_t i = 0; i < streams_.size(); i++) {
+    // The expected next image is only known once the period is.
+    const Stream & other = streams_[i];
+    if (i == static_cast<size_t>(index) || other.period.count < kMinNumSamples) {
+      continue;
+    }
+    const double offset = std::min(
+      std::abs(static_cast<double>(timestamp - other.last_timestamp)),
+      std::abs(other.last_timestamp + other.period.mean - timestamp));
+    // The other stream dropped the frame.
+    if (offset > 0.5 * other.period.mean) {
+      continue;
+    }
+    skew = std::max(skew, offset);
+  }
+  if (skew >= 0.0) {
+    skew_.Add(skew);
+  }
+}
+
+void SyncTuner::AddSyncWait(int64_t sync_wait_ns)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  sync_wait_.Add(static_cast<double>(sync_wait_ns));
+}
+
+SyncTuner::Config SyncTuner::Recommend() const
+{
+  double min_period = std::numeric_limits<double>::infinity();
+  double max_jitter = 0.0;
+  for (const Stream & stream : streams_) {
+    if (stream.period.count >= kMinNumSamples) {
+      min_period = std::min(min_period, stream.period.mean);
+      max_jitter = std::max(max_jitter, stream.period.deviation);
+    }
+  }
+
+  double threshold =
+    kSkewMargin * std::max(skew_.peak, skew_.mean + kNumDeviations * skew_.deviation);
+  if (std::isfinite(min_period)) {
+    threshold = std::min(threshold, kMaxThresholdOfPeriod * min_period);
+  }
+
+  Config config = config_;
+  config.matching_threshold_ns = std::clamp(
+    static_cast<int64_t>(threshold), min_.matching_threshold_ns, max_.matching_threshold_ns);
+  if (std::isfinite(min_period) && sync_wait_.count >= kMinNumSamples) {
+    const double wait = sync_wait_.peak + kNumDeviations * max_jitter;
+    config.buffer_size = std::clamp(
+      static_cast<size_t>(std::ceil(wait / min_period)) + kBufferMargin,
+      min_.buffer_size, max_.buffer_size);
+  }
+  return config;
+}
+
+bool SyncTuner::Retune(Config & config)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (num_images_since_retune_ < kRetunePeriod || skew_.count < kMinNumSamples) {
+    return false;
+  }
+  num_images_since_retune_ = 0;
+
+  const Config recommended = Recommend();
+  const bool threshold_changed =
+    std::abs(recommended.matching_threshold_ns - config_.matching_threshold_ns) >
+    kThresholdHysteresis * config_.matching_threshold_ns;
+  // Growing the buffer by one is applied right away, it avoids dropped frame sets. Shrinking only
+  // pays off for larger steps.
+  const bool buffer_changed = recommended.buffer_size > config_.buffer_size ||
+    recommended.buffer_size + kBufferMargin <= config_.buffer_size;
+  if (!threshold_changed && !buffer_changed) {
+    return false;
+  }
+  config_ = recommended;
+  num_retunes_++;
+  config = config_;
+  return true;
+}
+
+SyncTuner::Statistics SyncTuner::GetStatistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Statistics statistics{};
+  statistics.config = config_;
+  for (const Stream & stream : streams_) {
+    statistics.max_period_ms = std::max(statistics.max_period_ms, stream.period.mean * kNsToMs);
+    statistics.max_jitter_ms =
+      std::max(statistics.max_jitter_ms, stream.period.deviation * kNsToMs);
+  }
+  statistics.skew_ms = skew_.mean * kNsToMs;
+  statistics.skew_peak_ms = skew_.peak * kNsToMs;
+  statistics.sync_wait_peak_ms = sync_wait_.peak * kNsToMs;
+  statistics.num_retunes = num_retunes_;
+  return statistics;
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
+#include "isaac_ros_visual_slam/impl/synthetic_tracking_backend.hpp"
+#include "tf2/LinearMath/Quaternion.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+SyntheticTrackingBackend::SyntheticTrackingBackend(const Config & config)
+: config_(config)
+{
+}
+
+void SyntheticTrackingBackend::RegisterImuMeasurement(
+  const cuvslam::ImuMeasurement & imu_measurement)
+{
+  (void)imu_measurement;
+}
+
+cuvslam::PoseEstimate SyntheticTrackingBackend::Track(
+  const std::vector<cuvslam::Image> & images,
+  const std::vector<cuvslam::Image> & masks,
+  const std::vector<cuvslam::Image> & depth_images)
+{
+  (void)masks;
+  (void)depth_images;
+  if (images.empty()) {
+    throw std::invalid_argument("No images to track");
+  }
+  int64_t timestamp_ns = images.front().timestamp_ns;
+  for (const cuvslam::Image & image : images) {
+    timestamp_ns = std::max(timestamp_ns, image.timestamp_ns);
+  }
+  if (first_timestamp_ns_ < 0) {
+    first_timestamp_ns_ = timestamp_ns;
+  }
+  const tf2::Transform odom_pose_rig = GetScriptedPose((timestamp_ns - first_timestamp_ns_) / 1e9);
+
+  std::this_thread::sleep_for(config_.track_cost);
+
+  {
+    std::lock_guard<std::mutex> lock(slam_mutex_);
+    last_timestamp_ns_ = timestamp_ns;
+    odom_pose_rig_ = odom_pose_rig;
+  }
+
+  cuvslam::PoseEstimate pose_estimate;
+  pose_estimate.world_from_rig.emplace();
+  pose_estimate.world_from_rig->pose = TocuVSLAMPose(odom_pose_rig);
+  return pose_estimate;
+}
+
+std::optional<cuvslam::Odometry::Gravity> SyntheticTrackingBackend::GetLastGravity()
+{
+  return std::nullopt;
+}
+
+cuvslam::Pose SyntheticTrackingBackend::TrackSlam()
+{
+  std::this_thread::sleep_for(config_.slam_cost);
+
+  std::lock_guard<std::mutex> lock(slam_mutex_);
+  cuvslam::PoseStamped slam_pose;
+  slam_pose.timestamp_ns = last_timestamp_ns_;
+  slam_pose.pose = TocuVSLAMPose(map_pose_odom_ * odom_pose_rig_);
+  slam_poses_.push_back(slam_pose);
+  if (slam_poses_.size() > max_slam_poses_) {
+    slam_poses_.pop_front();
+  }
+  return slam_pose.pose;
+}
+
+void SyntheticTrackingBackend::SaveMap(
+  const std::string & map_folder_path, SaveMapCallback callback)
+{
+  (void)map_folder_path;
+  callback(false);
+}
+
+void SyntheticTrackingBackend::LocalizeInMap(
+  const std::string & map_folder_path, const cuvslam::Pose & pose_hint,
+  const cuvslam::Slam::LocalizationSettings & localization_settings,
+  LocalizeInMapCallback callback)
+{
+  (void)map_folder_path;
+  (void)pose_hint;
+  (void)localization_settings;
+  cuvslam::Result<cuvslam::Pose> result;
+  result.error_message = "The synthetic tracking backend does not support maps";
+  callback(result);
+}
+
+void SyntheticTrackingBackend::GetAllSlamPoses(
+  std::vector<cuvslam::PoseStamped> & poses, uint32_t max_count)
+{
+  std::lock_guard<std::mutex> lock(slam_mutex_);
+  const size_t count = std::min<size_t>(max_count, slam_poses_.size());
+  poses.assign(slam_poses_.end() - count, slam_poses_.end());
+}
+
+void SyntheticTrackingBackend::SetSlamPose(const cuvslam::Pose & pose)
+{
+  std::lock_guard<std::mutex> lock(slam_mutex_);
+  map_pose_odom_ = FromcuVSLAMPose(pose) * odom_pose_rig_.inverse();
+}
+
+void SyntheticTrackingBackend::Reset(bool clear_map)
+{
+  std::lock_guard<std::mutex> lock(slam_mutex_);
+  if (clear_map) {
+    map_pose_odom_ = tf2::Transform::getIdentity();
+    slam_poses_.clear();
+  } else {
+    // The trajectory restarts at the odometry origin, slam continues where the rig was.
+    map_pose_odom_ = map_pose_odom_ * odom_pose_rig_;
+  }
+  odom_pose_rig_ = tf2::Transform::getIdentity();
+  first_timestamp_ns_ = -1;
+}
+
+tf2::Transform SyntheticTrackingBackend::GetScriptedPose(double seconds) const
+{
+  const double v = config_.linear_velocity;
+  const double w = config_.angular_velocity;
+  const double yaw = w * seconds;
+  tf2::Vector3 position(v * seconds, 0, 0);
+  if (std::abs(w) > 1e-9) {
+    position = tf2::Vector3(v / w * std::sin(yaw), v / w * (1 - std::cos(yaw)), 0);
+  }
+  tf2::Quaternion orientation;
+  orientation.setRPY(0, 0, yaw);
+  // The script is defined in ROS conventions.
+  return ChangeBasis(cuvslam_pose_canonical, tf2::Transform(orientation, position));
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "isaac_ros_visual_slam/impl/tf_throttle.hpp"
+
+#include "isaac_ros_visual_slam/impl/sensor_time.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+TfThrottle::TfThrottle(const Options & options)
+: map_to_odom_keep_alive_ns_(static_cast<int64_t>(options.map_to_odom_keep_alive_ms * 1e6)),
+  map_to_odom_translation_threshold_(options.map_to_odom_translation_threshold),
+  map_to_odom_rotation_threshold_(options.map_to_odom_rotation_threshold),
+  odom_to_base_period_ns_(
+    options.odom_to_base_max_rate > 0 ?
+    static_cast<int64_t>(1e9 / options.odom_to_base_max_rate) : 0)
+{
+}
+
+bool TfThrottle::ShouldPublishMapToOdom(int64_t timestamp, const tf2::Transform & map_pose_odom)
+{
+  const bool publish = !map_pose_odom_ ||
+    IsPeriodElapsed(timestamp, map_to_odom_publish_ts_, map_to_odom_keep_alive_ns_) ||
+    map_pose_odom.getOrigin().distance(map_pose_odom_->getOrigin()) >
+    map_to_odom_translation_threshold_ ||
+    map_pose_odom.getRotation().angleShortestPath(map_pose_odom_->getRotation()) >
+    map_to_odom_rotation_threshold_;
+  if (publish) {
+    map_pose_odom_ = map_pose_odom;
+    map_to_odom_publish_ts_ = timestamp;
+  }
+  return publish;
+}
+
+bool TfThrottle::ShouldPublishOdomToBase(int64_t timestamp)
+{
+  if (!IsPeriodElapsed(timestamp, odom_to_base_publish_ts_, odom_to_base_period_ns_)) {
+    return false;
+  }
+  odom_to_base_publish_ts_ = timestamp;
+  return true;
+}
+
+void TfThrottle::Reset()
+{
+  map_pose_odom_.reset();
+  map_to_odom_publish_ts_.reset();
+  odom_to_base_publish_ts_.reset();
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
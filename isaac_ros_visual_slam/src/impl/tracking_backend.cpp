@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "isaac_ros_visual_slam/impl/tracking_backend.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+CuvslamTrackingBackend::CuvslamTrackingBackend(
+  std::unique_ptr<cuvslam::Odometry> odometry, std::shared_ptr<cuvslam::Slam> slam,
+  const cuvslam::Rig & rig, const cuvslam::Odometry::Config & odometry_config,
+  const cuvslam::Slam::Config & slam_config)
+: rig_(rig),
+  odometry_config_(odometry_config),
+  slam_config_(slam_config),
+  odometry_(std::move(odometry)),
+  slam_(std::move(slam))
+{
+}
+
+void CuvslamTrackingBackend::RegisterImuMeasurement(
+  const cuvslam::ImuMeasurement & imu_measurement)
+{
+  odometry_->RegisterImuMeasurement(0, imu_measurement);
+}
+
+cuvslam::PoseEstimate CuvslamTrackingBackend::Track(
+  const std::vector<cuvslam::Image> & images,
+  const std::vector<cuvslam::Image> & masks,
+  const std::vector<cuvslam::Image> & depth_images)
+{
+  return odometry_->Track(images, masks, depth_images);
+}
+
+std::optional<cuvslam::Odometry::Gravity> CuvslamTrackingBackend::GetLastGravity()
+{
+  return odometry_->GetLastGravity();
+}
+
+cuvslam::Pose CuvslamTrackingBackend::TrackSlam()
+{
+  cuvslam::Slam & slam = CheckedSlam();
+  odometry_->GetState(odometry_state_);
+  last_slam_pose_ = slam.Track(odometry_state_);
+  return *last_slam_pose_;
+}
+
+void CuvslamTrackingBackend::SaveMap(
+  const std::string & map_folder_path, SaveMapCallback callback)
+{
+  CheckedSlam().SaveMap(map_folder_path, std::move(callback));
+}
+
+void CuvslamTrackingBackend::LocalizeInMap(
+  const std::string & map_folder_path, const cuvslam::Pose & pose_hint,
+  const cuvslam::Slam::LocalizationSettings & localization_settings,
+  LocalizeInMapCallback callback)
+{
+  // For async localization, we don't need to provide images immediately
+  // The localization will use images from normal tracking operations
+  const std::vector<cuvslam::Image> empty_images;
+  CheckedSlam().LocalizeInMap(
+    map_folder_path, pose_hint, empty_images, localization_settings, std::move(callback));
+}
+
+void CuvslamTrackingBackend::GetAllSlamPoses(
+  std::vector<cuvslam::PoseStamped> & poses, uint32_t max_count)
+{
+  CheckedSlam().GetAllSlamPoses(poses, max_count);
+}
+
+void CuvslamTrackingBackend::SetSlamPose(const cuvslam::Pose & pose)
+{
+  CheckedSlam().SetSlamPose(pose);
+}
+
+void CuvslamTrackingBackend::Reset(bool clear_map)
+{
+  // Release the old tracker first, so that its GPU memory can be reused by the new one.
+  odometry_.reset();
+  odometry_ = std::make_unique<cuvslam::Odometry>(rig_, odometry_config_);
+  if (slam_ && clear_map) {
+    slam_.reset();
+    slam_ = std::make_shared<cuvslam::Slam>(rig_, odometry_->GetPrimaryCameras(), slam_config_);
+    last_slam_pose_.reset();
+  }
+  // Slam continues from where the rig was, the restarted odometry is only a new origin.
+  if (slam_ && last_slam_pose_) {
+    slam_->SetSlamPose(*last_slam_pose_);
+  }
+}
+
+cuvslam::Slam & CuvslamTrackingBackend::CheckedSlam() const
+{
+  if (!slam_) {
+    throw std::runtime_error("cuVSLAM slam is not enabled");
+  }
+  return *slam_;
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,268 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "isaac_ros_visual_slam/impl/vis_scheduler.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+// Heap order of the ready tasks: lower priority values first, then earlier deadlines.
+template<class ReadyTask>
+bool RunsAfter(const ReadyTask & a, const ReadyTask & b)
+{
+  if (a.priority != b.priority) {
+    return a.priority > b.priority;
+  }
+  return a.due_tick > b.due_tick;
+}
+
+}  // namespace
+
+VisScheduler::VisScheduler(const Options & options, const rclcpp::Logger & logger)
+: options_(options), logger_(logger), start_time_(std::chrono::steady_clock::now()),
+  wheel_(kNumSlots)
+{
+}
+
+VisScheduler::~VisScheduler()
+{
+  Stop();
+}
+
+VisScheduler::TaskId VisScheduler::Add(
+  std::function<void()> task, std::chrono::milliseconds period, int priority)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!running_) {
+    running_ = true;
+    timer_thread_ = std::thread{&VisScheduler::RunTimer, this};
+    for (size_t i = 0; i < std::max<size_t>(options_.num_workers, 1); i++) {
+      worker_threads_.emplace_back(&VisScheduler::RunWorker, this);
+    }
+  }
+  const TaskId id = next_id_++;
+  const uint64_t period_ticks =
+    std::max<int64_t>((period.count() + kTickMs - 1) / kTickMs, 1);
+  Task & added = tasks_[id];
+  added = Task{std::move(task), period_ticks, priority, 0, false, false};
+  Schedule(id, added);
+  return id;
+}
+
+void VisScheduler::Remove(TaskId id)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto it = tasks_.find(id);
+  if (it == tasks_.end()) {
+    return;
+  }
+  it->second.removed = true;
+  task_done_cond_var_.wait(lock, [this, id]() {return !tasks_.at(id).running;});
+  tasks_.erase(id);
+}
+
+void VisScheduler::Stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    stop_ = true;
+  }
+  timer_cond_var_.notify_all();
+  worker_cond_var_.notify_all();
+  timer_thread_.join();
+  for (std::thread & thread : worker_threads_) {
+    thread.join();
+  }
+  worker_threads_.clear();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  tasks_.clear();
+  ready_.clear();
+  for (std::vector<TaskId> & slot : wheel_) {
+    slot.clear();
+  }
+  timer_wakeup_tick_ = UINT64_MAX;
+  stop_ = false;
+  running_ = false;
+}
+
+uint64_t VisScheduler::NowTick() const
+{
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - start_time_);
+  return elapsed.count() / kTickMs;
+}
+
+void VisScheduler::Schedule(TaskId id, Task & task)
+{
+  // At least one tick ahead, the timer thread has already passed the current one.
+  task.due_tick = std::max(NowTick() + task.period_ticks, current_tick_);
+  wheel_[task.due_tick % kNumSlots].push_back(id);
+  if (task.due_tick < timer_wakeup_tick_) {
+    timer_wakeup_tick_ = task.due_tick;
+    timer_cond_var_.notify_one();
+  }
+}
+
+void VisScheduler::ConfigureThread()
+{
+  pthread_setname_np(pthread_self(), "vslam_vis");
+  if (!options_.cpu_affinity.empty()) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (const int64_t cpu : options_.cpu_affinity) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &cpus);
+      }
+    }
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (error != 0) {
+      RCLCPP_WARN(
+        logger_, "Could not set the CPU affinity of a visualization thread: %s",
+        std::strerror(error));
+    }
+  }
+  if (options_.idle_policy) {
+    sched_param param{};
+    param.sched_priority = 0;
+    const int error = pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+    if (error != 0) {
+      RCLCPP_WARN(
+        logger_, "Could not set SCHED_IDLE for a visualization thread: %s", std::strerror(error));
+    }
+  } else if (options_.nice != 0) {
+    // On Linux the nice value is an attribute of the thread.
+    const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, options_.nice) != 0) {
+      RCLCPP_WARN(
+        logger_, "Could not set the nice value of a visualization thread: %s",
+        std::strerror(errno));
+    }
+  }
+}
+
+void VisScheduler::RunTimer()
+{
+  ConfigureThread();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    // Collect the tasks of all ticks up to now. After a long sleep every slot is visited once.
+    const uint64_t now_tick = NowTick();
+    bool have_ready = false;
+    if (now_tick >= current_tick_) {
+      const uint64_t num_ticks = std::min<uint64_t>(now_tick - current_tick_ + 1, kNumSlots);
+      for (uint64_t tick = current_tick_; tick < current_tick_ + num_ticks; tick++) {
+        std::vector<TaskId> & slot = wheel_[tick % kNumSlots];
+        for (size_t i = 0; i < slot.size(); ) {
+          const auto it = tasks_.find(slot[i]);
+          const bool dropped = it == tasks_.end() || it->second.removed;
+          if (!dropped && it->second.due_tick > now_tick) {
+            // Due in a later round of the wheel.
+            i++;
+            continue;
+          }
+          if (!dropped) {
+            ready_.push_back({it->second.priority, it->second.due_tick, it->first});
+            std::push_heap(ready_.begin(), ready_.end(), RunsAfter<ReadyTask>);
+            have_ready = true;
+          }
+          slot[i] = slot.back();
+          slot.pop_back();
+        }
+      }
+      current_tick_ = now_tick + 1;
+    }
+    if (have_ready) {
+      worker_cond_var_.notify_all();
+    }
+
+    // Sleep until the next tick that has tasks.
+    timer_wakeup_tick_ = UINT64_MAX;
+    for (uint64_t i = 0; i < kNumSlots; i++) {
+      if (!wheel_[(current_tick_ + i) % kNumSlots].empty()) {
+        timer_wakeup_tick_ = current_tick_ + i;
+        break;
+      }
+    }
+    if (timer_wakeup_tick_ == UINT64_MAX) {
+      timer_cond_var_.wait(lock);
+    } else {
+      timer_cond_var_.wait_until(
+        lock, start_time_ + std::chrono::milliseconds(timer_wakeup_tick_ * kTickMs));
+    }
+  }
+}
+
+void VisScheduler::RunWorker()
+{
+  ConfigureThread();
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    worker_cond_var_.wait(lock, [this]() {return stop_ || !ready_.empty();});
+    if (stop_) {
+      break;
+    }
+    std::pop_heap(ready_.begin(), ready_.end(), RunsAfter<ReadyTask>);
+    const TaskId id = ready_.back().id;
+    ready_.pop_back();
+    const auto it = tasks_.find(id);
+    if (it == tasks_.end() || it->second.removed) {
+      continue;
+    }
+    // References into tasks_ stay valid, Remove() does not erase running tasks.
+    Task & task = it->second;
+    task.running = true;
+    lock.unlock();
+    try {
+      task.function();
+    } catch (const std::exception & e) {
+      RCLCPP_WARN(logger_, "Visualization task has failed: %s", e.what());
+    }
+    lock.lock();
+    task.running = false;
+    if (task.removed) {
+      task_done_cond_var_.notify_all();
+    } else {
+      // Rescheduled relative to the end of the run, so that slow tasks do not pile up.
+      Schedule(id, task);
+    }
+  }
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -16,18 +16,26 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <future>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <filesystem>
 
 #include "Eigen/Dense"
 #include "isaac_ros_nitros/types/type_utility.hpp"
+#include "isaac_ros_visual_slam/impl/allocation_counter.hpp"
 #include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
-#include "isaac_ros_visual_slam/impl/has_subscribers.hpp"
+#include "isaac_ros_visual_slam/impl/sensor_time.hpp"
 #include "isaac_ros_visual_slam/impl/stopwatch.hpp"
+#include "isaac_ros_visual_slam/impl/subscriber_presence.hpp"
+#include "isaac_ros_visual_slam/impl/synthetic_tracking_backend.hpp"
 #include "isaac_ros_visual_slam/impl/types.hpp"
 #include "isaac_ros_visual_slam/impl/visual_slam_impl.hpp"
 #include "tf2_geometry_msgs/tf2_geometry_msgs.hpp"
@@ -96,6 +104,130 @@ bool PoseToGround(
   return true;
 }
 
+// Names of the latency stages used in the diagnostics, indexed by LatencyStage.
+constexpr const char * kLatencyStageNames[] = {
+  "sync_wait",
+  "sequencer_wait",
+  "imu_registration",
+  "image_conversion",
+  "odometry_track",
+  "slam_track",
+  "tf_publish",
+  "message_publish",
+};
+
+// Percentiles reported for every latency stage and their suffixes in the diagnostics.
+constexpr std::array<double, 4> kLatencyQuantiles = {0.5, 0.9, 0.99, 0.999};
+constexpr const char * kLatencyQuantileNames[] = {"p50", "p90", "p99", "p99_9"};
+
+// Upper bound for the number of diagnostic values published per frame.
+constexpr size_t kMaxNumDiagnosticValues = 64;
+
+// Priorities of the visualization helpers in the VisScheduler. Lower values run first, so the
+// small pose layers are not delayed by the large landmark clouds.
+constexpr int kPoseVisPriority = 0;
+constexpr int kLoopClosureVisPriority = 1;
+constexpr int kLandmarksVisPriority = 2;
+
+// Lower bounds of the synchronizer settings learned with enable_adaptive_sync.
+constexpr int64_t kMinAdaptiveSyncThresholdNs = 500'000;
+constexpr size_t kMinAdaptiveSyncBufferSize = 2;
+
+// Number of masks and depth images kept per side channel.
+constexpr size_t kSideChannelDepth = 4;
+
+// Lower bound of the period in which the deadlines of the dropout synchronizer are checked.
+constexpr std::chrono::milliseconds kMinDropoutSyncTimerPeriod{1};
+
+// Period of the subscriber recount in addition to the recounts on graph changes.
+constexpr std::chrono::milliseconds kSubscriberRefreshPeriod{1000};
+
+// Sets the diagnostic value at the given index. Entries of the previous frame are overwritten in
+// place, so their strings keep their capacity.
+void SetDiagnosticValue(
+  diagnostic_msgs::msg::DiagnosticStatus & status, size_t index, const char * key,
+  const char * value)
+{
+  if (status.values.size() <= index) {
+    status.values.resize(index + 1);
+  }
+  status.values[index].key = key;
+  status.values[index].value = value;
+}
+
+// Same format as std::to_string, but without creating a temporary string.
+void SetDiagnosticValue(
+  diagnostic_msgs::msg::DiagnosticStatus & status, size_t index, const char * key, double value)
+{
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%f", value);
+  SetDiagnosticValue(status, index, key, buffer);
+}
+
+void SetDiagnosticValue(
+  diagnostic_msgs::msg::DiagnosticStatus & status, size_t index, const char * key,
+  uint64_t value)
+{
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%lu", static_cast<unsigned long>(value));  // NOLINT
+  SetDiagnosticValue(status, index, key, buffer);
+}
+
+void SetHeader(
+  std_msgs::msg::Header & header, const rclcpp::Time & stamp, const std::string & frame_id)
+{
+  header.stamp = stamp;
+  header.frame_id = frame_id;
+}
+
+// Publishes a per frame message with as few copies as the publisher allows. fill(msg) has to set
+// every field of msg, because msg may be freshly allocated.
+// - If the middleware can loan messages of this type, the message is filled in the loaned buffer.
+// - If there are intra-process subscribers, the message is filled into a new message that is
+//   moved to them, so that composed nodes receive it without a copy or serialization.
+// - Otherwise the message is filled into reused, which keeps its allocations across frames, and
+//   published by reference.
+template<class T, class Fill>
+void PublishFrameMessage(
+  rclcpp::Publisher<T> & publisher, const std::atomic<bool> * has_intra_process_subscribers,
+  T & reused, Fill fill)
+{
+  if (publisher.can_loan_messages()) {
+    auto loaned_msg = publisher.borrow_loaned_message();
+    fill(loaned_msg.get());
+    publisher.publish(std::move(loaned_msg));
+  } else if (nvidia::isaac_ros::visual_slam::HasSubscribers(has_intra_process_subscribers)) {
+    auto msg = std::make_unique<T>();
+    fill(*msg);
+    publisher.publish(std::move(msg));
+  } else {
+    fill(reused);
+    publisher.publish(reused);
+  }
+}
+
+// Returns true if all values of the IMU message used for tracking are finite.
+bool IsValidImuMessage(const nvidia::isaac_ros::visual_slam::ImuType & msg)
+{
+  const auto & a = msg.linear_acceleration;
+  const auto & w = msg.angular_velocity;
+  return std::isfinite(a.x) && std::isfinite(a.y) && std::isfinite(a.z) &&
+         std::isfinite(w.x) && std::isfinite(w.y) && std::isfinite(w.z);
+}
+
+// Returns the timestamp of the latest image. We assume that the vector is never empty.
+int64_t GetLatestTimeStamp(
+  const std::vector<std::pair<int, nvidia::isaac_ros::visual_slam::ImageType>> & idx_and_image_msgs)
+{
+  int64_t latest_ts = std::numeric_limits<int64_t>::min();
+  for (const auto & [idx, image_msg] : idx_and_image_msgs) {
+    latest_ts = std::max(
+      latest_ts, nvidia::isaac_ros::visual_slam::NitrosTimeStamp::value(image_msg.GetMessage())
+      .nanoseconds());
+  }
+  return latest_ts;
+}
+
 }  // namespace
 
 
@@ -108,35 +240,56 @@ namespace visual_slam
 
 VisualSlamNode::VisualSlamImpl::VisualSlamImpl(VisualSlamNode & vslam_node)
 : node(vslam_node),
-  sync(node.num_cameras_ + node.num_input_masks_ +
-    (node.tracking_mode_ == static_cast<int>(TrackingMode::RGBD) ? 1 : 0),
-    1e6 * node.sync_matching_threshold_ms_, node.min_num_images_ +
-    node.num_input_masks_ + (node.tracking_mode_ == static_cast<int>(TrackingMode::RGBD) ? 1 : 0),
-    node.image_buffer_size_),
+  sync_tuner(NumImageStreams(),
+    {static_cast<int64_t>(1e6 * node.sync_matching_threshold_ms_), node.image_buffer_size_},
+    {kMinAdaptiveSyncThresholdNs, kMinAdaptiveSyncBufferSize},
+    {static_cast<int64_t>(1e6 * node.adaptive_sync_max_matching_threshold_ms_),
+      node.adaptive_sync_max_buffer_size_}),
+  side_channels(node.num_input_masks_ + 1, kSideChannelDepth),
   sequencer(node.imu_buffer_size_, node.imu_jitter_threshold_ms_, node.image_buffer_size_,
     node.image_jitter_threshold_ms_),
   tf_buffer(std::make_unique<tf2_ros::Buffer>(node.get_clock())),
   tf_listener(std::make_unique<tf2_ros::TransformListener>(*tf_buffer)),
-  tf_publisher(std::make_unique<tf2_ros::TransformBroadcaster>(&node)),
+  tf_publisher(node.create_publisher<TFMessageType>("/tf", tf2_ros::DynamicBroadcasterQoS())),
   tf_static_publisher(std::make_unique<tf2_ros::StaticTransformBroadcaster>(&node)),
   vo_path(node.path_max_size_),
   slam_path(node.path_max_size_),
-  // observations_vis_helper(cuvslam::Slam::DataLayer::Observations, 2048,
-  //   LandmarksVisHelper::CM_RGB_MODE, 16),
-  landmarks_vis_helper(cuvslam::Slam::DataLayer::Map, 1024 * 32, LandmarksVisHelper::CM_BW_MODE,
-    100),
-  lc_landmarks_vis_helper(cuvslam::Slam::DataLayer::LoopClosure, 2048,
-    LandmarksVisHelper::CM_RED_MODE, 16),
-  pose_graph_helper(cuvslam::Slam::DataLayer::PoseGraph, 2048, 100),
-  localizer_helper(8 * 2048, 100),
-  localizer_landmarks_vis_helper(cuvslam::Slam::DataLayer::LocalizerMap, 1024 * 32,
-    LandmarksVisHelper::CM_GREEN_MODE, 16),
-  localizer_observations_vis_helper(cuvslam::Slam::DataLayer::LocalizerLandmarks, 1024 * 32,
+  subscriber_presence(node, kSubscriberRefreshPeriod),
+  vis_scheduler(
+    VisScheduler::Options{static_cast<size_t>(std::max(node.vis_num_threads_, 1)),
+      node.vis_cpu_affinity_, node.vis_thread_nice_, node.vis_idle_scheduling_},
+    node.get_logger()),
+  // observations_vis_helper(vis_scheduler, subscriber_presence, kLandmarksVisPriority,
+  //   cuvslam::Slam::DataLayer::Observations, 2048, LandmarksVisHelper::CM_RGB_MODE, 16),
+  landmarks_vis_helper(vis_scheduler, subscriber_presence, kLandmarksVisPriority,
+    cuvslam::Slam::DataLayer::Map, 1024 * 32, LandmarksVisHelper::CM_BW_MODE, 100),
+  lc_landmarks_vis_helper(vis_scheduler, subscriber_presence, kLoopClosureVisPriority,
+    cuvslam::Slam::DataLayer::LoopClosure, 2048, LandmarksVisHelper::CM_RED_MODE, 16),
+  pose_graph_helper(vis_scheduler, subscriber_presence, kPoseVisPriority,
+    cuvslam::Slam::DataLayer::PoseGraph, 2048, 100),
+  localizer_helper(vis_scheduler, subscriber_presence, kPoseVisPriority, 8 * 2048, 100),
+  localizer_landmarks_vis_helper(vis_scheduler, subscriber_presence, kLandmarksVisPriority,
+    cuvslam::Slam::DataLayer::LocalizerMap, 1024 * 32, LandmarksVisHelper::CM_GREEN_MODE, 16),
+  localizer_observations_vis_helper(vis_scheduler, subscriber_presence, kLandmarksVisPriority,
+    cuvslam::Slam::DataLayer::LocalizerLandmarks, 1024 * 32,
     LandmarksVisHelper::CM_WEIGHT_BW_MODE, 16),
-  localizer_lc_landmarks_vis_helper(cuvslam::Slam::DataLayer::LocalizerLoopClosure, 2048,
-    LandmarksVisHelper::CM_RED_MODE, 16),
+  localizer_lc_landmarks_vis_helper(vis_scheduler, subscriber_presence, kLoopClosureVisPriority,
+    cuvslam::Slam::DataLayer::LocalizerLoopClosure, 2048, LandmarksVisHelper::CM_RED_MODE, 16),
+  pose_cache(node.odometry_covariance_window_size_),
+  velocity_cache(node.odometry_covariance_window_size_),
+  pose_history(
+    node.pose_history_size_, static_cast<int64_t>(node.pose_history_max_extrapolation_ms_ * 1e6)),
+  imu_propagator(
+    node.imu_buffer_size_, static_cast<int64_t>(node.imu_propagation_max_time_ms_ * 1e6)),
   track_execution_times(100),
-  last_track_ts(-1)
+  image_arrival_times(node.image_buffer_size_ * (node.num_cameras_ + node.num_input_masks_ + 1)),
+  frame_set_arrival_times(node.image_buffer_size_),
+  tf_throttle(
+    {node.map_to_odom_tf_keep_alive_ms_, node.map_to_odom_tf_translation_threshold_,
+      node.map_to_odom_tf_rotation_threshold_, node.odom_to_base_tf_max_rate_}),
+  last_track_ts(-1),
+  tracking_queue(node.tracking_queue_size_),
+  output_queue(node.tracking_queue_size_)
 {
   cuvslam::SetVerbosity(node.verbosity_);
 
@@ -145,10 +298,85 @@ VisualSlamNode::VisualSlamImpl::VisualSlamImpl(VisualSlamNode & vslam_node)
       &VisualSlamNode::VisualSlamImpl::UpdatePose, this,
       std::placeholders::_1, std::placeholders::_2));
 
-  sync.RegisterCallback(
-    std::bind(
-      &VisualSlamNode::VisualSlamImpl::CallbackSynchronizedImages, this,
-      std::placeholders::_1, std::placeholders::_2));
+  CreateSynchronizer(
+    {static_cast<int64_t>(1e6 * node.sync_matching_threshold_ms_), node.image_buffer_size_});
+  if (node.enable_camera_dropout_handling_) {
+    // Runs in the same callback group as the image callbacks, so it never overlaps with them.
+    const auto period = std::max<std::chrono::nanoseconds>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double, std::milli>(node.camera_dropout_deadline_ms_) / 4),
+      kMinDropoutSyncTimerPeriod);
+    dropout_sync_timer = node.create_wall_timer(
+      period, [this]() {
+        if (IsInitialized()) {
+          dropout_sync->CheckDeadlines();
+        }
+      });
+  }
+
+  subscribed.vo_pose = subscriber_presence.Track(node.tracking_vo_pose_pub_);
+  subscribed.vo_pose_intra_process =
+    subscriber_presence.TrackIntraProcess(node.tracking_vo_pose_pub_);
+  subscribed.vo_pose_covariance = subscriber_presence.Track(node.tracking_vo_pose_covariance_pub_);
+  subscribed.vo_pose_covariance_intra_process =
+    subscriber_presence.TrackIntraProcess(node.tracking_vo_pose_covariance_pub_);
+  subscribed.odometry = subscriber_presence.Track(node.tracking_odometry_pub_);
+  subscribed.odometry_intra_process =
+    subscriber_presence.TrackIntraProcess(node.tracking_odometry_pub_);
+  subscribed.odometry_imu_rate = subscriber_presence.Track(node.tracking_odometry_imu_rate_pub_);
+  subscribed.odometry_imu_rate_intra_process =
+    subscriber_presence.TrackIntraProcess(node.tracking_odometry_imu_rate_pub_);
+  subscribed.vo_velocity = subscriber_presence.Track(node.vis_vo_velocity_pub_);
+  subscribed.slam_odometry = subscriber_presence.Track(node.vis_slam_odometry_pub_);
+  subscribed.slam_odometry_intra_process =
+    subscriber_presence.TrackIntraProcess(node.vis_slam_odometry_pub_);
+  subscribed.gravity = subscriber_presence.Track(node.vis_gravity_pub_);
+  subscribed.status = subscriber_presence.Track(node.visual_slam_status_pub_);
+  subscribed.status_intra_process =
+    subscriber_presence.TrackIntraProcess(node.visual_slam_status_pub_);
+  subscribed.diagnostics = subscriber_presence.Track(node.diagnostics_pub_);
+  vo_path_state.has_full_subscribers = subscriber_presence.Track(node.tracking_vo_path_pub_);
+  vo_path_state.has_delta_subscribers =
+    subscriber_presence.Track(node.tracking_vo_path_delta_pub_);
+  slam_path_state.has_full_subscribers = subscriber_presence.Track(node.tracking_slam_path_pub_);
+  slam_path_state.has_delta_subscribers =
+    subscriber_presence.Track(node.tracking_slam_path_delta_pub_);
+
+  // Size the per frame scratch state for the largest possible frame.
+  tracking_arena.images.reserve(node.num_cameras_);
+  tracking_arena.masks.reserve(node.num_cameras_);
+  tracking_arena.depth_images.reserve(1);
+  tracking_arena.mask_msgs.resize(node.num_cameras_, nullptr);
+  tracking_arena.side_channel_msgs.resize(node.num_input_masks_ + 1);
+  for (PathState * path_state : {&vo_path_state, &slam_path_state}) {
+    path_state->full_msg.poses.reserve(node.path_max_size_);
+    path_state->delta_msg.poses.reserve(1);
+  }
+  output_arena.diagnostics.status.resize(1);
+  output_arena.diagnostics.status[0].values.reserve(kMaxNumDiagnosticValues);
+
+  if (!node.rig_cache_directory_.empty()) {
+    // Everything the rig depends on besides the calibration messages themselves.
+    std::vector<std::string> rig_config{
+      node.get_fully_qualified_name(), std::to_string(node.num_cameras_),
+      std::to_string(node.tracking_mode_), std::to_string(node.rectified_images_),
+      node.base_frame_, node.imu_frame_};
+    rig_config.insert(
+      rig_config.end(), node.camera_optical_frames_.begin(), node.camera_optical_frames_.end());
+    rig_cache = std::make_unique<RigCache>(node.rig_cache_directory_, rig_config);
+  }
+
+  if (!node.shm_pose_ring_name_.empty()) {
+    try {
+      shm_pose_ring = std::make_unique<ShmPoseRingWriter>(
+        node.shm_pose_ring_name_, node.shm_pose_ring_size_);
+      RCLCPP_INFO(
+        node.get_logger(), "Writing poses to shared memory ring '%s'",
+        node.shm_pose_ring_name_.c_str());
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(node.get_logger(), "Failed to create shared memory pose ring: %s", e.what());
+    }
+  }
 }
 
 VisualSlamNode::VisualSlamImpl::~VisualSlamImpl()
@@ -159,7 +387,7 @@ VisualSlamNode::VisualSlamImpl::~VisualSlamImpl()
 // Flag to check the status of initialization.
 bool VisualSlamNode::VisualSlamImpl::IsInitialized() const
 {
-  return cuvslam_odometry != nullptr;
+  return tracking_backend != nullptr;
 }
 
 bool VisualSlamNode::VisualSlamImpl::IsReadyForInitialization() const
@@ -183,6 +411,11 @@ void VisualSlamNode::VisualSlamImpl::Initialize()
   }
 
   RCLCPP_INFO(node.get_logger(), "Initializing cuVSLAM.");
+  const auto initialize_start_time = std::chrono::steady_clock::now();
+  if (!startup_timeline.reported) {
+    startup_timeline.wait_for_inputs_ms = std::chrono::duration<double, std::milli>(
+      initialize_start_time - startup_timeline.start).count();
+  }
 
   if (node.enable_ground_constraint_in_odometry_) {
     ground_constraint = InitGroundConstraint(node.get_logger());
@@ -210,6 +443,31 @@ void VisualSlamNode::VisualSlamImpl::Initialize()
     }
   }
 
+  // Wait for all extrinsics at the same time, instead of one timeout after the other.
+  const auto extrinsics_start_time = std::chrono::steady_clock::now();
+  std::map<int, std::future<tf2::Transform>> base_link_pose_camera_optical_futures;
+  for (const auto & [idx, camera_info_msg] : initial_camera_info_messages) {
+    base_link_pose_camera_optical_futures[idx] =
+      GetExtrinsicAsync(base_frame, camera_optical_frames[idx]);
+  }
+  std::string imu_frame;
+  std::future<tf2::Transform> base_link_pose_imu_future;
+  std::future<tf2::Transform> imu_pose_imu_msg_future;
+  if (node.tracking_mode_ == static_cast<int>(TrackingMode::VIO)) {
+    imu_frame =
+      !node.imu_frame_.empty() ? node.imu_frame_ : initial_imu_message.value()->header.frame_id;
+    base_link_pose_imu_future = GetExtrinsicAsync(base_frame, imu_frame);
+    // The messages may be given in a different frame than the calibrated imu frame, for example
+    // if imu_frame is set.
+    const std::string & imu_msg_frame = initial_imu_message.value()->header.frame_id;
+    if (!imu_msg_frame.empty() && imu_msg_frame != imu_frame) {
+      imu_pose_imu_msg_future = GetExtrinsicAsync(imu_frame, imu_msg_frame);
+    }
+  }
+
+  // Everything the rig is built from, for the rig cache.
+  RigCache::Contents rig_cache_contents;
+
   // Setup camera extrinsics (and intrinsics).
   cuvslam::Rig cam_rig;
   cam_rig.cameras.resize(node.num_cameras_);
@@ -217,9 +475,11 @@ void VisualSlamNode::VisualSlamImpl::Initialize()
   for (const auto & [idx, camera_info_msg] : initial_camera_info_messages) {
     const rclcpp::Time stamp(camera_info_msg.value()->header.stamp);
     FillIntrinsics(camera_info_msg.value(), cam_rig.cameras[idx]);
-    const tf2::Transform base_link_pose_camera_optical = GetLatestTransform(
-      base_frame,
-      camera_optical_frames[idx]);
+    const tf2::Transform base_link_pose_camera_optical =
+      base_link_pose_camera_optical_futures.at(idx).get();
+    rig_cache_contents.camera_infos[idx] = camera_info_msg.value();
+    rig_cache_contents.transforms[{base_frame, camera_optical_frames[idx]}] =
+      base_link_pose_camera_optical;
     if (node.rectified_images_) {
       const tf2::Matrix3x3 rectification_matrix(
         camera_info_msg.value()->r[0], camera_info_msg.value()->r[1], camera_info_msg.value()->r[2],
@@ -280,13 +540,36 @@ void VisualSlamNode::VisualSlamImpl::Initialize()
   tf2::Transform cv_base_link_pose_cv_imu;
   cv_base_link_pose_cv_imu.setIdentity();
   if (node.tracking_mode_ == static_cast<int>(TrackingMode::VIO)) {
-    const std::string imu_frame =
-      !node.imu_frame_.empty() ? node.imu_frame_ : initial_imu_message.value()->header.frame_id;
-
     // Convert the base_pose_imu from ROS to cuVSLAM frame
     const rclcpp::Time stamp(initial_imu_message.value()->header.stamp);
-    cv_base_link_pose_cv_imu =
-      ChangeBasis(cuvslam_pose_canonical, GetLatestTransform(base_frame, imu_frame));
+    const tf2::Transform base_link_pose_imu = base_link_pose_imu_future.get();
+    rig_cache_contents.imu = initial_imu_message.value();
+    rig_cache_contents.transforms[{base_frame, imu_frame}] = base_link_pose_imu;
+
+    // The rotation of the messages into the imu frame is applied with the change of conventions.
+    const std::string & imu_msg_frame = initial_imu_message.value()->header.frame_id;
+    tf2::Matrix3x3 imu_rotation_msg = tf2::Matrix3x3::getIdentity();
+    if (imu_pose_imu_msg_future.valid()) {
+      try {
+        const tf2::Transform imu_pose_imu_msg = imu_pose_imu_msg_future.get();
+        rig_cache_contents.transforms[{imu_frame, imu_msg_frame}] = imu_pose_imu_msg;
+        imu_rotation_msg = imu_pose_imu_msg.getBasis();
+        RCLCPP_INFO(
+          node.get_logger(), "Rotating IMU measurements from frame '%s' into '%s'",
+          imu_msg_frame.c_str(), imu_frame.c_str());
+      } catch (const std::runtime_error &) {
+        // Often the frames only differ in name, e.g. when imu_frame is set to the calibrated
+        // frame of the same sensor. The transform is not cached, so that it is looked up again.
+        RCLCPP_WARN(
+          node.get_logger(),
+          "No transform from IMU message frame '%s' to '%s', using the measurements unrotated",
+          imu_msg_frame.c_str(), imu_frame.c_str());
+      }
+    }
+    imu_measurement_rotation = TocuVSLAMImuRotation(imu_rotation_msg);
+    imu_propagator.SetBasePoseImu(
+      tf2::Transform(base_link_pose_imu.getBasis() * imu_rotation_msg));
+    cv_base_link_pose_cv_imu = ChangeBasis(cuvslam_pose_canonical, base_link_pose_imu);
 
     cuvslam::ImuCalibration imu_calibration;
     imu_calibration.rig_from_imu = TocuVSLAMPose(cv_base_link_pose_cv_imu);
@@ -298,69 +581,40 @@ void VisualSlamNode::VisualSlamImpl::Initialize()
     cam_rig.imus.push_back(imu_calibration);
     PrintImuCalibration(node.get_logger(), imu_calibration);
   }
-
-  // Create cuvslam odometry tracker.
-  const cuvslam::Odometry::Config configuration = CreateOdometryConfiguration();
-  PrintConfiguration(node.get_logger(), configuration);
-
-  try {
-    Stopwatch stopwatch_tracker;
-    StopwatchScope ssw_tracker(stopwatch_tracker);
-    cuvslam_odometry = std::make_unique<cuvslam::Odometry>(cam_rig, configuration);
-    RCLCPP_INFO(node.get_logger(), "Time taken by cuvslam::Odometry::Odometry(): %f",
-            ssw_tracker.Stop());
-  } catch (const std::exception & e) {
-    RCLCPP_ERROR(node.get_logger(), "Failed to initialize cuvslam::Odometry: %s", e.what());
-    return;
+  if (!startup_timeline.reported) {
+    startup_timeline.extrinsics_ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - extrinsics_start_time).count();
   }
 
-  if (node.enable_localization_n_mapping_) {
-    try {
-      Stopwatch stopwatch_slam;
-      StopwatchScope ssw_slam(stopwatch_slam);
-      cuvslam_slam = std::make_shared<cuvslam::Slam>(cam_rig, cuvslam_odometry->GetPrimaryCameras(),
-              CreateSlamConfiguration());
-      RCLCPP_INFO(node.get_logger(), "Time taken by cuvslam::Slam::Slam(): %f",
-              ssw_slam.Stop());
-    } catch (const std::exception & e) {
-      RCLCPP_ERROR(node.get_logger(), "Failed to initialize cuvslam::Slam: %s", e.what());
-      return;
-    }
+  tracking_backend = CreateTrackingBackend(cam_rig);
+  if (!tracking_backend) {
+    return;
   }
 
   pose_cache.Reset();
   velocity_cache.Reset();
+  pose_history.Reset();
 
-  // Initialize visualization helpers.
-  if (node.enable_slam_visualization_) {
-    // observations_vis_helper.Init(
-    //   node.vis_observations_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-    //   node.get_logger());
-    landmarks_vis_helper.Init(
-      node.vis_landmarks_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
-    lc_landmarks_vis_helper.Init(
-      node.vis_loop_closure_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
-    pose_graph_helper.Init(
-      node.vis_posegraph_nodes_pub_, node.vis_posegraph_edges_pub_,
-      node.vis_posegraph_edges2_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
-    localizer_helper.Init(
-      node.vis_localizer_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
-    localizer_landmarks_vis_helper.Init(
-      node.vis_localizer_landmarks_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
-    localizer_observations_vis_helper.Init(
-      node.vis_localizer_observations_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
-    localizer_lc_landmarks_vis_helper.Init(
-      node.vis_localizer_loop_closure_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
-      node.get_logger());
+  InitVisHelpers();
+  if (node.enable_pipelined_tracking_) {
+    StartPipeline();
+  }
+  if (!startup_timeline.reported) {
+    startup_timeline.initialize_ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - initialize_start_time).count();
   }
   RCLCPP_INFO(node.get_logger(), "cuVSLAM tracker was successfully initialized.");
 
+  // A rig built from live messages and transforms replaces the cache.
+  if (rig_cache && cached_extrinsics.empty()) {
+    try {
+      rig_cache->Save(rig_cache_contents);
+      RCLCPP_INFO(node.get_logger(), "Saved the rig cache %s", rig_cache->Path().c_str());
+    } catch (const std::exception & e) {
+      RCLCPP_WARN(node.get_logger(), "Failed to save the rig cache: %s", e.what());
+    }
+  }
+
   if (node.localize_on_startup_) {
     // We don't care when this thread returns since we anyways can't do anything if the localization
     // fails. Thus we detach it.
@@ -381,23 +635,13 @@ void VisualSlamNode::VisualSlamImpl::Initialize()
 
 void VisualSlamNode::VisualSlamImpl::Exit()
 {
-  // observations_vis_helper.Exit();
-  landmarks_vis_helper.Exit();
-  lc_landmarks_vis_helper.Exit();
-  pose_graph_helper.Exit();
-  localizer_helper.Exit();
-  localizer_landmarks_vis_helper.Exit();
-  localizer_observations_vis_helper.Exit();
-  localizer_lc_landmarks_vis_helper.Exit();
-
-  if (cuvslam_odometry != nullptr) {
-    cuvslam_odometry.reset();
-    RCLCPP_INFO(node.get_logger(), "cuVSLAM odometry was destroyed");
-  }
+  // Stop the pipeline first, the tracking thread uses the cuvslam objects destroyed below.
+  StopPipeline();
+  ExitVisHelpers();
 
-  if (cuvslam_slam != nullptr) {
-    cuvslam_slam.reset();
-    RCLCPP_INFO(node.get_logger(), "cuVSLAM slam was destroyed");
+  if (tracking_backend != nullptr) {
+    tracking_backend.reset();
+    RCLCPP_INFO(node.get_logger(), "Tracking backend was destroyed");
   }
 
   if (ground_constraint != nullptr) {
@@ -405,22 +649,136 @@ void VisualSlamNode::VisualSlamImpl::Exit()
     RCLCPP_INFO(node.get_logger(), "cuVSLAM ground constraint was destroyed");
   }
 
-  pose_cache.Reset();
-  velocity_cache.Reset();
+  ResetTrackingState();
 
   initial_imu_message.reset();
   initial_camera_info_messages.clear();
+  pending_camera_info_hashes.clear();
+
+  CancelLocalization("Cannot localize in map because Exit() was called.");
+}
+
+bool VisualSlamNode::VisualSlamImpl::SoftReset(bool clear_map)
+{
+  if (!IsInitialized()) {
+    return false;
+  }
+  Stopwatch stopwatch_reset;
+  StopwatchScope ssw_reset(stopwatch_reset);
+  // The tracking thread must not use the backend while it is reset.
+  StopPipeline();
+  if (clear_map) {
+    // The helpers keep the slam object alive, it is replaced.
+    ExitVisHelpers();
+    CancelLocalization("Cannot localize in map because the map was cleared.");
+  }
+  try {
+    std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+    tracking_backend->Reset(clear_map);
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(node.get_logger(), "Failed to reset the tracking backend: %s", e.what());
+    return false;
+  }
+  // The ground constraint keeps the ground plane of the previous tracking session.
+  if (node.enable_ground_constraint_in_odometry_) {
+    ground_constraint = InitGroundConstraint(node.get_logger());
+    if (!ground_constraint) {
+      return false;
+    }
+  }
+  ResetTrackingState();
+  if (clear_map) {
+    InitVisHelpers();
+  }
+  if (node.enable_pipelined_tracking_) {
+    StartPipeline();
+  }
+  RCLCPP_INFO(
+    node.get_logger(), "Soft reset of the tracker took %.1f ms", 1e3 * ssw_reset.Stop());
+  return true;
+}
 
+void VisualSlamNode::VisualSlamImpl::ResetTrackingState()
+{
+  pose_cache.Reset();
+  velocity_cache.Reset();
+  pose_history.Reset();
+  imu_propagator.Reset();
+  // The first frame after a reset is not a jitter of the last one before it.
+  last_track_ts = -1;
+  // After a reset the transforms are published right away again.
+  tf_throttle.Reset();
+  vo_path_state.last_full_publish_ts.reset();
+  slam_path_state.last_full_publish_ts.reset();
+  side_channels.Clear();
+  last_staged_imu_ts = -1;
+}
+
+void VisualSlamNode::VisualSlamImpl::CancelLocalization(const std::string & reason)
+{
   // Try to set the promise if localization has not returned yet. We don't know if the response is
   // outstanding so we just try it and catch the exception.
-  LocalizeInExistDbContext::Response response{boost::outcome_v2::failure<std::string>(
-            "Cannot localize in map because Exit() was called.")};
+  LocalizeInExistDbContext::Response response{boost::outcome_v2::failure<std::string>(reason)};
   try {
     localize_in_exist_db_context.response_promise.set_value(response);
   } catch (const std::exception & e) {
   }
 }
 
+void VisualSlamNode::VisualSlamImpl::InitVisHelpers()
+{
+  // They read the internals of cuVSLAM slam directly.
+  std::shared_ptr<cuvslam::Slam> cuvslam_slam;
+  {
+    std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+    cuvslam_slam = tracking_backend->GetSlam();
+  }
+  if (!node.enable_slam_visualization_ || !cuvslam_slam) {
+    return;
+  }
+  // observations_vis_helper.Init(
+  //   node.vis_observations_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+  //   node.get_logger());
+  landmarks_vis_helper.SetDeltaPublisher(
+    node.vis_landmarks_delta_pub_, node.landmarks_keyframe_period_ms_);
+  landmarks_vis_helper.Init(
+    node.vis_landmarks_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+  lc_landmarks_vis_helper.Init(
+    node.vis_loop_closure_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+  pose_graph_helper.Init(
+    node.vis_posegraph_nodes_pub_, node.vis_posegraph_edges_pub_,
+    node.vis_posegraph_edges2_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+  localizer_helper.Init(
+    node.vis_localizer_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+  localizer_landmarks_vis_helper.SetDeltaPublisher(
+    node.vis_localizer_landmarks_delta_pub_, node.landmarks_keyframe_period_ms_);
+  localizer_landmarks_vis_helper.Init(
+    node.vis_localizer_landmarks_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+  localizer_observations_vis_helper.Init(
+    node.vis_localizer_observations_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+  localizer_lc_landmarks_vis_helper.Init(
+    node.vis_localizer_loop_closure_pub_, cuvslam_slam, canonical_pose_cuvslam, node.map_frame_,
+    node.get_logger());
+}
+
+void VisualSlamNode::VisualSlamImpl::ExitVisHelpers()
+{
+  // observations_vis_helper.Exit();
+  landmarks_vis_helper.Exit();
+  lc_landmarks_vis_helper.Exit();
+  pose_graph_helper.Exit();
+  localizer_helper.Exit();
+  localizer_landmarks_vis_helper.Exit();
+  localizer_observations_vis_helper.Exit();
+  localizer_lc_landmarks_vis_helper.Exit();
+}
+
 cuvslam::Odometry::Config VisualSlamNode::VisualSlamImpl::CreateOdometryConfiguration()
 {
   cuvslam::Odometry::Config configuration = cuvslam::Odometry::GetDefaultConfig();
@@ -469,17 +827,74 @@ cuvslam::Slam::Config VisualSlamNode::VisualSlamImpl::CreateSlamConfiguration()
   return configuration;
 }
 
-// Helper function to publish source frame pose wrt target frame to the tf tree
-void VisualSlamNode::VisualSlamImpl::PublishFrameTransform(
+std::unique_ptr<TrackingBackend> VisualSlamNode::VisualSlamImpl::CreateTrackingBackend(
+  const cuvslam::Rig & cam_rig)
+{
+  if (node.tracking_backend_ == "synthetic") {
+    SyntheticTrackingBackend::Config config;
+    config.linear_velocity = node.synthetic_backend_linear_velocity_;
+    config.angular_velocity = node.synthetic_backend_angular_velocity_;
+    config.track_cost = std::chrono::microseconds(
+      static_cast<int64_t>(node.synthetic_backend_track_cost_ms_ * 1e3));
+    config.slam_cost = std::chrono::microseconds(
+      static_cast<int64_t>(node.synthetic_backend_slam_cost_ms_ * 1e3));
+    RCLCPP_WARN(
+      node.get_logger(), "Using the synthetic tracking backend. Poses are scripted, not tracked.");
+    return std::make_unique<SyntheticTrackingBackend>(config);
+  }
+
+  // Create cuvslam odometry tracker.
+  const cuvslam::Odometry::Config configuration = CreateOdometryConfiguration();
+  PrintConfiguration(node.get_logger(), configuration);
+  WaitForGpuWarmUp();
+
+  std::unique_ptr<cuvslam::Odometry> cuvslam_odometry;
+  try {
+    Stopwatch stopwatch_tracker;
+    StopwatchScope ssw_tracker(stopwatch_tracker);
+    cuvslam_odometry = std::make_unique<cuvslam::Odometry>(cam_rig, configuration);
+    const double odometry_time = ssw_tracker.Stop();
+    RCLCPP_INFO(node.get_logger(), "Time taken by cuvslam::Odometry::Odometry(): %f",
+            odometry_time);
+    startup_timeline.odometry_ms = 1e3 * odometry_time;
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR(node.get_logger(), "Failed to initialize cuvslam::Odometry: %s", e.what());
+    return nullptr;
+  }
+
+  const cuvslam::Slam::Config slam_configuration = CreateSlamConfiguration();
+  std::shared_ptr<cuvslam::Slam> cuvslam_slam;
+  if (node.enable_localization_n_mapping_) {
+    try {
+      Stopwatch stopwatch_slam;
+      StopwatchScope ssw_slam(stopwatch_slam);
+      cuvslam_slam = std::make_shared<cuvslam::Slam>(cam_rig, cuvslam_odometry->GetPrimaryCameras(),
+              slam_configuration);
+      const double slam_time = ssw_slam.Stop();
+      RCLCPP_INFO(node.get_logger(), "Time taken by cuvslam::Slam::Slam(): %f", slam_time);
+      startup_timeline.slam_ms = 1e3 * slam_time;
+    } catch (const std::exception & e) {
+      RCLCPP_ERROR(node.get_logger(), "Failed to initialize cuvslam::Slam: %s", e.what());
+      return nullptr;
+    }
+  }
+
+  return std::make_unique<CuvslamTrackingBackend>(
+    std::move(cuvslam_odometry), std::move(cuvslam_slam), cam_rig, configuration,
+    slam_configuration);
+}
+
+// Helper function to add source frame pose wrt target frame to the transforms of the frame
+void VisualSlamNode::VisualSlamImpl::AddFrameTransform(
   rclcpp::Time stamp, const tf2::Transform & pose,
   const std::string & target, const std::string & source)
 {
-  geometry_msgs::msg::TransformStamped target_pose_source;
+  geometry_msgs::msg::TransformStamped & target_pose_source =
+    output_arena.transforms.transforms.emplace_back();
   target_pose_source.header.stamp = stamp;
   target_pose_source.header.frame_id = target;
   target_pose_source.child_frame_id = source;
   target_pose_source.transform = tf2::toMsg(pose);
-  tf_publisher->sendTransform(target_pose_source);
 }
 
 // Helper function to get child frame pose wrt parent frame from the tf tree
@@ -493,18 +908,12 @@ tf2::Transform VisualSlamNode::VisualSlamImpl::GetLatestTransform(
   constexpr int32_t kTimeOutSeconds = 10;
 
   try {
-    if (!tf_buffer->canTransform(
-        target, source, tf2::TimePointZero, tf2::durationFromSec(kTimeOutSeconds)))
-    {
-      RCLCPP_ERROR(
-        node.get_logger(), "Transform is impossible. canTransform(%s->%s) returns false",
-        target.c_str(), source.c_str());
-    }
+    // Waits for the transform up to the timeout.
     transform_stamped = tf_buffer->lookupTransform(
       target, source, tf2::TimePointZero, tf2::durationFromSec(kTimeOutSeconds));
     tf2::fromMsg(transform_stamped.transform, pose);
   } catch (tf2::TransformException & ex) {
-    RCLCPP_INFO(
+    RCLCPP_ERROR(
       node.get_logger(), "Could not transform %s to %s: %s",
       source.c_str(), target.c_str(), ex.what());
     throw std::runtime_error("Could not find the requested transform!");
@@ -512,17 +921,167 @@ tf2::Transform VisualSlamNode::VisualSlamImpl::GetLatestTransform(
   return pose;
 }
 
-void VisualSlamNode::VisualSlamImpl::PublishOdometryVelocity(
-  rclcpp::Time stamp, const std::string & frame_id,
-  const rclcpp::Publisher<MarkerArrayType>::SharedPtr publisher)
+std::future<tf2::Transform> VisualSlamNode::VisualSlamImpl::GetLatestTransformAsync(
+  const std::string & target, const std::string & source)
 {
-  geometry_msgs::msg::Twist twist;
+  return std::async(
+    std::launch::async, [this, target, source]() {return GetLatestTransform(target, source);});
+}
 
-  pose_cache.GetVelocity(
-    twist.linear.x, twist.linear.y, twist.linear.z,
-    twist.angular.x, twist.angular.y, twist.angular.z);
+std::future<tf2::Transform> VisualSlamNode::VisualSlamImpl::GetExtrinsicAsync(
+  const std::string & target, const std::string & source)
+{
+  const auto it = cached_extrinsics.find({target, source});
+  if (it == cached_extrinsics.end()) {
+    return GetLatestTransformAsync(target, source);
+  }
+  std::promise<tf2::Transform> promise;
+  promise.set_value(it->second);
+  return promise.get_future();
+}
 
-  MarkerArrayType markers;
+bool VisualSlamNode::VisualSlamImpl::InitializeFromRigCache()
+{
+  if (!rig_cache || IsInitialized() || !rig_cache->Exists()) {
+    return false;
+  }
+  RigCache::Contents contents;
+  try {
+    contents = rig_cache->Load();
+  } catch (const std::exception & e) {
+    RCLCPP_WARN(node.get_logger(), "Ignoring the rig cache: %s", e.what());
+    return false;
+  }
+  if (contents.camera_infos.size() != static_cast<size_t>(node.num_cameras_) ||
+    (node.tracking_mode_ == static_cast<int>(TrackingMode::VIO) && !contents.imu))
+  {
+    RCLCPP_WARN(
+      node.get_logger(), "Ignoring the rig cache %s, it does not cover all sensors",
+      rig_cache->Path().c_str());
+    return false;
+  }
+
+  RCLCPP_INFO(node.get_logger(), "Initializing from the rig cache %s", rig_cache->Path().c_str());
+  for (const auto & [idx, camera_info_msg] : contents.camera_infos) {
+    initial_camera_info_messages[idx] = camera_info_msg;
+  }
+  if (contents.imu) {
+    initial_imu_message = contents.imu;
+  }
+  cached_extrinsics = std::move(contents.transforms);
+  try {
+    Initialize();
+  } catch (const std::exception & e) {
+    RCLCPP_WARN(node.get_logger(), "Failed to initialize from the rig cache: %s", e.what());
+  }
+  cached_extrinsics.clear();
+  if (!IsInitialized()) {
+    initial_imu_message.reset();
+    initial_camera_info_messages.clear();
+    return false;
+  }
+
+  // The calibration is compared to the live camera infos once they arrive.
+  for (const auto & [idx, camera_info_msg] : contents.camera_infos) {
+    pending_camera_info_hashes[idx] = RigCache::HashCameraInfo(*camera_info_msg);
+  }
+  return true;
+}
+
+void VisualSlamNode::VisualSlamImpl::WaitForGpuWarmUp()
+{
+  if (!node.gpu_warm_up_.valid()) {
+    return;
+  }
+  const auto wait_start_time = std::chrono::steady_clock::now();
+  const double gpu_warm_up_time = node.gpu_warm_up_.get();
+  if (!startup_timeline.reported) {
+    startup_timeline.gpu_warm_up_ms = 1e3 * gpu_warm_up_time;
+    startup_timeline.gpu_warm_up_wait_ms = std::chrono::duration<double, std::milli>(
+      std::chrono::steady_clock::now() - wait_start_time).count();
+    RCLCPP_INFO(node.get_logger(), "Time taken by cuvslam::WarmUpGPU(): %f", gpu_warm_up_time);
+  }
+}
+
+void VisualSlamNode::VisualSlamImpl::ReportStartupTimeline()
+{
+  StartupTimeline & timeline = startup_timeline;
+  timeline.reported = true;
+  const double first_pose_ms = std::chrono::duration<double, std::milli>(
+    std::chrono::steady_clock::now() - timeline.start).count();
+  RCLCPP_INFO(
+    node.get_logger(), "Startup timeline [ms]: inputs %.1f, extrinsics %.1f, GPU warm-up %.1f "
+    "(blocked %.1f), odometry %.1f, slam %.1f, initialize %.1f, first pose %.1f",
+    timeline.wait_for_inputs_ms, timeline.extrinsics_ms, timeline.gpu_warm_up_ms,
+    timeline.gpu_warm_up_wait_ms, timeline.odometry_ms, timeline.slam_ms, timeline.initialize_ms,
+    first_pose_ms);
+
+  DiagnosticArrayType diagnostics;
+  SetHeader(diagnostics.header, node.get_clock()->now(), node.map_frame_);
+  DiagnosticStatusType & status = diagnostics.status.emplace_back();
+  status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+  status.name = "Visual Slam Startup";
+  status.message = "Durations of the startup phases in milliseconds";
+  status.hardware_id = "visual_slam";
+  size_t value_index = 0;
+  SetDiagnosticValue(status, value_index++, "wait_for_inputs_ms", timeline.wait_for_inputs_ms);
+  SetDiagnosticValue(status, value_index++, "extrinsics_ms", timeline.extrinsics_ms);
+  SetDiagnosticValue(status, value_index++, "gpu_warm_up_ms", timeline.gpu_warm_up_ms);
+  SetDiagnosticValue(
+    status, value_index++, "gpu_warm_up_wait_ms", timeline.gpu_warm_up_wait_ms);
+  SetDiagnosticValue(status, value_index++, "odometry_ms", timeline.odometry_ms);
+  SetDiagnosticValue(status, value_index++, "slam_ms", timeline.slam_ms);
+  SetDiagnosticValue(status, value_index++, "initialize_ms", timeline.initialize_ms);
+  SetDiagnosticValue(status, value_index++, "first_pose_ms", first_pose_ms);
+  node.diagnostics_pub_->publish(diagnostics);
+}
+
+void VisualSlamNode::VisualSlamImpl::UpdatePath(
+  const rclcpp::Time & stamp, const std::string & frame_id, const PoseType & pose,
+  limited_vector<PoseStampedType> & path, PathState & path_state,
+  const rclcpp::Publisher<PathType>::SharedPtr & full_publisher,
+  const rclcpp::Publisher<PathType>::SharedPtr & delta_publisher)
+{
+  const bool publish_delta = HasSubscribers(path_state.has_delta_subscribers);
+  const bool publish_full = HasSubscribers(path_state.has_full_subscribers);
+  if (!publish_delta && !publish_full) {
+    return;
+  }
+
+  // The path buffer is a ring, adding is O(1) independent of path_max_size.
+  PoseStampedType & pose_stamped = path_state.pose;
+  SetHeader(pose_stamped.header, stamp, frame_id);
+  pose_stamped.pose = pose;
+  path.add(pose_stamped);
+
+  if (publish_delta) {
+    // Everything appended since the last delta message. That is the whole buffer when the first
+    // subscriber connects.
+    PathType & delta_msg = path_state.delta_msg;
+    SetHeader(delta_msg.header, stamp, frame_id);
+    path.copyLast(path.numAdded() - path_state.num_added_at_last_delta, delta_msg.poses);
+    delta_publisher->publish(delta_msg);
+    path_state.num_added_at_last_delta = path.numAdded();
+  }
+
+  if (publish_full) {
+    const int64_t period_ns = static_cast<int64_t>(node.path_publish_period_ms_ * 1e6);
+    if (IsPeriodElapsed(stamp.nanoseconds(), path_state.last_full_publish_ts, period_ns)) {
+      PathType & full_msg = path_state.full_msg;
+      SetHeader(full_msg.header, stamp, frame_id);
+      // The poses were reserved for the maximum path size, the copy reuses their capacity.
+      path.copyTo(full_msg.poses);
+      full_publisher->publish(full_msg);
+      path_state.last_full_publish_ts = stamp.nanoseconds();
+    }
+  }
+}
+
+void VisualSlamNode::VisualSlamImpl::PublishOdometryVelocity(
+  rclcpp::Time stamp, const std::string & frame_id, const geometry_msgs::msg::Twist & twist,
+  const rclcpp::Publisher<MarkerArrayType>::SharedPtr publisher)
+{
+  MarkerArrayType & markers = output_arena.velocity_markers;
   markers.markers.resize(2);
 
   float width = 0.02f;
@@ -597,26 +1156,97 @@ void VisualSlamNode::VisualSlamImpl::PublishOdometryVelocity(
   publisher->publish(markers);
 }
 
+void VisualSlamNode::VisualSlamImpl::WriteShmPoseRecord(const TrackingResult & result)
+{
+  ShmPoseRecord record{};
+  record.timestamp_ns = result.timestamp_output.nanoseconds();
+  record.vo_state = result.vo_success ? 1 : 2;
+  if (result.vo_success) {
+    const std::pair<const tf2::Transform &, double *> poses[] = {
+      {result.odom_pose_base_link, record.vo_pose},
+      {result.map_pose_base_link, record.slam_pose},
+    };
+    for (const auto & [pose, values] : poses) {
+      const tf2::Vector3 & origin = pose.getOrigin();
+      const tf2::Quaternion rotation = pose.getRotation();
+      values[0] = origin.x();
+      values[1] = origin.y();
+      values[2] = origin.z();
+      values[3] = rotation.x();
+      values[4] = rotation.y();
+      values[5] = rotation.z();
+      values[6] = rotation.w();
+    }
+    record.twist[0] = result.velocity.linear.x;
+    record.twist[1] = result.velocity.linear.y;
+    record.twist[2] = result.velocity.linear.z;
+    record.twist[3] = result.velocity.angular.x;
+    record.twist[4] = result.velocity.angular.y;
+    record.twist[5] = result.velocity.angular.z;
+    // Identity if there is no estimate yet, like on tracking/odometry.
+    for (int i = 0; i < 6; i++) {
+      record.pose_covariance[i * 6 + i] = 1;
+      record.twist_covariance[i * 6 + i] = 1;
+    }
+    if (result.odom_pose_covariance) {
+      std::copy(
+        result.odom_pose_covariance->begin(), result.odom_pose_covariance->end(),
+        record.pose_covariance);
+    }
+    if (result.odom_twist_covariance) {
+      std::copy(
+        result.odom_twist_covariance->begin(), result.odom_twist_covariance->end(),
+        record.twist_covariance);
+    }
+  }
+  record.write_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+  shm_pose_ring->Write(record);
+}
+
+void VisualSlamNode::VisualSlamImpl::PublishImuRateOdometry(
+  const ImuPropagator::State & state, const rclcpp::Time & stamp)
+{
+  PublishFrameMessage(
+    *node.tracking_odometry_imu_rate_pub_, subscribed.odometry_imu_rate_intra_process,
+    imu_rate_odometry, [&](OdometryType & odom) {
+      SetHeader(odom.header, stamp, node.odom_frame_);
+      odom.child_frame_id = node.base_frame_;
+      tf2::toMsg(state.pose, odom.pose.pose);
+
+      // The twist is given in the child frame.
+      const tf2::Vector3 linear_velocity =
+        state.pose.getBasis().transpose() * state.linear_velocity;
+      odom.twist.twist.linear.x = linear_velocity.x();
+      odom.twist.twist.linear.y = linear_velocity.y();
+      odom.twist.twist.linear.z = linear_velocity.z();
+      odom.twist.twist.angular.x = state.angular_velocity.x();
+      odom.twist.twist.angular.y = state.angular_velocity.y();
+      odom.twist.twist.angular.z = state.angular_velocity.z();
+
+      // The propagation does not estimate its uncertainty, set default Identity matrices.
+      for (int i = 0; i < 6; i++) {
+        for (int j = 0; j < 6; j++) {
+          odom.pose.covariance[i * 6 + j] = i == j ? 1 : 0;
+          odom.twist.covariance[i * 6 + j] = i == j ? 1 : 0;
+        }
+      }
+    });
+}
+
 void VisualSlamNode::VisualSlamImpl::PublishGravity(
   rclcpp::Time stamp, const std::string & frame_id,
+  const cuvslam::Odometry::Gravity & gravity_in_cuvslam,
   const rclcpp::Publisher<MarkerType>::SharedPtr publisher)
 {
   if (node.tracking_mode_ != static_cast<int>(TrackingMode::VIO)) {
     return;
   }
-  auto maybe_gravity = cuvslam_odometry->GetLastGravity();
-  if (!maybe_gravity) {
-    // Don't publish anything if cuvslam hasn't calculated gravity yet. After the start
-    // or loss of visual tracking, cuvslam needs some time to align optical and imu sensors.
-    // Only after that is it able to calculate the gravity vector.
-    return;
-  }
 
-  cuvslam::Odometry::Gravity gravity_in_cuvslam = *maybe_gravity;
   const tf2::Vector3 g_cuvslam(gravity_in_cuvslam[0], gravity_in_cuvslam[1], gravity_in_cuvslam[2]);
   const tf2::Vector3 g_base_link = canonical_pose_cuvslam * g_cuvslam;
 
-  MarkerType m;
+  MarkerType & m = output_arena.gravity_marker;
   m.header.frame_id = frame_id;
   m.header.stamp = stamp;
   m.ns = "gravity";
@@ -649,7 +1279,7 @@ void VisualSlamNode::VisualSlamImpl::PublishGravity(
   m.points[0] = p1;
   m.points[1] = p2;
 
-  publisher->publish(std::move(m));
+  publisher->publish(m);
 }
 
 
@@ -660,7 +1290,34 @@ void VisualSlamNode::VisualSlamImpl::CallbackImu(const ImuType::ConstSharedPtr &
 
   if (IsInitialized()) {
     const rclcpp::Time timestamp(msg->header.stamp);
-    sequencer.CallbackStream1(timestamp.nanoseconds(), msg);
+    ImuSample sample{msg, std::nullopt};
+    if (node.enable_eager_imu_ingestion_) {
+      // Validate and convert the message now, so that the frame only hands it over.
+      if (!IsValidImuMessage(*msg) || timestamp.nanoseconds() <= last_staged_imu_ts) {
+        num_rejected_imu_msgs++;
+        RCLCPP_WARN_THROTTLE(
+          node.get_logger(), *node.get_clock(), 1000,
+          "Rejected %lu IMU messages that were out of order or not finite so far",
+          static_cast<unsigned long>(num_rejected_imu_msgs));  // NOLINT
+        return;
+      }
+      last_staged_imu_ts = timestamp.nanoseconds();
+      sample.measurement = TocuVSLAMImuMeasurement(*msg, imu_measurement_rotation);
+    }
+    sequencer.CallbackStream1(timestamp.nanoseconds(), sample);
+
+    if (node.tracking_mode_ == static_cast<int>(TrackingMode::VIO) &&
+      HasSubscribers(subscribed.odometry_imu_rate))
+    {
+      const auto & w = msg->angular_velocity;
+      const auto & a = msg->linear_acceleration;
+      const std::optional<ImuPropagator::State> state = imu_propagator.Add(
+        timestamp.nanoseconds(), tf2::Vector3(w.x, w.y, w.z), tf2::Vector3(a.x, a.y, a.z));
+      if (state) {
+        PublishImuRateOdometry(
+          *state, node.override_publishing_stamp_ ? node.get_clock()->now() : timestamp);
+      }
+    }
   } else {initial_imu_message = msg;}
 }
 
@@ -671,7 +1328,26 @@ void VisualSlamNode::VisualSlamImpl::CallbackImage(int index, const ImageType &
 
   if (IsInitialized()) {
     const rclcpp::Time timestamp = NitrosTimeStamp::value(image_view.GetMessage());
-    sync.AddMessage(index, timestamp.nanoseconds(), image_view);
+    if (node.decouple_masks_and_depth_ && index >= static_cast<int>(node.num_cameras_)) {
+      side_channels.Add(index - node.num_cameras_, timestamp.nanoseconds(), image_view);
+      return;
+    }
+    image_arrival_times.Add(timestamp.nanoseconds(), std::chrono::steady_clock::now());
+    if (node.enable_adaptive_sync_) {
+      sync_tuner.AddImage(index, timestamp.nanoseconds());
+      SyncTuner::Config config;
+      if (sync_tuner.Retune(config)) {
+        RCLCPP_INFO(
+          node.get_logger(), "Retuning the image synchronizer to a matching threshold of %.2f ms "
+          "and a buffer size of %zu", config.matching_threshold_ns * 1e-6, config.buffer_size);
+        CreateSynchronizer(config);
+      }
+    }
+    if (dropout_sync) {
+      dropout_sync->AddMessage(index, timestamp.nanoseconds(), image_view);
+    } else {
+      sync->AddMessage(index, timestamp.nanoseconds(), image_view);
+    }
   }
 }
 
@@ -684,37 +1360,164 @@ void VisualSlamNode::VisualSlamImpl::CallbackCameraInfo(
   if (!IsInitialized()) {
     initial_camera_info_messages[index] = msg;
     if (IsReadyForInitialization()) {Initialize();}
+    return;
+  }
+
+  // A tracker created from the rig cache is kept as long as the live calibration matches.
+  const auto pending = pending_camera_info_hashes.find(index);
+  if (pending == pending_camera_info_hashes.end()) {
+    return;
+  }
+  if (pending->second == RigCache::HashCameraInfo(*msg)) {
+    pending_camera_info_hashes.erase(pending);
+    if (pending_camera_info_hashes.empty()) {
+      RCLCPP_INFO(node.get_logger(), "The rig cache matches the live camera infos");
+    }
+    return;
+  }
+  RCLCPP_WARN(
+    node.get_logger(),
+    "Camera info %d differs from the rig cache, discarding %s and reinitializing",
+    index, rig_cache->Path().c_str());
+  rig_cache->Remove();
+  Exit();
+  initial_camera_info_messages[index] = msg;
+}
+
+size_t VisualSlamNode::VisualSlamImpl::NumImageStreams() const
+{
+  if (node.decouple_masks_and_depth_) {
+    return node.num_cameras_;
+  }
+  return node.num_cameras_ + node.num_input_masks_ +
+         (node.tracking_mode_ == static_cast<int>(TrackingMode::RGBD) ? 1 : 0);
+}
+
+size_t VisualSlamNode::VisualSlamImpl::MinNumImages() const
+{
+  if (node.decouple_masks_and_depth_) {
+    return node.min_num_images_;
   }
+  return node.min_num_images_ + node.num_input_masks_ +
+         (node.tracking_mode_ == static_cast<int>(TrackingMode::RGBD) ? 1 : 0);
+}
+
+void VisualSlamNode::VisualSlamImpl::CreateSynchronizer(const SyncTuner::Config & config)
+{
+  if (node.enable_camera_dropout_handling_) {
+    dropout_sync.emplace(
+      NumImageStreams(), config.matching_threshold_ns, MinNumImages(), config.buffer_size,
+      std::chrono::duration_cast<DropoutSync::Clock::duration>(
+        std::chrono::duration<double, std::milli>(node.camera_dropout_deadline_ms_)),
+      node.camera_dropout_readmit_frames_);
+    dropout_sync->RegisterCallback(
+      std::bind(
+        &VisualSlamNode::VisualSlamImpl::CallbackSynchronizedImages, this,
+        std::placeholders::_1, std::placeholders::_2));
+    dropout_sync->RegisterStreamCallback(
+      [this](int index, bool degraded) {
+        if (degraded) {
+          RCLCPP_WARN(
+            node.get_logger(), "Image stream %d missed its deadline, continuing without it",
+            index);
+        } else {
+          RCLCPP_INFO(node.get_logger(), "Image stream %d is on time again", index);
+        }
+      });
+    return;
+  }
+  sync.emplace(
+    NumImageStreams(), config.matching_threshold_ns, MinNumImages(), config.buffer_size);
+  sync->RegisterCallback(
+    std::bind(
+      &VisualSlamNode::VisualSlamImpl::CallbackSynchronizedImages, this,
+      std::placeholders::_1, std::placeholders::_2));
 }
 
 void VisualSlamNode::VisualSlamImpl::CallbackSynchronizedImages(
   int64_t latest_ts, const std::vector<std::pair<int, ImageType>> & idx_and_image_msgs)
 {
+  const auto now = std::chrono::steady_clock::now();
+  auto first_arrival_time = now;
+  for (const auto & [idx, image_msg] : idx_and_image_msgs) {
+    std::chrono::steady_clock::time_point arrival_time;
+    if (image_arrival_times.Find(
+        NitrosTimeStamp::value(image_msg.GetMessage()).nanoseconds(), arrival_time))
+    {
+      first_arrival_time = std::min(first_arrival_time, arrival_time);
+    }
+  }
+  latency_histograms[kSyncWait].Record(now - first_arrival_time);
+  if (node.enable_adaptive_sync_) {
+    sync_tuner.AddSyncWait(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(now - first_arrival_time).count());
+  }
+  frame_set_arrival_times.Add(GetLatestTimeStamp(idx_and_image_msgs), now);
+
   sequencer.CallbackStream2(latest_ts, idx_and_image_msgs);
 }
 
 void VisualSlamNode::VisualSlamImpl::UpdatePose(
-  const std::vector<ImuType::ConstSharedPtr> & imu_msgs,
+  const BatchView<ImuSample> & imu_samples,
   const std::vector<std::pair<int, ImageType>> & idx_and_image_msgs)
+{
+  std::chrono::steady_clock::time_point arrival_time;
+  if (frame_set_arrival_times.Find(GetLatestTimeStamp(idx_and_image_msgs), arrival_time)) {
+    latency_histograms[kSequencerWait].Record(std::chrono::steady_clock::now() - arrival_time);
+  }
+
+  if (node.enable_pipelined_tracking_) {
+    // Hand the frame set over to the tracking thread. If the tracking thread falls behind, the
+    // oldest frame set is dropped but its imu messages are carried over to the next one, because
+    // the inertial integration needs all of them.
+    FrameSet & frame_set = pending_frame_set;
+    frame_set.imu_samples.assign(imu_samples.begin(), imu_samples.end());
+    frame_set.idx_and_image_msgs.assign(idx_and_image_msgs.begin(), idx_and_image_msgs.end());
+    frame_set.enqueue_time = std::chrono::steady_clock::now();
+    tracking_queue.Push(
+      frame_set, [](FrameSet & dropped, FrameSet & next) {
+        next.imu_samples.insert(
+          next.imu_samples.begin(), dropped.imu_samples.begin(), dropped.imu_samples.end());
+      });
+    // Release the images of a dropped frame set that may have come back.
+    frame_set.imu_samples.clear();
+    frame_set.idx_and_image_msgs.clear();
+    return;
+  }
+
+  TrackingResult result;
+  result.start_time = std::chrono::steady_clock::now();
+  if (TrackFrame(imu_samples, idx_and_image_msgs, result)) {
+    PublishTrackingResult(result);
+  }
+}
+
+void VisualSlamNode::VisualSlamImpl::TrackingArena::Reset()
+{
+  images.clear();
+  masks.clear();
+  depth_images.clear();
+  std::fill(mask_msgs.begin(), mask_msgs.end(), nullptr);
+  for (std::optional<ImageType> & msg : side_channel_msgs) {
+    msg.reset();
+  }
+}
+
+bool VisualSlamNode::VisualSlamImpl::TrackFrame(
+  const BatchView<ImuSample> & imu_samples,
+  const std::vector<std::pair<int, ImageType>> & idx_and_image_msgs,
+  TrackingResult & result)
 {
   NvtxRangeScoped trace(
     "VisualSlamNode::VisualSlamImpl::UpdatePose", nvidia::isaac_ros::nitros::CLR_MAGENTA);
-  Stopwatch stopwatch;
-  StopwatchScope ssw(stopwatch);
+  const auto stage_start_time = std::chrono::steady_clock::now();
+  const uint64_t heap_allocations_start = GetThreadHeapAllocations();
 
   // Check for completed localization
   CheckLocalizationStatus();
 
-  // Get the latest timestamp from images. We assume that the vector is never empty.
-  const auto max_element = std::max_element(
-    idx_and_image_msgs.begin(), idx_and_image_msgs.end(),
-    [](std::pair<int, ImageType> msg1, std::pair<int, ImageType> msg2) {
-      auto ts1 = NitrosTimeStamp::value(msg1.second.GetMessage());
-      auto ts2 = NitrosTimeStamp::value(msg2.second.GetMessage());
-      return ts1.nanoseconds() < ts2.nanoseconds();
-    });
-
-  const int64_t latest_ts = NitrosTimeStamp::value(max_element->second.GetMessage()).nanoseconds();
+  // Get the latest timestamp from images.
+  const int64_t latest_ts = GetLatestTimeStamp(idx_and_image_msgs);
 
   RCLCPP_DEBUG(node.get_logger(), "Using image msg timestamp [%ld]", latest_ts);
 
@@ -729,33 +1532,74 @@ void VisualSlamNode::VisualSlamImpl::UpdatePose(
 
   Stopwatch stopwatch_track;
   // First we add all imu measurements received since the last update.
-  for (const auto & imu_msg : imu_msgs) {
-    const rclcpp::Time timestamp(imu_msg->header.stamp);
-    int64_t imu_ts = static_cast<int64_t>(timestamp.nanoseconds());
-    RCLCPP_DEBUG(node.get_logger(), "Using imu msg timestamp [%ld]", imu_ts);
-    const auto imu_measurement = TocuVSLAMImuMeasurement(imu_msg, imu_ts);
-    try {
-      cuvslam_odometry->RegisterImuMeasurement(0, imu_measurement);
-    } catch (const std::exception & e) {
-      RCLCPP_WARN(node.get_logger(), "Failed to register an IMU measurement: %s",
-              e.what());
+  const auto imu_registration_start_time = std::chrono::steady_clock::now();
+  // With eager ingestion the measurements were converted on arrival and are only handed over.
+  const bool imu_staged = node.enable_eager_imu_ingestion_;
+  if (!imu_staged) {
+    TocuVSLAMImuMeasurements(imu_samples, imu_measurement_rotation, tracking_arena.imu_batch);
+  }
+  // Failures are reported once per batch, a burst of rejected measurements must not flood the log.
+  size_t num_imu_failures = 0;
+  int64_t first_failed_imu_ts = 0;
+  std::string first_imu_error;
+  {
+    std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+    for (size_t i = 0; i < imu_samples.size(); i++) {
+      const cuvslam::ImuMeasurement & imu_measurement = imu_staged ?
+        *imu_samples[i].measurement : tracking_arena.imu_batch.measurements[i];
+      try {
+        tracking_backend->RegisterImuMeasurement(imu_measurement);
+      } catch (const std::exception & e) {
+        if (num_imu_failures++ == 0) {
+          first_failed_imu_ts = imu_measurement.timestamp_ns;
+          first_imu_error = e.what();
+        }
+      }
     }
   }
+  if (num_imu_failures > 0) {
+    RCLCPP_WARN(
+      node.get_logger(), "Failed to register %zu of %zu IMU measurements, first at [%ld]: %s",
+      num_imu_failures, imu_samples.size(), first_failed_imu_ts, first_imu_error.c_str());
+  }
+  const auto image_conversion_start_time = std::chrono::steady_clock::now();
+  latency_histograms[kImuRegistration].Record(
+    image_conversion_start_time - imu_registration_start_time);
 
   // Convert images to cuvslam's format.
-  std::vector<cuvslam::Image> cuvslam_images;
-  cuvslam_images.reserve(node.num_cameras_);
-  std::vector<cuvslam::Image> cuvslam_masks;
-  std::vector<cuvslam::Image> cuvslam_depth_images;
+  tracking_arena.Reset();
+  std::vector<cuvslam::Image> & cuvslam_images = tracking_arena.images;
+  std::vector<cuvslam::Image> & cuvslam_masks = tracking_arena.masks;
+  std::vector<cuvslam::Image> & cuvslam_depth_images = tracking_arena.depth_images;
 
   // Calculate the depth image index
   const int depth_image_idx = node.num_cameras_ + node.num_input_masks_;
 
   // First, extract the masks from the synchronized messages
-  std::unordered_map<int, const ImageType *> mask_msgs;
-  for (const auto & [idx, image_msg] : idx_and_image_msgs) {
-    if (idx >= static_cast<int>(node.num_cameras_) && idx < depth_image_idx) {
-      mask_msgs[idx - node.num_cameras_] = &image_msg;
+  std::vector<const ImageType *> & mask_msgs = tracking_arena.mask_msgs;
+  std::vector<std::optional<ImageType>> & side_channel_msgs = tracking_arena.side_channel_msgs;
+  if (node.decouple_masks_and_depth_) {
+    // The masks were not synchronized, take the closest one of every camera.
+    const int64_t tolerance_ns = static_cast<int64_t>(1e6 * node.mask_staleness_tolerance_ms_);
+    for (const auto & [idx, image_msg] : idx_and_image_msgs) {
+      if (idx >= static_cast<int>(node.num_input_masks_)) {
+        continue;
+      }
+      const int64_t image_ts = NitrosTimeStamp::value(image_msg.GetMessage()).nanoseconds();
+      if (side_channels.Find(idx, image_ts, tolerance_ns, side_channel_msgs[idx])) {
+        mask_msgs[idx] = &*side_channel_msgs[idx];
+      } else {
+        num_side_channel_misses++;
+      }
+    }
+  } else {
+    for (const auto & [idx, image_msg] : idx_and_image_msgs) {
+      const int camera_idx = idx - node.num_cameras_;
+      if (idx >= static_cast<int>(node.num_cameras_) && idx < depth_image_idx &&
+        camera_idx < static_cast<int>(mask_msgs.size()))
+      {
+        mask_msgs[camera_idx] = &image_msg;
+      }
     }
   }
 
@@ -763,9 +1607,8 @@ void VisualSlamNode::VisualSlamImpl::UpdatePose(
     if (idx < static_cast<int>(node.num_cameras_)) {
       // This is a regular RGB/MONO image modes
       cuvslam_images.push_back(TocuVSLAMImage(idx, image_msg, latest_ts));
-      auto mask_it = mask_msgs.find(idx);
-      if (mask_it != mask_msgs.end() && mask_it->second != nullptr) {
-        cuvslam_masks.push_back(TocuVSLAMImage(idx, *mask_it->second, latest_ts));
+      if (mask_msgs[idx] != nullptr) {
+        cuvslam_masks.push_back(TocuVSLAMImage(idx, *mask_msgs[idx], latest_ts));
       }
     } else if (node.tracking_mode_ == static_cast<int>(TrackingMode::RGBD) &&  // NOLINT
       idx == depth_image_idx)
@@ -775,6 +1618,20 @@ void VisualSlamNode::VisualSlamImpl::UpdatePose(
               latest_ts));
     }
   }
+  if (node.decouple_masks_and_depth_ &&
+    node.tracking_mode_ == static_cast<int>(TrackingMode::RGBD))
+  {
+    std::optional<ImageType> & depth_msg = side_channel_msgs[node.num_input_masks_];
+    const int64_t tolerance_ns = static_cast<int64_t>(1e6 * node.depth_staleness_tolerance_ms_);
+    if (side_channels.Find(node.num_input_masks_, latest_ts, tolerance_ns, depth_msg)) {
+      cuvslam_depth_images.push_back(
+        TocuVSLAMDepthImage(node.depth_camera_id_, *depth_msg, latest_ts));
+    } else {
+      num_side_channel_misses++;
+    }
+  }
+  latency_histograms[kImageConversion].Record(
+    std::chrono::steady_clock::now() - image_conversion_start_time);
 
   cuvslam::PoseEstimate vo_pose_estimate;
   {
@@ -782,21 +1639,28 @@ void VisualSlamNode::VisualSlamImpl::UpdatePose(
       "cuvslam::Odometry::Track", nvidia::isaac_ros::nitros::CLR_MAGENTA);
     StopwatchScope ssw_track(stopwatch_track);
     try {
-      vo_pose_estimate = cuvslam_odometry->Track(cuvslam_images, cuvslam_masks,
+      std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+      vo_pose_estimate = tracking_backend->Track(cuvslam_images, cuvslam_masks,
               cuvslam_depth_images);
     } catch (const std::exception & e) {
       RCLCPP_WARN(node.get_logger(), "Failed to track: %s", e.what());
-      return;
+      return false;
     }
+    latency_histograms[kOdometryTrack].Record(
+      std::chrono::duration<double>(ssw_track.Stop()));
   }
   bool vo_success = vo_pose_estimate.world_from_rig != std::nullopt;
 
   if (!vo_success) {
     pose_cache.Reset();
+    imu_propagator.Reset();
+    pose_history.MarkDiscontinuity();
     RCLCPP_WARN(node.get_logger(), "Visual tracking is lost");
   }
 
-  const rclcpp::Time timestamp_output = node.override_publishing_stamp_ ?
+  result.latest_ts = latest_ts;
+  result.vo_success = vo_success;
+  result.timestamp_output = node.override_publishing_stamp_ ?
     node.get_clock()->now() : rclcpp::Time(latest_ts);
 
   if (vo_success) {
@@ -805,7 +1669,7 @@ void VisualSlamNode::VisualSlamImpl::UpdatePose(
             node.get_logger()))
     {
       RCLCPP_WARN(node.get_logger(), "Unknown ground constraint Error");
-      return;
+      return false;
     }
 
     // Get VO pose and transform to ROS conventions.
@@ -821,227 +1685,485 @@ void VisualSlamNode::VisualSlamImpl::UpdatePose(
     // Publish Smooth pose if enable_rectified_pose_ = false
     tf2::Transform cv_map_pose_cv_base_link = cv_odom_pose_cv_base_link;
     if (node.enable_localization_n_mapping_) {
+      const auto slam_track_start_time = std::chrono::steady_clock::now();
       try {
-        cuvslam_odometry->GetState(odometry_state);
-        cuvslam::Pose slam_pose = cuvslam_slam->Track(odometry_state);
+        std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+        cuvslam::Pose slam_pose = tracking_backend->TrackSlam();
         cv_map_pose_cv_base_link = FromcuVSLAMPose(slam_pose);
       } catch (const std::exception & e) {
         RCLCPP_WARN(node.get_logger(), "Failed to get SLAM pose: %s", e.what());
-        return;
+        return false;
       }
+      latency_histograms[kSlamTrack].Record(
+        std::chrono::steady_clock::now() - slam_track_start_time);
+    }
+
+    result.odom_pose_base_link = odom_pose_base_link;
+    result.map_pose_base_link = ChangeBasis(canonical_pose_cuvslam, cv_map_pose_cv_base_link);
+    pose_history.Add(latest_ts, odom_pose_base_link, result.map_pose_base_link);
+
+    const auto covariance_transform =
+      FromcuVSLAMCovariance(vo_pose_estimate.world_from_rig.value().covariance);
+    for (size_t i = 0; i < 6 * 6; i++) {
+      result.vo_pose_covariance[i] = covariance_transform(i);
+    }
+
+    // Calculate velocity using last position. The caches are only accessed from the tracking
+    // stage, so everything derived from them is computed here.
+    geometry_msgs::msg::Twist & velocity = result.velocity;
+    pose_cache.Add(latest_ts, odom_pose_base_link);
+    pose_cache.GetVelocity(
+      velocity.linear.x, velocity.linear.y, velocity.linear.z,
+      velocity.angular.x, velocity.angular.y, velocity.angular.z);
+    velocity_cache.Add(
+      velocity.linear.x, velocity.linear.y, velocity.linear.z,
+      velocity.angular.x, velocity.angular.y, velocity.angular.z);
+
+    std::array<double, 6 * 6> covariance{};
+    if (pose_cache.GetCovariance(covariance)) {
+      result.odom_pose_covariance = covariance;
+    }
+    covariance.fill(0.0);
+    if (velocity_cache.GetCovariance(covariance)) {
+      result.odom_twist_covariance = covariance;
     }
 
-    const tf2::Transform map_pose_base_link =
-      ChangeBasis(canonical_pose_cuvslam, cv_map_pose_cv_base_link);
+    const bool propagate_imu = HasSubscribers(subscribed.odometry_imu_rate);
+    if (node.tracking_mode_ == static_cast<int>(TrackingMode::VIO) &&
+      (HasSubscribers(subscribed.gravity) || propagate_imu))
+    {
+      // Empty until cuvslam has aligned the optical and imu sensors.
+      std::optional<cuvslam::Odometry::Gravity> gravity;
+      {
+        std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+        gravity = tracking_backend->GetLastGravity();
+      }
+      if (HasSubscribers(subscribed.gravity)) {
+        result.gravity = gravity;
+      }
+      if (gravity && propagate_imu) {
+        const tf2::Vector3 g_cuvslam((*gravity)[0], (*gravity)[1], (*gravity)[2]);
+        // The twist is in the base frame of the oldest pose it was computed from, so the linear
+        // velocity is taken in the odom frame instead.
+        tf2::Vector3 odom_linear_velocity;
+        pose_cache.GetLinearVelocity(odom_linear_velocity);
+        imu_propagator.Anchor(
+          latest_ts, odom_pose_base_link, odom_linear_velocity,
+          canonical_pose_cuvslam * g_cuvslam);
+      }
+    }
+  }
+
+  result.track_execution_time = stopwatch_track.Seconds();
+  result.tracked_time = std::chrono::steady_clock::now();
+  result.tracking_stage_execution_time =
+    std::chrono::duration<double>(result.tracked_time - stage_start_time).count();
+  result.heap_allocations = GetThreadHeapAllocations() - heap_allocations_start;
+
+  last_track_ts = latest_ts;
+  return true;
+}
+
+void VisualSlamNode::VisualSlamImpl::PublishTrackingResult(const TrackingResult & result)
+{
+  NvtxRangeScoped trace(
+    "VisualSlamNode::VisualSlamImpl::PublishTrackingResult",
+    nvidia::isaac_ros::nitros::CLR_MAGENTA);
+  const auto stage_start_time = std::chrono::steady_clock::now();
+  const uint64_t heap_allocations_start = GetThreadHeapAllocations();
+
+  const rclcpp::Time & timestamp_output = result.timestamp_output;
+  const bool vo_success = result.vo_success;
+
+  // Local readers of the shared memory ring get the result first.
+  if (shm_pose_ring) {
+    WriteShmPoseRecord(result);
+  }
+
+  if (vo_success) {
+    const tf2::Transform & odom_pose_base_link = result.odom_pose_base_link;
+    const tf2::Transform & map_pose_base_link = result.map_pose_base_link;
     const tf2::Transform map_pose_odom = map_pose_base_link * odom_pose_base_link.inverse();
 
-    // Publish transforms to the TF tree.
-    if (node.publish_map_to_odom_tf_) {
+    // Publish transforms to the TF tree, all transforms of the frame in a single message.
+    const auto tf_publish_start_time = std::chrono::steady_clock::now();
+    output_arena.transforms.transforms.clear();
+    if (node.publish_map_to_odom_tf_ &&
+      tf_throttle.ShouldPublishMapToOdom(timestamp_output.nanoseconds(), map_pose_odom))
+    {
       if (!node.invert_map_to_odom_tf_) {
-        PublishFrameTransform(
+        AddFrameTransform(
           timestamp_output, map_pose_odom, node.map_frame_,
           node.odom_frame_);
       } else {
-        PublishFrameTransform(
+        AddFrameTransform(
           timestamp_output,
           map_pose_odom.inverse(), node.odom_frame_, node.map_frame_);
       }
     }
 
-    if (node.publish_odom_to_base_tf_) {
+    if (node.publish_odom_to_base_tf_ &&
+      tf_throttle.ShouldPublishOdomToBase(timestamp_output.nanoseconds()))
+    {
       if (!node.invert_odom_to_base_tf_) {
-        PublishFrameTransform(
+        AddFrameTransform(
           timestamp_output, odom_pose_base_link, node.odom_frame_, node.base_frame_);
       } else {
-        PublishFrameTransform(
+        AddFrameTransform(
           timestamp_output, odom_pose_base_link.inverse(), node.base_frame_, node.odom_frame_);
       }
     }
+    if (!output_arena.transforms.transforms.empty()) {
+      tf_publisher->publish(output_arena.transforms);
+    }
+    const auto message_publish_start_time = std::chrono::steady_clock::now();
+    latency_histograms[kTfPublish].Record(message_publish_start_time - tf_publish_start_time);
 
-    // Calculate velocity using last position.
-    pose_cache.Add(latest_ts, odom_pose_base_link);
-    geometry_msgs::msg::Twist velocity;
-    pose_cache.GetVelocity(
-      velocity.linear.x, velocity.linear.y, velocity.linear.z,
-      velocity.angular.x, velocity.angular.y, velocity.angular.z);
-    velocity_cache.Add(
-      velocity.linear.x, velocity.linear.y, velocity.linear.z,
-      velocity.angular.x, velocity.angular.y, velocity.angular.z);
+    const geometry_msgs::msg::Twist & velocity = result.velocity;
 
     // Prepare message parts needed for VO messages.
     PoseType vo_pose;
     tf2::toMsg(odom_pose_base_link, vo_pose);
-    std_msgs::msg::Header header_odom;
-    header_odom.stamp = timestamp_output;
-    header_odom.frame_id = node.odom_frame_;
 
     // Prepare message parts needed for SLAM messages.
     PoseType slam_pose;
     tf2::toMsg(map_pose_base_link, slam_pose);
-    std_msgs::msg::Header header_map;
-    header_map.stamp = timestamp_output;
-    header_map.frame_id = node.map_frame_;
 
-    if (HasSubscribers(node.tracking_vo_pose_pub_)) {
+    // Without loaned messages or intra-process subscribers the messages are taken from the output
+    // arena and published by reference, their headers are overwritten in place.
+    if (HasSubscribers(subscribed.vo_pose)) {
       // Tracking_vo_pose_pub_
-      auto pose_only = std::make_unique<PoseStampedType>();
-      pose_only->header = header_odom;
-      pose_only->pose = vo_pose;
-      node.tracking_vo_pose_pub_->publish(std::move(pose_only));
+      PublishFrameMessage(
+        *node.tracking_vo_pose_pub_, subscribed.vo_pose_intra_process, output_arena.vo_pose,
+        [&](PoseStampedType & pose_only) {
+          SetHeader(pose_only.header, timestamp_output, node.odom_frame_);
+          pose_only.pose = vo_pose;
+        });
     }
-    if (HasSubscribers(node.tracking_vo_pose_covariance_pub_)) {
+    if (HasSubscribers(subscribed.vo_pose_covariance)) {
       // Tracking_vo_covariance_pub_
-      auto pose_n_cov = std::make_unique<PoseWithCovarianceStampedType>();
-      pose_n_cov->header = header_odom;
-      pose_n_cov->pose.pose = vo_pose;
-      auto covariance_transform =
-        FromcuVSLAMCovariance(vo_pose_estimate.world_from_rig.value().covariance);
-      for (size_t i = 0; i < 6 * 6; i++) {
-        pose_n_cov->pose.covariance[i] = covariance_transform(i);
-      }
-      node.tracking_vo_pose_covariance_pub_->publish(std::move(pose_n_cov));
+      PublishFrameMessage(
+        *node.tracking_vo_pose_covariance_pub_, subscribed.vo_pose_covariance_intra_process,
+        output_arena.vo_pose_covariance, [&](PoseWithCovarianceStampedType & pose_n_cov) {
+          SetHeader(pose_n_cov.header, timestamp_output, node.odom_frame_);
+          pose_n_cov.pose.pose = vo_pose;
+          pose_n_cov.pose.covariance = result.vo_pose_covariance;
+        });
     }
-    if (HasSubscribers(node.tracking_odometry_pub_)) {
-      OdometryType odom;
-      odom.header = header_odom;
-      odom.child_frame_id = node.base_frame_;
-
-      odom.pose.pose = vo_pose;
-      bool res = pose_cache.GetCovariance(odom.pose.covariance);
-      if (!res) {
-        // set default Identity matrix
-        for (int i = 0; i < 6; i++) {
-          for (int j = 0; j < 6; j++) {
-            odom.pose.covariance[i * 6 + j] = i == j ? 1 : 0;
+    if (HasSubscribers(subscribed.odometry)) {
+      PublishFrameMessage(
+        *node.tracking_odometry_pub_, subscribed.odometry_intra_process, output_arena.odometry,
+        [&](OdometryType & odom) {
+          SetHeader(odom.header, timestamp_output, node.odom_frame_);
+          odom.child_frame_id = node.base_frame_;
+
+          odom.pose.pose = vo_pose;
+          if (result.odom_pose_covariance) {
+            odom.pose.covariance = *result.odom_pose_covariance;
+          } else {
+            // set default Identity matrix
+            for (int i = 0; i < 6; i++) {
+              for (int j = 0; j < 6; j++) {
+                odom.pose.covariance[i * 6 + j] = i == j ? 1 : 0;
+              }
+            }
           }
-        }
-      }
-
-      odom.twist.twist.linear = velocity.linear;
-      odom.twist.twist.angular = velocity.angular;
 
-      res = velocity_cache.GetCovariance(odom.twist.covariance);
-      if (!res) {
-        // set default Identity matrix
-        for (int i = 0; i < 6; i++) {
-          for (int j = 0; j < 6; j++) {
-            odom.twist.covariance[i * 6 + j] = i == j ? 1 : 0;
+          odom.twist.twist.linear = velocity.linear;
+          odom.twist.twist.angular = velocity.angular;
+
+          if (result.odom_twist_covariance) {
+            odom.twist.covariance = *result.odom_twist_covariance;
+          } else {
+            // set default Identity matrix
+            for (int i = 0; i < 6; i++) {
+              for (int j = 0; j < 6; j++) {
+                odom.twist.covariance[i * 6 + j] = i == j ? 1 : 0;
+              }
+            }
           }
-        }
-      }
-      node.tracking_odometry_pub_->publish(odom);
+        });
     }
-    if (HasSubscribers(node.vis_vo_velocity_pub_)) {
+    if (HasSubscribers(subscribed.vo_velocity)) {
       PublishOdometryVelocity(
         timestamp_output,
         node.base_frame_,
+        velocity,
         node.vis_vo_velocity_pub_);
     }
-    if (HasSubscribers(node.vis_slam_odometry_pub_)) {
-      OdometryType odom;
-      odom.header = header_map;
-      odom.child_frame_id = node.base_frame_;
-
-      // only populating slam_pose for viz
-      odom.pose.pose = slam_pose;
-      node.vis_slam_odometry_pub_->publish(odom);
-    }
-    if (HasSubscribers(node.tracking_vo_path_pub_)) {
-      // Tracking_vo_path_pub_
-      PoseStampedType pose_stamped;
-      pose_stamped.header = header_odom;
-      pose_stamped.pose = vo_pose;
-      vo_path.add(pose_stamped);
-
-      auto path_msg = std::make_unique<PathType>();
-      path_msg->header = header_odom;
-      path_msg->poses = vo_path.getData();
-      node.tracking_vo_path_pub_->publish(std::move(path_msg));
-    }
-    if (HasSubscribers(node.tracking_slam_path_pub_)) {
-      // Tracking_slam_path_pub_
-      PoseStampedType pose_stamped;
-      pose_stamped.header = header_map;
-      pose_stamped.pose = slam_pose;
-      slam_path.add(pose_stamped);
-
-      auto path_msg = std::make_unique<PathType>();
-      path_msg->header = header_map;
-      path_msg->poses = slam_path.getData();
-      node.tracking_slam_path_pub_->publish(std::move(path_msg));
+    if (HasSubscribers(subscribed.slam_odometry)) {
+      PublishFrameMessage(
+        *node.vis_slam_odometry_pub_, subscribed.slam_odometry_intra_process,
+        output_arena.slam_odometry, [&](OdometryType & odom) {
+          SetHeader(odom.header, timestamp_output, node.map_frame_);
+          odom.child_frame_id = node.base_frame_;
+
+          // only populating slam_pose for viz
+          odom.pose.pose = slam_pose;
+          odom.pose.covariance.fill(0.0);
+          odom.twist = geometry_msgs::msg::TwistWithCovariance();
+        });
     }
+    UpdatePath(
+      timestamp_output, node.odom_frame_, vo_pose, vo_path, vo_path_state,
+      node.tracking_vo_path_pub_, node.tracking_vo_path_delta_pub_);
+    UpdatePath(
+      timestamp_output, node.map_frame_, slam_pose, slam_path, slam_path_state,
+      node.tracking_slam_path_pub_, node.tracking_slam_path_delta_pub_);
 
     // Draw gravity vector
-    if (HasSubscribers(node.vis_gravity_pub_) &&
-      node.tracking_mode_ == static_cast<int>(TrackingMode::VIO))
-    {
+    if (result.gravity && HasSubscribers(subscribed.gravity)) {
       PublishGravity(
         timestamp_output,
         node.base_frame_,
+        *result.gravity,
         node.vis_gravity_pub_);
     }
+    latency_histograms[kMessagePublish].Record(
+      std::chrono::steady_clock::now() - message_publish_start_time);
   }
 
   // Calculate the tracking execution time statistics.
-  ssw.Stop();
-  const double track_execution_time = stopwatch_track.Seconds();
+  const double track_execution_time = result.track_execution_time;
   track_execution_times.add(track_execution_time);
   double track_execution_time_max = 0;
   double track_execution_time_mean = 0;
-  const auto & values = track_execution_times.getData();
-  for (double t : values) {
-    track_execution_time_max = std::max(track_execution_time_max, t);
-    track_execution_time_mean += t;
+  for (size_t i = 0; i < track_execution_times.size(); i++) {
+    track_execution_time_max = std::max(track_execution_time_max, track_execution_times[i]);
+    track_execution_time_mean += track_execution_times[i];
   }
-  if (values.size()) {
-    track_execution_time_mean /= values.size();
+  if (track_execution_times.size()) {
+    track_execution_time_mean /= track_execution_times.size();
   }
+  // In pipelined mode this is the end-to-end time including the time spent in the queues.
+  const double node_callback_execution_time =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - result.start_time).count();
+  const double output_queue_latency =
+    std::chrono::duration<double>(stage_start_time - result.tracked_time).count();
+  // Start a new latency window, so that the percentiles follow recent regressions.
+  if (node.latency_window_s_ > 0.0 &&
+    std::chrono::duration<double>(stage_start_time - latency_window_start).count() >=
+    node.latency_window_s_)
+  {
+    for (LatencyHistogram & histogram : latency_histograms) {
+      histogram.Rotate();
+    }
+    latency_window_start = stage_start_time;
+  }
+
   // Publish status.
-  std_msgs::msg::Header header;
-  header.stamp = timestamp_output;
-  header.frame_id = node.map_frame_;
-  if (HasSubscribers(node.visual_slam_status_pub_)) {
-    VisualSlamStatusType visual_slam_status_msg;
-    visual_slam_status_msg.header = header;
-    visual_slam_status_msg.vo_state = vo_success ? 1 : 2;
-    visual_slam_status_msg.node_callback_execution_time = stopwatch.Seconds();
-    visual_slam_status_msg.track_execution_time = track_execution_time;
-    visual_slam_status_msg.track_execution_time_max = track_execution_time_max;
-    visual_slam_status_msg.track_execution_time_mean = track_execution_time_mean;
-    node.visual_slam_status_pub_->publish(visual_slam_status_msg);
+  VisualSlamStatusType * visual_slam_status_msg = nullptr;
+  if (HasSubscribers(subscribed.status)) {
+    visual_slam_status_msg = &output_arena.status;
+    SetHeader(visual_slam_status_msg->header, timestamp_output, node.map_frame_);
+    visual_slam_status_msg->vo_state = vo_success ? 1 : 2;
+    visual_slam_status_msg->node_callback_execution_time = node_callback_execution_time;
+    visual_slam_status_msg->track_execution_time = track_execution_time;
+    visual_slam_status_msg->track_execution_time_max = track_execution_time_max;
+    visual_slam_status_msg->track_execution_time_mean = track_execution_time_mean;
+    if (node.enable_pipelined_tracking_) {
+      visual_slam_status_msg->tracking_queue_depth = tracking_queue.Size();
+      visual_slam_status_msg->tracking_queue_drops = tracking_queue.Drops();
+      visual_slam_status_msg->output_queue_depth = output_queue.Size();
+      visual_slam_status_msg->output_queue_drops = output_queue.Drops();
+      visual_slam_status_msg->tracking_queue_latency = result.tracking_queue_latency;
+      visual_slam_status_msg->tracking_stage_execution_time =
+        result.tracking_stage_execution_time;
+      visual_slam_status_msg->output_queue_latency = output_queue_latency;
+    }
   }
   // Publish diagnostics.
-  if (HasSubscribers(node.diagnostics_pub_)) {
-    DiagnosticArrayType diagnostics;
-    diagnostics.header = header;
-    DiagnosticStatusType & status = diagnostics.status.emplace_back();
+  DiagnosticStatusType * status = nullptr;
+  size_t value_index = 0;
+  if (HasSubscribers(subscribed.diagnostics)) {
+    DiagnosticArrayType & diagnostics = output_arena.diagnostics;
+    SetHeader(diagnostics.header, timestamp_output, node.map_frame_);
+    status = &diagnostics.status[0];
     if (vo_success) {
-      status.level = diagnostic_msgs::msg::DiagnosticStatus::OK;
+      status->level = diagnostic_msgs::msg::DiagnosticStatus::OK;
     } else {
-      status.level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+      status->level = diagnostic_msgs::msg::DiagnosticStatus::WARN;
+    }
+    status->name = "Visual Slam Diagnostics";
+    status->message = "Tracking state and execution time measurements";
+    status->hardware_id = "visual_slam";
+    SetDiagnosticValue(*status, value_index++, "vo_status", vo_success ? "OK" : "Lost");
+    SetDiagnosticValue(*status, value_index++, "track_execution_time", track_execution_time);
+    SetDiagnosticValue(
+      *status, value_index++, "track_execution_time_max", track_execution_time_max);
+    SetDiagnosticValue(
+      *status, value_index++, "track_execution_time_mean", track_execution_time_mean);
+    SetDiagnosticValue(
+      *status, value_index++, "localized_in_exist_map", localized_in_exist_map_ ? "Yes" : "No");
+    if (node.enable_pipelined_tracking_) {
+      SetDiagnosticValue(
+        *status, value_index++, "tracking_queue_depth",
+        static_cast<uint64_t>(tracking_queue.Size()));
+      SetDiagnosticValue(
+        *status, value_index++, "tracking_queue_drops",
+        static_cast<uint64_t>(tracking_queue.Drops()));
+      SetDiagnosticValue(
+        *status, value_index++, "output_queue_drops",
+        static_cast<uint64_t>(output_queue.Drops()));
+      SetDiagnosticValue(
+        *status, value_index++, "tracking_queue_latency", result.tracking_queue_latency);
+      SetDiagnosticValue(*status, value_index++, "output_queue_latency", output_queue_latency);
+    }
+    if (node.enable_adaptive_sync_) {
+      const SyncTuner::Statistics sync_statistics = sync_tuner.GetStatistics();
+      SetDiagnosticValue(
+        *status, value_index++, "sync_matching_threshold_ms",
+        sync_statistics.config.matching_threshold_ns * 1e-6);
+      SetDiagnosticValue(
+        *status, value_index++, "sync_buffer_size",
+        static_cast<uint64_t>(sync_statistics.config.buffer_size));
+      SetDiagnosticValue(
+        *status, value_index++, "sync_camera_period_ms", sync_statistics.max_period_ms);
+      SetDiagnosticValue(
+        *status, value_index++, "sync_camera_jitter_ms", sync_statistics.max_jitter_ms);
+      SetDiagnosticValue(*status, value_index++, "sync_camera_skew_ms", sync_statistics.skew_ms);
+      SetDiagnosticValue(
+        *status, value_index++, "sync_camera_skew_peak_ms", sync_statistics.skew_peak_ms);
+      SetDiagnosticValue(
+        *status, value_index++, "sync_wait_peak_ms", sync_statistics.sync_wait_peak_ms);
+      SetDiagnosticValue(*status, value_index++, "sync_retunes", sync_statistics.num_retunes);
+    }
+    if (node.decouple_masks_and_depth_) {
+      SetDiagnosticValue(
+        *status, value_index++, "side_channel_misses", num_side_channel_misses.load());
+    }
+    if (node.enable_camera_dropout_handling_) {
+      SetDiagnosticValue(
+        *status, value_index++, "sync_degraded_streams",
+        static_cast<uint64_t>(dropout_sync->NumDegraded()));
+      SetDiagnosticValue(
+        *status, value_index++, "sync_partial_frame_sets", dropout_sync->NumPartial());
+      SetDiagnosticValue(
+        *status, value_index++, "sync_dropped_frame_sets", dropout_sync->NumDropped());
     }
-    status.name = "Visual Slam Diagnostics";
-    status.message = "Tracking state and execution time measurements";
-    status.hardware_id = "visual_slam";
-    status.values.emplace_back();
-    status.values.back().key = "vo_status";
-    status.values.back().value = vo_success ? "OK" : "Lost";
-    status.values.emplace_back();
-    status.values.back().key = "track_execution_time";
-    status.values.back().value = std::to_string(track_execution_time);
-    status.values.emplace_back();
-    status.values.back().key = "track_execution_time_max";
-    status.values.back().value = std::to_string(track_execution_time_max);
-    status.values.emplace_back();
-    status.values.back().key = "track_execution_time_mean";
-    status.values.back().value = std::to_string(track_execution_time_mean);
-    status.values.emplace_back();
-    status.values.back().key = "localized_in_exist_map";
-    status.values.back().value = localized_in_exist_map_ ? "Yes" : "No";
-    node.diagnostics_pub_->publish(diagnostics);
+  }
+  if (visual_slam_status_msg || status) {
+    value_index = AddLatencyStatistics(visual_slam_status_msg, status, value_index);
+  }
+  if (visual_slam_status_msg) {
+    PublishFrameMessage(
+      *node.visual_slam_status_pub_, subscribed.status_intra_process, output_arena.status,
+      [&](VisualSlamStatusType & msg) {
+        // The status was assembled in the output arena, other targets get a copy.
+        if (&msg != visual_slam_status_msg) {
+          msg = *visual_slam_status_msg;
+        }
+      });
+  }
+  if (status) {
+    status->values.resize(value_index);
+    node.diagnostics_pub_->publish(output_arena.diagnostics);
   }
 
-  last_track_ts = latest_ts;
+  frame_heap_allocations +=
+    result.heap_allocations + GetThreadHeapAllocations() - heap_allocations_start;
+  if (num_published_frames++ == 0 && !startup_timeline.reported) {
+    ReportStartupTimeline();
+  }
+}
+
+size_t VisualSlamNode::VisualSlamImpl::AddLatencyStatistics(
+  VisualSlamStatusType * visual_slam_status_msg,
+  DiagnosticStatusType * diagnostic_status, size_t value_index) const
+{
+  std::array<LatencyPercentilesType, kNumLatencyStages> stage_latencies;
+  for (size_t stage = 0; stage < kNumLatencyStages; stage++) {
+    const LatencyHistogram & histogram = latency_histograms[stage];
+    const auto percentiles = histogram.Percentiles(kLatencyQuantiles);
+    LatencyPercentilesType & latency = stage_latencies[stage];
+    latency.count = histogram.Count();
+    latency.p50 = percentiles[0];
+    latency.p90 = percentiles[1];
+    latency.p99 = percentiles[2];
+    latency.p99_9 = percentiles[3];
+    latency.max = histogram.MaxSeconds();
+  }
+
+  if (visual_slam_status_msg) {
+    visual_slam_status_msg->sync_wait_latency = stage_latencies[kSyncWait];
+    visual_slam_status_msg->sequencer_wait_latency = stage_latencies[kSequencerWait];
+    visual_slam_status_msg->imu_registration_latency = stage_latencies[kImuRegistration];
+    visual_slam_status_msg->image_conversion_latency = stage_latencies[kImageConversion];
+    visual_slam_status_msg->odometry_track_latency = stage_latencies[kOdometryTrack];
+    visual_slam_status_msg->slam_track_latency = stage_latencies[kSlamTrack];
+    visual_slam_status_msg->tf_publish_latency = stage_latencies[kTfPublish];
+    visual_slam_status_msg->message_publish_latency = stage_latencies[kMessagePublish];
+  }
+  if (diagnostic_status) {
+    for (size_t stage = 0; stage < kNumLatencyStages; stage++) {
+      const double values[] = {
+        stage_latencies[stage].p50, stage_latencies[stage].p90, stage_latencies[stage].p99,
+        stage_latencies[stage].p99_9};
+      for (size_t i = 0; i < kLatencyQuantiles.size(); i++) {
+        // The key is assembled on the stack to not create temporary strings.
+        char key[64];
+        std::snprintf(
+          key, sizeof(key), "%s_%s", kLatencyStageNames[stage], kLatencyQuantileNames[i]);
+        SetDiagnosticValue(*diagnostic_status, value_index++, key, values[i]);
+      }
+    }
+  }
+  return value_index;
+}
+
+void VisualSlamNode::VisualSlamImpl::StartPipeline()
+{
+  tracking_queue.Restart();
+  output_queue.Restart();
+  tracking_thread = std::thread(&VisualSlamNode::VisualSlamImpl::RunTrackingStage, this);
+  output_thread = std::thread(&VisualSlamNode::VisualSlamImpl::RunOutputStage, this);
+}
+
+void VisualSlamNode::VisualSlamImpl::StopPipeline()
+{
+  tracking_queue.Stop();
+  output_queue.Stop();
+  if (tracking_thread.joinable()) {
+    tracking_thread.join();
+  }
+  if (output_thread.joinable()) {
+    output_thread.join();
+  }
+}
+
+void VisualSlamNode::VisualSlamImpl::RunTrackingStage()
+{
+  FrameSet frame_set;
+  while (tracking_queue.Pop(frame_set)) {
+    TrackingResult result;
+    result.start_time = frame_set.enqueue_time;
+    result.tracking_queue_latency = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - frame_set.enqueue_time).count();
+    try {
+      const BatchView<ImuSample> imu_samples(
+        frame_set.imu_samples.data(), frame_set.imu_samples.size());
+      if (TrackFrame(imu_samples, frame_set.idx_and_image_msgs, result)) {
+        output_queue.Push(result);
+      }
+    } catch (const std::exception & e) {
+      RCLCPP_WARN(node.get_logger(), "Tracking stage has failed: %s", e.what());
+    }
+    // Release the images before waiting for the next frame set.
+    frame_set.imu_samples.clear();
+    frame_set.idx_and_image_msgs.clear();
+  }
+}
+
+void VisualSlamNode::VisualSlamImpl::RunOutputStage()
+{
+  TrackingResult result;
+  while (output_queue.Pop(result)) {
+    try {
+      PublishTrackingResult(result);
+    } catch (const std::exception & e) {
+      RCLCPP_WARN(node.get_logger(), "Output stage has failed: %s", e.what());
+    }
+  }
 }
 
 
@@ -1064,10 +2186,14 @@ bool VisualSlamNode::VisualSlamImpl::SaveMap(const std::string & map_folder_path
     return false;
   }
 
-  // Trigger the saving asynchronously. Error handling is done in the callback.
-  cuvslam_slam->SaveMap(map_folder_path, [&response_promise](bool success) {
-      response_promise.set_value(success);
-  });
+  // Trigger the saving asynchronously. Error handling is done in the callback. The lock is not
+  // held while waiting, the callback may be called from the tracking thread.
+  {
+    std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+    tracking_backend->SaveMap(map_folder_path, [&response_promise](bool success) {
+        response_promise.set_value(success);
+    });
+  }
 
   // Wait for the save operation to complete, so that response_promise is not destroyed
   // before the callback is called.
@@ -1131,10 +2257,6 @@ VisualSlamImpl::CuvslamInternalLocalizeInMapAsync(
     "Map folder '%s' exists and contains database files. Starting async localization...",
     map_folder_path.c_str());
 
-  // For async localization, we don't need to provide images immediately
-  // The localization will use images from normal tracking operations
-  std::vector<cuvslam::Image> empty_images;
-
   cuvslam::Slam::LocalizationSettings localization_settings;
   localization_settings.horizontal_search_radius = node.localizer_horizontal_radius_;
   localization_settings.vertical_search_radius = node.localizer_vertical_radius_;
@@ -1145,15 +2267,18 @@ VisualSlamImpl::CuvslamInternalLocalizeInMapAsync(
 
   // NOTE: Even if LocalizeInMap fails, we still expect it to call the callback.
   // We rely on the callback to set the value of the response_promise.
-  cuvslam_slam->LocalizeInMap(map_folder_path, pose_hint, empty_images, localization_settings,
-    [this](const cuvslam::Result<cuvslam::Pose> & result) {
-      LocalizeInExistDbContext::Response response{boost::outcome_v2::failure(std::string(
-              result.error_message))};
-      if (result.data.has_value()) {
-        response = boost::outcome_v2::success<cuvslam::Pose>(result.data.value());
-      }
-      localize_in_exist_db_context.response_promise.set_value(response);
-  });
+  {
+    std::lock_guard<std::mutex> lock(tracking_backend_mutex);
+    tracking_backend->LocalizeInMap(map_folder_path, pose_hint, localization_settings,
+      [this](const cuvslam::Result<cuvslam::Pose> & result) {
+        LocalizeInExistDbContext::Response response{boost::outcome_v2::failure(std::string(
+                result.error_message))};
+        if (result.data.has_value()) {
+          response = boost::outcome_v2::success<cuvslam::Pose>(result.data.value());
+        }
+        localize_in_exist_db_context.response_promise.set_value(response);
+    });
+  }
 
   // The async localization callback will be triggered during normal tracking operations
   // when CUVSLAM_Track is called with real images
@@ -15,6 +15,8 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <chrono>
+#include <mutex>
 #include <string>
 
 #include "isaac_ros_visual_slam/impl/viz_helper.hpp"
@@ -27,8 +29,9 @@ namespace visual_slam
 {
 
 // VisHelper
-VisHelper::VisHelper()
-: logger_(rclcpp::get_logger("VisualSlam: VisHelper"))
+VisHelper::VisHelper(VisScheduler & scheduler, SubscriberPresence & presence, int priority)
+: scheduler_(scheduler), presence_(presence), priority_(priority),
+  logger_(rclcpp::get_logger("VisualSlam: VisHelper"))
 {}
 
 void VisHelper::Init(
@@ -43,27 +46,35 @@ void VisHelper::Init(
   logger_ = logger;
 }
 
+void VisHelper::Start(uint32_t period_ms)
+{
+  task_id_ = scheduler_.Add(
+    [this]() {
+      std::lock_guard<std::mutex> locker(mutex_);
+      // cuvslam_slam_ will be null after Exit() was called
+      if (!cuvslam_slam_ || !rclcpp::ok()) {
+        return;
+      }
+      Run();
+    }, std::chrono::milliseconds(period_ms), priority_);
+}
+
 void VisHelper::Exit()
 {
   if (!cuvslam_slam_) {
     return;
   }
-  {
-    std::unique_lock<std::mutex> locker(mutex_);
-
-    Reset();
+  // Waits for a running invocation, Run() must not see the state released below.
+  if (task_id_) {
+    scheduler_.Remove(*task_id_);
+    task_id_.reset();
+  }
+  std::unique_lock<std::mutex> locker(mutex_);
 
-    cuvslam_slam_.reset();
-    frame_id_ = "";
+  Reset();
 
-    cond_var_.notify_all();
-  }
-  try {
-    if (thread_.joinable()) {
-      thread_.join();
-    }
-  } catch (std::system_error & e) {
-  }
+  cuvslam_slam_.reset();
+  frame_id_ = "";
 }
 
 }  // namespace visual_slam
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Microbenchmark of the landmark point cloud encoding of LandmarksVisHelper.
+//
+// Compares LandmarksVisHelper::EncodeLandmarks with the previous per point implementation, which
+// used PointCloud2Iterators, tf2 transforms and a std::mt19937 per landmark for the color.
+//
+// Usage:
+//   landmark_encoder_bench [--points <n>] [--iterations <n>]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
+#include "isaac_ros_visual_slam/impl/landmarks_vis_helper.hpp"
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+using LandmarkList = LandmarksVisHelper::LandmarkList;
+
+// The encoder as it was before EncodeLandmarks, kept as the baseline.
+void EncodeLandmarksBaseline(
+  const LandmarkList & landmarks, LandmarksVisHelper::ColorMode color_mode,
+  const tf2::Transform & canonical_pose_cuvslam, PointCloud2Type & cloud)
+{
+  cloud.height = 1;
+  cloud.width = landmarks.size();
+  cloud.is_bigendian = false;
+  cloud.is_dense = false;
+
+  sensor_msgs::PointCloud2Modifier modifier(cloud);
+  modifier.setPointCloud2Fields(
+    4,
+    "x", 1, sensor_msgs::msg::PointField::FLOAT32,
+    "y", 1, sensor_msgs::msg::PointField::FLOAT32,
+    "z", 1, sensor_msgs::msg::PointField::FLOAT32,
+    "rgb", 1, sensor_msgs::msg::PointField::UINT32);
+  modifier.resize(landmarks.size());
+
+  sensor_msgs::PointCloud2Iterator<float> iter_x(cloud, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(cloud, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(cloud, "z");
+  sensor_msgs::PointCloud2Iterator<uint32_t> iter_rgb(cloud, "rgb");
+
+  for (uint32_t i = 0; i < landmarks.size(); i++, ++iter_x, ++iter_y, ++iter_z, ++iter_rgb) {
+    tf2::Vector3 xyz(landmarks[i].coords[0], landmarks[i].coords[1], landmarks[i].coords[2]);
+    xyz = canonical_pose_cuvslam * xyz;
+    *iter_x = xyz[0];
+    *iter_y = xyz[1];
+    *iter_z = xyz[2];
+
+    std::mt19937 generator(landmarks[i].id);
+    std::uniform_int_distribution<int> distribution(92, 255);
+    uint32_t rgb = 0xFF000000;
+    if (color_mode == LandmarksVisHelper::CM_RGB_MODE) {
+      rgb |= (distribution(generator) << 16) + (distribution(generator) << 8) +
+        distribution(generator);
+    } else {
+      const int bw = distribution(generator);
+      rgb |= (bw << 16) + (bw << 8) + bw;
+    }
+    *iter_rgb = rgb;
+  }
+}
+
+template<class Encoder>
+double MeasurePointsPerSecond(
+  const LandmarkList & landmarks, size_t iterations, LandmarksVisHelper::ColorMode color_mode,
+  Encoder encoder)
+{
+  PointCloud2Type cloud;
+  // Untimed first run, so that both encoders start with an allocated buffer.
+  encoder(landmarks, color_mode, canonical_pose_cuvslam, cloud);
+  const auto start_time = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    encoder(landmarks, color_mode, canonical_pose_cuvslam, cloud);
+  }
+  const double seconds =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  return seconds > 0 ? landmarks.size() * iterations / seconds : 0;
+}
+
+}  // namespace
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+int main(int argc, char * argv[])
+{
+  using nvidia::isaac_ros::visual_slam::LandmarksVisHelper;
+
+  size_t num_points = 32 * 1024;
+  size_t iterations = 200;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string key = argv[i];
+    if (key == "--points") {
+      num_points = std::stoul(argv[i + 1]);
+    } else if (key == "--iterations") {
+      iterations = std::stoul(argv[i + 1]);
+    } else {
+      std::fprintf(stderr, "Unknown argument: %s\n", key.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> coordinate(-50.f, 50.f);
+  LandmarksVisHelper::LandmarkList landmarks(num_points);
+  for (size_t i = 0; i < num_points; i++) {
+    landmarks[i].id = i;
+    landmarks[i].weight = 0.5f;
+    landmarks[i].coords[0] = coordinate(generator);
+    landmarks[i].coords[1] = coordinate(generator);
+    landmarks[i].coords[2] = coordinate(generator);
+  }
+
+  std::printf("%zu points, %zu iterations\n", num_points, iterations);
+  const std::pair<const char *, LandmarksVisHelper::ColorMode> color_modes[] = {
+    {"rgb", LandmarksVisHelper::CM_RGB_MODE},
+    {"bw", LandmarksVisHelper::CM_BW_MODE},
+  };
+  for (const auto & [name, color_mode] : color_modes) {
+    const double baseline = nvidia::isaac_ros::visual_slam::MeasurePointsPerSecond(
+      landmarks, iterations, color_mode, nvidia::isaac_ros::visual_slam::EncodeLandmarksBaseline);
+    const double encoder = nvidia::isaac_ros::visual_slam::MeasurePointsPerSecond(
+      landmarks, iterations, color_mode, &LandmarksVisHelper::EncodeLandmarks);
+    std::printf("%-4s baseline: %8.2f Mpoints/s  EncodeLandmarks: %8.2f Mpoints/s  (%.1fx)\n",
+      name, baseline * 1e-6, encoder * 1e-6, baseline > 0 ? encoder / baseline : 0);
+  }
+  return 0;
+}
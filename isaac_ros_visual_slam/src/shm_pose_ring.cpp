@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "isaac_ros_visual_slam/shm_pose_ring.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+std::string ShmName(const std::string & name)
+{
+  return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+size_t RingSize(uint32_t capacity)
+{
+  return sizeof(ShmPoseRingHeader) + capacity * sizeof(ShmPoseRingSlot);
+}
+
+ShmPoseRingSlot * Slots(void * memory)
+{
+  return reinterpret_cast<ShmPoseRingSlot *>(
+    static_cast<char *>(memory) + sizeof(ShmPoseRingHeader));
+}
+
+// Maps the file descriptor and closes it.
+void * Map(int fd, size_t size, int protection, const std::string & name)
+{
+  void * memory = mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+  const int error = errno;
+  close(fd);
+  if (memory == MAP_FAILED) {
+    throw std::system_error(error, std::generic_category(), "mmap of " + name);
+  }
+  return memory;
+}
+
+}  // namespace
+
+ShmPoseRingWriter::ShmPoseRingWriter(const std::string & name, uint32_t capacity)
+: name_(ShmName(name))
+{
+  capacity = std::max<uint32_t>(capacity, 1);
+  size_ = RingSize(capacity);
+
+  // Replace a ring that was left behind, readers of it keep their mapping.
+  shm_unlink(name_.c_str());
+  const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "shm_open of " + name_);
+  }
+  if (ftruncate(fd, size_) != 0) {
+    const int error = errno;
+    close(fd);
+    shm_unlink(name_.c_str());
+    throw std::system_error(error, std::generic_category(), "ftruncate of " + name_);
+  }
+  void * memory = nullptr;
+  try {
+    memory = Map(fd, size_, PROT_READ | PROT_WRITE, name_);
+  } catch (...) {
+    shm_unlink(name_.c_str());
+    throw;
+  }
+
+  // The memory is zero filled, the atomics are constructed in place.
+  header_ = new (memory) ShmPoseRingHeader;
+  slots_ = Slots(memory);
+  for (uint32_t i = 0; i < capacity; i++) {
+    new (&slots_[i]) ShmPoseRingSlot;
+    slots_[i].sequence.store(0, std::memory_order_relaxed);
+  }
+  header_->capacity = capacity;
+  header_->record_size = sizeof(ShmPoseRecord);
+  header_->version = ShmPoseRingHeader::kVersion;
+  header_->num_written.store(0, std::memory_order_relaxed);
+  // Readers check the magic last, it is published with the release store.
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = ShmPoseRingHeader::kMagic;
+}
+
+ShmPoseRingWriter::~ShmPoseRingWriter()
+{
+  munmap(header_, size_);
+  shm_unlink(name_.c_str());
+}
+
+void ShmPoseRingWriter::Write(const ShmPoseRecord & record)
+{
+  const uint64_t index = header_->num_written.load(std::memory_order_relaxed);
+  ShmPoseRingSlot & slot = slots_[index % header_->capacity];
+  // Odd while the record is written. The fence keeps the record writes after the store.
+  slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&slot.record, &record, sizeof(record));
+  slot.sequence.store(2 * (index + 1), std::memory_order_release);
+  header_->num_written.store(index + 1, std::memory_order_release);
+}
+
+ShmPoseRingReader::ShmPoseRingReader(const std::string & name)
+{
+  const std::string shm_name = ShmName(name);
+  const int fd = shm_open(shm_name.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "shm_open of " + shm_name);
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    const int error = errno;
+    close(fd);
+    throw std::system_error(error, std::generic_category(), "fstat of " + shm_name);
+  }
+  size_ = file_stat.st_size;
+  if (size_ < sizeof(ShmPoseRingHeader)) {
+    close(fd);
+    throw std::runtime_error(shm_name + " is not a pose ring");
+  }
+  const void * memory = Map(fd, size_, PROT_READ, shm_name);
+  header_ = static_cast<const ShmPoseRingHeader *>(memory);
+  slots_ = Slots(const_cast<void *>(memory));
+
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (header_->magic != ShmPoseRingHeader::kMagic ||
+    header_->version != ShmPoseRingHeader::kVersion ||
+    header_->record_size != sizeof(ShmPoseRecord) || header_->capacity == 0 ||
+    size_ < RingSize(header_->capacity))
+  {
+    munmap(const_cast<void *>(memory), size_);
+    throw std::runtime_error(shm_name + " is not a pose ring of version " +
+            std::to_string(ShmPoseRingHeader::kVersion));
+  }
+  // Start with the records that are still in the ring.
+  const uint64_t num_written = NumWritten();
+  next_index_ = num_written > header_->capacity ? num_written - header_->capacity : 0;
+}
+
+ShmPoseRingReader::~ShmPoseRingReader()
+{
+  munmap(const_cast<ShmPoseRingHeader *>(header_), size_);
+}
+
+uint64_t ShmPoseRingReader::NumWritten() const
+{
+  return header_->num_written.load(std::memory_order_acquire);
+}
+
+ShmPoseRingReader::ReadResult ShmPoseRingReader::Read(
+  uint64_t index, ShmPoseRecord & record) const
+{
+  const ShmPoseRingSlot & slot = slots_[index % header_->capacity];
+  while (true) {
+    const uint64_t sequence_before = slot.sequence.load(std::memory_order_acquire);
+    if (sequence_before < 2 * (index + 1)) {
+      return ReadResult::kNotWritten;
+    }
+    if (sequence_before > 2 * (index + 1)) {
+      return ReadResult::kOverwritten;
+    }
+    std::memcpy(&record, &slot.record, sizeof(record));
+    // The fence keeps the record reads before the second load of the sequence.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) == sequence_before) {
+      return ReadResult::kOk;
+    }
+  }
+}
+
+bool ShmPoseRingReader::ReadLatest(ShmPoseRecord & record) const
+{
+  while (true) {
+    const uint64_t num_written = NumWritten();
+    if (num_written == 0) {
+      return false;
+    }
+    // Overwritten only if the writer has lapped the ring meanwhile, then try the newer record.
+    if (Read(num_written - 1, record) == ReadResult::kOk) {
+      return true;
+    }
+  }
+}
+
+bool ShmPoseRingReader::ReadNext(ShmPoseRecord & record)
+{
+  while (next_index_ < NumWritten()) {
+    switch (Read(next_index_, record)) {
+      case ReadResult::kOk:
+        next_index_++;
+        return true;
+      case ReadResult::kNotWritten:
+        return false;
+      case ReadResult::kOverwritten: {
+          // Continue with the oldest record that is still in the ring.
+          const uint64_t num_written = NumWritten();
+          const uint64_t oldest =
+            num_written > header_->capacity ? num_written - header_->capacity : 0;
+          const uint64_t next_index = std::max(oldest, next_index_ + 1);
+          num_skipped_ += next_index - next_index_;
+          next_index_ = next_index;
+          break;
+        }
+    }
+  }
+  return false;
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
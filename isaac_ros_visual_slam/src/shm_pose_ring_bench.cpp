@@ -0,0 +1,169 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Latency benchmark of the shared memory pose ring against the tracking/odometry topic.
+//
+// Attaches to a running visual_slam node that was started with shm_pose_ring_name set. One
+// thread polls the ring, the executor receives the odometry messages. Both latencies are measured
+// from the write time of the record, which the node writes right before it publishes the frame,
+// so the topic latency includes the serialization and the transport through DDS.
+//
+// Usage:
+//   shm_pose_ring_bench [--ring <name>] [--topic <topic>] [--frames <n>]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "isaac_ros_visual_slam/shm_pose_ring.hpp"
+#include "nav_msgs/msg/odometry.hpp"
+#include "rclcpp/rclcpp.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+int64_t MonotonicNowNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PrintLatencies(const char * name, std::vector<int64_t> latencies_ns)
+{
+  if (latencies_ns.empty()) {
+    std::printf("%-6s no samples\n", name);
+    return;
+  }
+  std::sort(latencies_ns.begin(), latencies_ns.end());
+  const auto percentile = [&latencies_ns](double p) {
+      return latencies_ns[static_cast<size_t>(p * (latencies_ns.size() - 1))] * 1e-3;
+    };
+  std::printf(
+    "%-6s %6zu samples  p50: %9.2f us  p90: %9.2f us  p99: %9.2f us  max: %9.2f us\n", name,
+    latencies_ns.size(), percentile(0.5), percentile(0.9), percentile(0.99), percentile(1.0));
+}
+
+}  // namespace
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+int main(int argc, char * argv[])
+{
+  using nvidia::isaac_ros::visual_slam::MonotonicNowNs;
+  using nvidia::isaac_ros::visual_slam::ShmPoseRecord;
+  using nvidia::isaac_ros::visual_slam::ShmPoseRingReader;
+
+  const std::vector<std::string> args = rclcpp::init_and_remove_ros_arguments(argc, argv);
+  std::string ring_name = "visual_slam_poses";
+  std::string topic = "visual_slam/tracking/odometry";
+  size_t num_frames = 1000;
+  for (size_t i = 1; i + 1 < args.size(); i += 2) {
+    if (args[i] == "--ring") {
+      ring_name = args[i + 1];
+    } else if (args[i] == "--topic") {
+      topic = args[i + 1];
+    } else if (args[i] == "--frames") {
+      num_frames = std::stoul(args[i + 1]);
+    } else {
+      std::fprintf(stderr, "Unknown argument: %s\n", args[i].c_str());
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::unique_ptr<ShmPoseRingReader> reader;
+  try {
+    reader = std::make_unique<ShmPoseRingReader>(ring_name);
+  } catch (const std::exception & e) {
+    std::fprintf(stderr, "Could not open the pose ring: %s\n", e.what());
+    return EXIT_FAILURE;
+  }
+
+  // Write times of the records by frame timestamp, to match the odometry messages.
+  std::mutex mutex;
+  std::unordered_map<int64_t, int64_t> write_times;
+  std::vector<int64_t> ring_latencies;
+  std::vector<int64_t> topic_latencies;
+  ring_latencies.reserve(num_frames);
+  topic_latencies.reserve(num_frames);
+
+  std::atomic<bool> running{true};
+  // Polls busily, like a latency critical reader would.
+  std::thread poller([&]() {
+      ShmPoseRecord record;
+      // Start with the next record the node writes.
+      while (reader->ReadNext(record)) {
+      }
+      while (running) {
+        if (!reader->ReadNext(record)) {
+          continue;
+        }
+        const int64_t now = MonotonicNowNs();
+        if (ring_latencies.size() < num_frames) {
+          ring_latencies.push_back(now - record.write_time_ns);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (write_times.size() > 4 * num_frames) {
+          write_times.clear();
+        }
+        write_times[record.timestamp_ns] = record.write_time_ns;
+      }
+    });
+
+  auto node = std::make_shared<rclcpp::Node>("shm_pose_ring_bench");
+  auto subscription = node->create_subscription<nav_msgs::msg::Odometry>(
+    topic, rclcpp::QoS(10), [&](const nav_msgs::msg::Odometry::ConstSharedPtr & msg) {
+      const int64_t now = MonotonicNowNs();
+      const int64_t timestamp = rclcpp::Time(msg->header.stamp).nanoseconds();
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto it = write_times.find(timestamp);
+      if (it == write_times.end()) {
+        return;
+      }
+      topic_latencies.push_back(now - it->second);
+      write_times.erase(it);
+      if (topic_latencies.size() >= num_frames) {
+        rclcpp::shutdown();
+      }
+    });
+
+  std::printf("Measuring %zu frames of ring '%s' and topic '%s'\n", num_frames,
+    ring_name.c_str(), topic.c_str());
+  rclcpp::spin(node);
+  running = false;
+  poller.join();
+
+  nvidia::isaac_ros::visual_slam::PrintLatencies("ring", ring_latencies);
+  nvidia::isaac_ros::visual_slam::PrintLatencies("topic", topic_latencies);
+  std::printf("Records skipped by the ring reader: %lu\n",
+    static_cast<unsigned long>(reader->NumSkipped()));  // NOLINT
+  return 0;
+}
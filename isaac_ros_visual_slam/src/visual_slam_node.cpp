@@ -16,7 +16,9 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <algorithm>
+#include <future>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -104,20 +106,67 @@ camera_optical_frames_(declare_parameter<std::vector<std::string>>(
 imu_frame_(declare_parameter<std::string>("imu_frame", "")),
 // Message Parameters:
 image_buffer_size_(declare_parameter<int>("image_buffer_size", 10)),
+enable_adaptive_sync_(declare_parameter<bool>("enable_adaptive_sync", false)),
+adaptive_sync_max_matching_threshold_ms_(
+  declare_parameter<double>("adaptive_sync_max_matching_threshold_ms", 20.0)),
+adaptive_sync_max_buffer_size_(declare_parameter<int>("adaptive_sync_max_buffer_size", 30)),
+enable_camera_dropout_handling_(declare_parameter<bool>("enable_camera_dropout_handling", false)),
+camera_dropout_deadline_ms_(declare_parameter<double>("camera_dropout_deadline_ms", 20.0)),
+camera_dropout_readmit_frames_(declare_parameter<int>("camera_dropout_readmit_frames", 10)),
+decouple_masks_and_depth_(declare_parameter<bool>("decouple_masks_and_depth", false)),
+mask_staleness_tolerance_ms_(declare_parameter<double>("mask_staleness_tolerance_ms", 100.0)),
+depth_staleness_tolerance_ms_(declare_parameter<double>("depth_staleness_tolerance_ms", 5.0)),
 imu_buffer_size_(declare_parameter<int>("imu_buffer_size", 50)),
+imu_propagation_max_time_ms_(declare_parameter<double>("imu_propagation_max_time_ms", 200.0)),
 image_qos_(::isaac_ros::common::AddQosParameter(*this, "SENSOR_DATA", "image_qos")),
 imu_qos_(::isaac_ros::common::AddQosParameter(*this, "SENSOR_DATA", "imu_qos")),
+// Pipelining Parameters:
+enable_pipelined_tracking_(declare_parameter<bool>("enable_pipelined_tracking", false)),
+tracking_queue_size_(declare_parameter<int>("tracking_queue_size", 2)),
+enable_eager_imu_ingestion_(declare_parameter<bool>("enable_eager_imu_ingestion", false)),
+// Tracking Backend Parameters:
+tracking_backend_(declare_parameter<std::string>("tracking_backend", "cuvslam")),
+synthetic_backend_linear_velocity_(
+  declare_parameter<double>("synthetic_backend_linear_velocity", 1.0)),
+synthetic_backend_angular_velocity_(
+  declare_parameter<double>("synthetic_backend_angular_velocity", 0.1)),
+synthetic_backend_track_cost_ms_(declare_parameter<double>("synthetic_backend_track_cost_ms", 0.0)),
+synthetic_backend_slam_cost_ms_(declare_parameter<double>("synthetic_backend_slam_cost_ms", 0.0)),
+// Startup Parameters:
+rig_cache_directory_(declare_parameter<std::string>("rig_cache_directory", "")),
 // Output Parameters:
 override_publishing_stamp_(declare_parameter<bool>("override_publishing_stamp", false)),
 publish_map_to_odom_tf_(declare_parameter<bool>("publish_map_to_odom_tf", true)),
 publish_odom_to_base_tf_(declare_parameter<bool>("publish_odom_to_base_tf", true)),
 invert_map_to_odom_tf_(declare_parameter<bool>("invert_map_to_odom_tf", false)),
 invert_odom_to_base_tf_(declare_parameter<bool>("invert_odom_to_base_tf", false)),
+map_to_odom_tf_keep_alive_ms_(declare_parameter<double>("map_to_odom_tf_keep_alive_ms", 0.0)),
+map_to_odom_tf_translation_threshold_(
+  declare_parameter<double>("map_to_odom_tf_translation_threshold", 1e-4)),
+map_to_odom_tf_rotation_threshold_(
+  declare_parameter<double>("map_to_odom_tf_rotation_threshold", 1e-4)),
+odom_to_base_tf_max_rate_(declare_parameter<double>("odom_to_base_tf_max_rate", 0.0)),
+shm_pose_ring_name_(declare_parameter<std::string>("shm_pose_ring_name", "")),
+shm_pose_ring_size_(declare_parameter<int>("shm_pose_ring_size", 64)),
+odometry_covariance_window_size_(
+  declare_parameter<int>("odometry_covariance_window_size", 10)),
+pose_history_size_(declare_parameter<int>("pose_history_size", 1000)),
+pose_history_max_extrapolation_ms_(
+  declare_parameter<double>("pose_history_max_extrapolation_ms", 50.0)),
+latency_window_s_(declare_parameter<double>("latency_window_s", 60.0)),
 // Debug/Visualization Parameters:
 enable_slam_visualization_(declare_parameter<bool>("enable_slam_visualization", false)),
 enable_observations_view_(declare_parameter<bool>("enable_observations_view", false)),
 enable_landmarks_view_(declare_parameter<bool>("enable_landmarks_view", false)),
+landmarks_keyframe_period_ms_(declare_parameter<double>("landmarks_keyframe_period_ms", 5000.0)),
+vis_num_threads_(declare_parameter<int>("vis_num_threads", 1)),
+vis_cpu_affinity_(declare_parameter<std::vector<int64_t>>(
+    "vis_cpu_affinity",
+    std::vector<int64_t>{})),
+vis_thread_nice_(declare_parameter<int>("vis_thread_nice", 10)),
+vis_idle_scheduling_(declare_parameter<bool>("vis_idle_scheduling", false)),
 path_max_size_(declare_parameter<int>("path_max_size", 1024)),
+path_publish_period_ms_(declare_parameter<double>("path_publish_period_ms", 0.0)),
 verbosity_(declare_parameter<int>("verbosity", 1)),
 enable_debug_mode_(declare_parameter<bool>("enable_debug_mode", false)),
 debug_dump_path_(declare_parameter<std::string>("debug_dump_path", "/tmp/cuvslam")),
@@ -224,12 +273,21 @@ tracking_vo_pose_covariance_pub_(
 tracking_odometry_pub_(
   create_publisher<OdometryType>(
     "visual_slam/tracking/odometry", ::isaac_ros::common::ParseQosString("DEFAULT"))),
+tracking_odometry_imu_rate_pub_(
+  create_publisher<OdometryType>(
+    "visual_slam/tracking/odometry_imu_rate", ::isaac_ros::common::ParseQosString("DEFAULT"))),
 tracking_vo_path_pub_(
   create_publisher<PathType>(
     "visual_slam/tracking/vo_path", ::isaac_ros::common::ParseQosString("DEFAULT"))),
 tracking_slam_path_pub_(
   create_publisher<PathType>(
     "visual_slam/tracking/slam_path", ::isaac_ros::common::ParseQosString("DEFAULT"))),
+tracking_vo_path_delta_pub_(
+  create_publisher<PathType>(
+    "visual_slam/tracking/vo_path_delta", ::isaac_ros::common::ParseQosString("DEFAULT"))),
+tracking_slam_path_delta_pub_(
+  create_publisher<PathType>(
+    "visual_slam/tracking/slam_path_delta", ::isaac_ros::common::ParseQosString("DEFAULT"))),
 diagnostics_pub_(
   create_publisher<DiagnosticArrayType>(
     "/diagnostics", ::isaac_ros::common::ParseQosString("DEFAULT"))),
@@ -260,6 +318,9 @@ vis_slam_odometry_pub_(
 vis_landmarks_pub_(
   create_publisher<PointCloud2Type>(
     "visual_slam/vis/landmarks_cloud", ::isaac_ros::common::ParseQosString("DEFAULT"))),
+vis_landmarks_delta_pub_(
+  create_publisher<LandmarkCloudUpdateType>(
+    "visual_slam/vis/landmarks_cloud_delta", ::isaac_ros::common::ParseQosString("DEFAULT"))),
 vis_loop_closure_pub_(
   create_publisher<PointCloud2Type>(
     "visual_slam/vis/loop_closure_cloud", ::isaac_ros::common::ParseQosString("DEFAULT"))),
@@ -280,6 +341,10 @@ vis_localizer_pub_(
 vis_localizer_landmarks_pub_(
   create_publisher<PointCloud2Type>(
     "visual_slam/vis/localizer_map_cloud", ::isaac_ros::common::ParseQosString("DEFAULT"))),
+vis_localizer_landmarks_delta_pub_(
+  create_publisher<LandmarkCloudUpdateType>(
+    "visual_slam/vis/localizer_map_cloud_delta",
+    ::isaac_ros::common::ParseQosString("DEFAULT"))),
 vis_localizer_observations_pub_(
   create_publisher<PointCloud2Type>(
     "visual_slam/vis/localizer_observations_cloud",
@@ -300,6 +365,11 @@ get_all_poses_srv_(
     "visual_slam/get_all_poses", std::bind(
       &VisualSlamNode::CallbackGetAllPoses, this,
       std::placeholders::_1, std::placeholders::_2))),
+get_poses_at_times_srv_(
+  create_service<SrvGetPosesAtTimes>(
+    "visual_slam/get_poses_at_times", std::bind(
+      &VisualSlamNode::CallbackGetPosesAtTimes, this,
+      std::placeholders::_1, std::placeholders::_2))),
 set_slam_pose_srv_(
   create_service<SrvSetSlamPose>(
     "visual_slam/set_slam_pose", std::bind(
@@ -351,11 +421,27 @@ impl_(std::make_unique<VisualSlamImpl>(*this))
   }
   RCLCPP_INFO(get_logger(), "Tracking mode: %s", TrackingModeToString(tracking_mode_));
 
-  Stopwatch stopwatch_gpu;
-  StopwatchScope ssw_gpu(stopwatch_gpu);
-  // Initializing GPU
-  cuvslam::WarmUpGPU();
-  RCLCPP_INFO(get_logger(), "Time taken by cuvslam::WarmUpGPU(): %f", ssw_gpu.Stop());
+  if (tracking_backend_ != "cuvslam" && tracking_backend_ != "synthetic") {
+    RCLCPP_FATAL(
+      get_logger(), "Invalid tracking_backend value: %s. Valid values are cuvslam and synthetic",
+      tracking_backend_.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  if (tracking_backend_ == "cuvslam") {
+    // Initializing GPU while waiting for the first messages and transforms. cuVSLAM is only
+    // created once it is done.
+    gpu_warm_up_ = std::async(
+      std::launch::async, []() {
+        Stopwatch stopwatch_gpu;
+        StopwatchScope ssw_gpu(stopwatch_gpu);
+        cuvslam::WarmUpGPU();
+        return ssw_gpu.Stop();
+      }).share();
+  }
+
+  // With a rig cache the tracker is created right away instead of waiting for the messages.
+  impl_->InitializeFromRigCache();
 }
 
 VisualSlamNode::~VisualSlamNode()
@@ -384,11 +470,19 @@ void VisualSlamNode::CallbackReset(
   const std::shared_ptr<isaac_ros_visual_slam_interfaces::srv::Reset_Request> req,
   std::shared_ptr<isaac_ros_visual_slam_interfaces::srv::Reset_Response> res)
 {
-  (void)req;
+  if (req->soft_reset && impl_->IsInitialized()) {
+    RCLCPP_INFO(this->get_logger(), "cuvslam: Soft reset");
+    if (impl_->SoftReset(req->clear_map)) {
+      res->success = true;
+      return;
+    }
+    RCLCPP_WARN(this->get_logger(), "cuvslam: Soft reset failed, falling back to a full reset");
+  }
 
   RCLCPP_INFO(this->get_logger(), "cuvslam: Reset");
 
   impl_->Exit();
+  impl_->InitializeFromRigCache();
   res->success = true;
 }
 
@@ -409,7 +503,8 @@ void VisualSlamNode::CallbackGetAllPoses(
   // CUVSLAM_GetAllSlamPoses
   std::vector<cuvslam::PoseStamped> cuvslam_poses;
   try {
-    impl_->cuvslam_slam->GetAllSlamPoses(cuvslam_poses, req->max_count);
+    std::lock_guard<std::mutex> lock(impl_->tracking_backend_mutex);
+    impl_->tracking_backend->GetAllSlamPoses(cuvslam_poses, req->max_count);
   } catch (const std::exception & e) {
     RCLCPP_WARN(this->get_logger(), "GetAllSlamPoses Error: %s", e.what());
   }
@@ -429,6 +524,46 @@ void VisualSlamNode::CallbackGetAllPoses(
   res->success = (cuvslam_poses.size() != 0);
 }
 
+void VisualSlamNode::CallbackGetPosesAtTimes(
+  const std::shared_ptr<isaac_ros_visual_slam_interfaces::srv::GetPosesAtTimes_Request> req,
+  std::shared_ptr<isaac_ros_visual_slam_interfaces::srv::GetPosesAtTimes_Response> res)
+{
+  res->success = false;
+
+  PoseHistory::Frame frame;
+  if (req->frame_id.empty() || req->frame_id == odom_frame_) {
+    frame = PoseHistory::Frame::kOdom;
+  } else if (req->frame_id == map_frame_) {
+    frame = PoseHistory::Frame::kMap;
+  } else {
+    RCLCPP_ERROR(
+      this->get_logger(), "GetPosesAtTimes: Unknown frame '%s', expected '%s' or '%s'",
+      req->frame_id.c_str(), odom_frame_.c_str(), map_frame_.c_str());
+    return;
+  }
+  const std::string & frame_id = frame == PoseHistory::Frame::kOdom ? odom_frame_ : map_frame_;
+
+  std::vector<int64_t> timestamps(req->stamps.size());
+  for (size_t i = 0; i < req->stamps.size(); i++) {
+    timestamps[i] = rclcpp::Time(req->stamps[i]).nanoseconds();
+  }
+  std::vector<std::optional<tf2::Transform>> poses;
+  const size_t num_found = impl_->pose_history.GetPoses(frame, timestamps, poses);
+
+  res->poses.resize(poses.size());
+  res->valid.resize(poses.size());
+  for (size_t i = 0; i < poses.size(); i++) {
+    res->poses[i].header.stamp = req->stamps[i];
+    res->poses[i].header.frame_id = frame_id;
+    if (poses[i]) {
+      tf2::toMsg(*poses[i], res->poses[i].pose);
+    }
+    res->valid[i] = poses[i].has_value();
+  }
+
+  res->success = num_found != 0;
+}
+
 void VisualSlamNode::CallbackSetSlamPose(
   const std::shared_ptr<isaac_ros_visual_slam_interfaces::srv::SetSlamPose_Request> req,
   std::shared_ptr<isaac_ros_visual_slam_interfaces::srv::SetSlamPose_Response> res)
@@ -446,7 +581,8 @@ void VisualSlamNode::CallbackSetSlamPose(
     cuvslam::Pose req_map_pose_cuvslam = TocuVSLAMPose(req_map_pose_base_link);
 
     try {
-      impl_->cuvslam_slam->SetSlamPose(req_map_pose_cuvslam);
+      std::lock_guard<std::mutex> lock(impl_->tracking_backend_mutex);
+      impl_->tracking_backend->SetSlamPose(req_map_pose_cuvslam);
       res->success = true;
     } catch (const std::exception & e) {
       RCLCPP_WARN(this->get_logger(), "SetSlamPose Error: %s", e.what());
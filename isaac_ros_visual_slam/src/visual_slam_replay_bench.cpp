@@ -0,0 +1,405 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+// Offline benchmark of the visual slam node.
+//
+// Loads a rosbag into memory and feeds its camera_info, imu, image and tf messages directly into
+// the node callbacks, without executor and without DDS. This measures the overhead of the node
+// itself (synchronization, sequencing, conversion, publishing) separately from the transport.
+// Combine with tracking_backend:=synthetic to also take the tracker out of the measurement.
+//
+// Usage:
+//   visual_slam_replay_bench --bag <path> [--rate <factor>] [--max-frames <n>]
+//     [--warmup-frames <n>] [--image-topics <t0,t1,..>] [--camera-info-topics <t0,t1,..>]
+//     [--imu-topic <topic>] [--ros-args -p num_cameras:=2 -p tracking_backend:=synthetic ...]
+//
+// --rate 0 (default) replays as fast as possible, otherwise the recording is replayed at the given
+// real-time factor. Images have to be stored as sensor_msgs/msg/Image.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "isaac_ros_nitros_image_type/nitros_image.hpp"
+#include "isaac_ros_visual_slam/impl/allocation_counter.hpp"
+#include "isaac_ros_visual_slam/impl/latency_histogram.hpp"
+#include "isaac_ros_visual_slam/impl/visual_slam_impl.hpp"
+#include "isaac_ros_visual_slam/visual_slam_node.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialization.hpp"
+#include "rosbag2_cpp/reader.hpp"
+#include "tf2_msgs/msg/tf_message.hpp"
+
+// Count all heap allocations of the process. The replaced operators are used by the node library
+// as well, which also attributes them to the per frame allocation count of the node.
+namespace
+{
+std::atomic<uint64_t> g_num_allocations{0};
+}  // namespace
+
+void * operator new(std::size_t size)
+{
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  nvidia::isaac_ros::visual_slam::CountHeapAllocation();
+  if (void * ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  nvidia::isaac_ros::visual_slam::CountHeapAllocation();
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t & tag) noexcept
+{
+  return operator new(size, tag);
+}
+
+void operator delete(void * ptr) noexcept {std::free(ptr);}
+void operator delete[](void * ptr) noexcept {std::free(ptr);}
+void operator delete(void * ptr, std::size_t) noexcept {std::free(ptr);}
+void operator delete[](void * ptr, std::size_t) noexcept {std::free(ptr);}
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+
+class VisualSlamReplayBench
+{
+public:
+  struct Config
+  {
+    std::string bag_path;
+    double rate = 0;
+    size_t max_frames = 0;
+    size_t warmup_frames = 10;
+    std::vector<std::string> image_topics = {"visual_slam/image_0", "visual_slam/image_1"};
+    std::vector<std::string> camera_info_topics =
+    {"visual_slam/camera_info_0", "visual_slam/camera_info_1"};
+    std::string imu_topic = "visual_slam/imu";
+  };
+
+  VisualSlamReplayBench(VisualSlamNode & node, const Config & config)
+  : node_(node), config_(config)
+  {
+  }
+
+  // Reads the whole bag into memory, so that reading and deserialization are not measured.
+  void Load()
+  {
+    std::unordered_map<std::string, int> image_indices;
+    for (size_t i = 0; i < config_.image_topics.size(); i++) {
+      image_indices[Normalize(config_.image_topics[i])] = i;
+    }
+    std::unordered_map<std::string, int> camera_info_indices;
+    for (size_t i = 0; i < config_.camera_info_topics.size(); i++) {
+      camera_info_indices[Normalize(config_.camera_info_topics[i])] = i;
+    }
+    const std::string imu_topic = Normalize(config_.imu_topic);
+
+    rclcpp::Serialization<sensor_msgs::msg::Image> image_serialization;
+    rclcpp::Serialization<CameraInfoType> camera_info_serialization;
+    rclcpp::Serialization<ImuType> imu_serialization;
+    rclcpp::Serialization<tf2_msgs::msg::TFMessage> tf_serialization;
+
+    rosbag2_cpp::Reader reader;
+    reader.open(config_.bag_path);
+    size_t num_frames = 0;
+    while (reader.has_next()) {
+      const auto bag_message = reader.read_next();
+      const std::string topic = Normalize(bag_message->topic_name);
+      const rclcpp::SerializedMessage serialized(*bag_message->serialized_data);
+      Event event;
+      event.recv_time_ns = bag_message->time_stamp;
+
+      if (const auto it = image_indices.find(topic); it != image_indices.end()) {
+        if (it->second == 0) {
+          if (config_.max_frames && num_frames == config_.max_frames) {
+            break;
+          }
+          num_frames++;
+        }
+        sensor_msgs::msg::Image image;
+        image_serialization.deserialize_message(&serialized, &image);
+        auto nitros_image = std::make_shared<nitros::NitrosImage>();
+        rclcpp::TypeAdapter<nitros::NitrosImage, sensor_msgs::msg::Image>::convert_to_custom(
+          image, *nitros_image);
+        event.index = it->second;
+        event.payload = std::move(nitros_image);
+      } else if (const auto it = camera_info_indices.find(topic); it != camera_info_indices.end()) {
+        auto camera_info = std::make_shared<CameraInfoType>();
+        camera_info_serialization.deserialize_message(&serialized, camera_info.get());
+        event.index = it->second;
+        event.payload = CameraInfoType::ConstSharedPtr(std::move(camera_info));
+      } else if (topic == imu_topic) {
+        auto imu = std::make_shared<ImuType>();
+        imu_serialization.deserialize_message(&serialized, imu.get());
+        event.payload = ImuType::ConstSharedPtr(std::move(imu));
+      } else if (topic == "tf" || topic == "tf_static") {
+        tf2_msgs::msg::TFMessage tf_message;
+        tf_serialization.deserialize_message(&serialized, &tf_message);
+        // Transforms are applied before the replay starts. The node only looks them up once during
+        // initialization.
+        for (const auto & transform : tf_message.transforms) {
+          node_.impl_->tf_buffer->setTransform(transform, "replay_bench", topic == "tf_static");
+        }
+        continue;
+      } else {
+        continue;
+      }
+      events_.push_back(std::move(event));
+    }
+    RCLCPP_INFO(
+      node_.get_logger(), "Loaded %zu messages with %zu frames from '%s'", events_.size(),
+      num_frames, config_.bag_path.c_str());
+  }
+
+  void Run()
+  {
+    if (events_.empty()) {
+      return;
+    }
+    const int64_t first_recv_time_ns = events_.front().recv_time_ns;
+    const auto start_time = std::chrono::steady_clock::now();
+
+    size_t num_frames = 0;
+    std::chrono::nanoseconds frame_time{0};
+    uint64_t frame_allocations = 0;
+    auto finish_frame = [&]() {
+        if (num_frames > config_.warmup_frames) {
+          frame_latencies_.Record(frame_time);
+          measured_allocations_ += frame_allocations;
+          measured_time_ += frame_time;
+          num_measured_frames_++;
+        }
+        if (num_frames == config_.warmup_frames) {
+          warmup_published_frames_ = node_.impl_->num_published_frames;
+          warmup_frame_heap_allocations_ = node_.impl_->frame_heap_allocations;
+        }
+        frame_time = frame_time.zero();
+        frame_allocations = 0;
+      };
+
+    for (const Event & event : events_) {
+      if (config_.rate > 0) {
+        const auto offset = std::chrono::nanoseconds(
+          static_cast<int64_t>((event.recv_time_ns - first_recv_time_ns) / config_.rate));
+        std::this_thread::sleep_until(start_time + offset);
+      }
+      const bool is_first_camera_image =
+        std::holds_alternative<std::shared_ptr<nitros::NitrosImage>>(event.payload) &&
+        event.index == 0;
+      if (is_first_camera_image) {
+        // All callbacks since the previous image of the first camera belong to the previous frame.
+        if (num_frames > 0) {
+          finish_frame();
+        }
+        num_frames++;
+      }
+
+      const uint64_t allocations_before = g_num_allocations.load(std::memory_order_relaxed);
+      const auto callback_start_time = std::chrono::steady_clock::now();
+      Dispatch(event);
+      frame_time += std::chrono::steady_clock::now() - callback_start_time;
+      frame_allocations += g_num_allocations.load(std::memory_order_relaxed) - allocations_before;
+    }
+    finish_frame();
+    wall_time_ = std::chrono::steady_clock::now() - start_time;
+    num_frames_ = num_frames;
+  }
+
+  void Report() const
+  {
+    const double wall_seconds = std::chrono::duration<double>(wall_time_).count();
+    const double node_seconds = std::chrono::duration<double>(measured_time_).count();
+    const auto percentiles =
+      frame_latencies_.Percentiles(std::array<double, 4>{0.5, 0.9, 0.99, 0.999});
+
+    std::printf("frames replayed:            %zu (%zu measured)\n", num_frames_,
+      num_measured_frames_);
+    std::printf("wall time:                  %.3f s\n", wall_seconds);
+    std::printf("frames/sec (wall):          %.1f\n",
+      wall_seconds > 0 ? num_frames_ / wall_seconds : 0);
+    std::printf("frames/sec (node time):     %.1f\n",
+      node_seconds > 0 ? num_measured_frames_ / node_seconds : 0);
+    std::printf("node time per frame [ms]:   p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  max %.3f\n",
+      percentiles[0] * 1e3, percentiles[1] * 1e3, percentiles[2] * 1e3, percentiles[3] * 1e3,
+      frame_latencies_.MaxSeconds() * 1e3);
+    std::printf("allocations per frame:      %.1f\n",
+      num_measured_frames_ ? static_cast<double>(measured_allocations_) / num_measured_frames_ : 0);
+    // Allocations while tracking and publishing, excluding synchronization and sequencing.
+    const uint64_t tracked_frames = node_.impl_->num_published_frames - warmup_published_frames_;
+    const uint64_t tracked_frame_allocations =
+      node_.impl_->frame_heap_allocations - warmup_frame_heap_allocations_;
+    std::printf("hot path allocations/frame: %.1f (tracking and publishing only)\n",
+      tracked_frames ? static_cast<double>(tracked_frame_allocations) / tracked_frames : 0);
+    if (node_.enable_pipelined_tracking_) {
+      std::printf("note: pipelined tracking is enabled, node time only covers the ingestion\n");
+    }
+
+    // Per stage latencies recorded by the node itself.
+    VisualSlamStatusType status;
+    node_.impl_->AddLatencyStatistics(&status, nullptr);
+    const std::pair<const char *, const LatencyPercentilesType &> stages[] = {
+      {"sync wait", status.sync_wait_latency},
+      {"sequencer wait", status.sequencer_wait_latency},
+      {"imu registration", status.imu_registration_latency},
+      {"image conversion", status.image_conversion_latency},
+      {"odometry track", status.odometry_track_latency},
+      {"slam track", status.slam_track_latency},
+      {"tf publish", status.tf_publish_latency},
+      {"message publish", status.message_publish_latency},
+    };
+    std::printf("node stages [ms]:\n");
+    for (const auto & [name, latency] : stages) {
+      std::printf("  %-18s p50 %.3f  p90 %.3f  p99 %.3f  p99.9 %.3f  (%lu samples)\n", name,
+        latency.p50 * 1e3, latency.p90 * 1e3, latency.p99 * 1e3, latency.p99_9 * 1e3,
+        static_cast<unsigned long>(latency.count));  // NOLINT(runtime/int)
+    }
+  }
+
+private:
+  struct Event
+  {
+    int64_t recv_time_ns = 0;
+    int index = 0;
+    std::variant<std::shared_ptr<nitros::NitrosImage>, CameraInfoType::ConstSharedPtr,
+      ImuType::ConstSharedPtr> payload;
+  };
+
+  void Dispatch(const Event & event)
+  {
+    if (const auto * image = std::get_if<std::shared_ptr<nitros::NitrosImage>>(&event.payload)) {
+      node_.CallbackImage(event.index, ImageType(**image));
+    } else if (const auto * camera_info = std::get_if<CameraInfoType::ConstSharedPtr>(
+        &event.payload))
+    {
+      node_.CallbackCameraInfo(event.index, *camera_info);
+    } else if (const auto * imu = std::get_if<ImuType::ConstSharedPtr>(&event.payload)) {
+      node_.CallbackImu(*imu);
+    }
+  }
+
+  // Topics are compared without the leading slash.
+  static std::string Normalize(const std::string & topic)
+  {
+    return !topic.empty() && topic[0] == '/' ? topic.substr(1) : topic;
+  }
+
+  VisualSlamNode & node_;
+  const Config config_;
+  std::vector<Event> events_;
+
+  LatencyHistogram frame_latencies_;
+  size_t num_frames_ = 0;
+  size_t num_measured_frames_ = 0;
+  uint64_t measured_allocations_ = 0;
+  uint64_t warmup_published_frames_ = 0;
+  uint64_t warmup_frame_heap_allocations_ = 0;
+  std::chrono::nanoseconds measured_time_{0};
+  std::chrono::nanoseconds wall_time_{0};
+};
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
+
+namespace
+{
+
+std::vector<std::string> SplitList(const std::string & list)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    items.push_back(item);
+  }
+  return items;
+}
+
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+  const std::vector<std::string> args = rclcpp::remove_ros_arguments(argc, argv);
+
+  nvidia::isaac_ros::visual_slam::VisualSlamReplayBench::Config config;
+  for (size_t i = 1; i + 1 < args.size(); i += 2) {
+    const std::string & key = args[i];
+    const std::string & value = args[i + 1];
+    if (key == "--bag") {
+      config.bag_path = value;
+    } else if (key == "--rate") {
+      config.rate = std::stod(value);
+    } else if (key == "--max-frames") {
+      config.max_frames = std::stoul(value);
+    } else if (key == "--warmup-frames") {
+      config.warmup_frames = std::stoul(value);
+    } else if (key == "--image-topics") {
+      config.image_topics = SplitList(value);
+    } else if (key == "--camera-info-topics") {
+      config.camera_info_topics = SplitList(value);
+    } else if (key == "--imu-topic") {
+      config.imu_topic = value;
+    } else {
+      std::fprintf(stderr, "Unknown argument: %s\n", key.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+  if (config.bag_path.empty()) {
+    std::fprintf(stderr, "Usage: %s --bag <path> [options] [--ros-args ...]\n", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  {
+    // The node is never spun. Publishers without subscribers are cheap, so publishing stays in the
+    // measurement without DDS dominating it.
+    auto node = std::make_shared<nvidia::isaac_ros::visual_slam::VisualSlamNode>();
+    nvidia::isaac_ros::visual_slam::VisualSlamReplayBench bench(*node, config);
+    bench.Load();
+    bench.Run();
+    bench.Report();
+  }
+
+  rclcpp::shutdown();
+  return 0;
+}
@@ -0,0 +1,81 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import os
+import pathlib
+import sys
+
+from builtin_interfaces.msg import Time
+from isaac_ros_test import IsaacROSBaseTest
+from isaac_ros_visual_slam_interfaces.srv import GetPosesAtTimes
+from nav_msgs.msg import Odometry
+import pytest
+import rclpy
+
+sys.path.append(os.path.dirname(__file__))
+from helpers import run_cuvslam_from_bag, wait_for_one_message  # noqa: I100 E402
+
+_TEST_CASE_NAMESPACE = '/visual_slam_test_srv_get_poses_at_times'
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    bag_path = pathlib.Path(__file__).parent / 'test_cases/rosbags/r2b_galileo'
+    return run_cuvslam_from_bag(_TEST_CASE_NAMESPACE, bag_path)
+
+
+class IsaacRosVisualSlamServiceTest(IsaacROSBaseTest):
+    """This test checks the functionality of the `visual_slam/get_poses_at_times` service."""
+
+    def call(self, request):
+        service_client = self.node.create_client(
+            GetPosesAtTimes,
+            f'{_TEST_CASE_NAMESPACE}/visual_slam/get_poses_at_times',
+        )
+        self.assertTrue(service_client.wait_for_service(timeout_sec=20))
+        response_future = service_client.call_async(request)
+        rclpy.spin_until_future_complete(self.node, response_future)
+        return response_future.result()
+
+    def test_get_poses_at_times_service(self):
+        odometry = wait_for_one_message(
+            self.node, Odometry, f'{_TEST_CASE_NAMESPACE}/visual_slam/tracking/odometry', 20.0)
+        self.assertIsNotNone(odometry)
+
+        # A tracked stamp is answered, a stamp long before tracking started is not.
+        request = GetPosesAtTimes.Request()
+        request.stamps = [odometry.header.stamp, Time(sec=1)]
+        response = self.call(request)
+        self.assertTrue(response.success)
+        self.assertEqual(len(response.poses), 2)
+        self.assertEqual(response.valid, [True, False])
+        self.assertEqual(response.poses[0].header.stamp, odometry.header.stamp)
+        self.assertEqual(response.poses[0].header.frame_id, odometry.header.frame_id)
+        position = response.poses[0].pose.position
+        expected_position = odometry.pose.pose.position
+        self.assertAlmostEqual(position.x, expected_position.x, places=3)
+        self.assertAlmostEqual(position.y, expected_position.y, places=3)
+        self.assertAlmostEqual(position.z, expected_position.z, places=3)
+
+        request.frame_id = 'map'
+        response = self.call(request)
+        self.assertTrue(response.success)
+        self.assertEqual(response.valid, [True, False])
+        self.assertEqual(response.poses[0].header.frame_id, 'map')
+
+        request.frame_id = 'unknown_frame'
+        self.assertFalse(self.call(request).success)
@@ -0,0 +1,77 @@
+# SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+# Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import os
+import pathlib
+import sys
+import uuid
+
+from isaac_ros_test import IsaacROSBaseTest
+from isaac_ros_visual_slam_interfaces.srv import FilePath, GetAllPoses, SetSlamPose
+import pytest
+import rclpy
+
+sys.path.append(os.path.dirname(__file__))
+from helpers import run_cuvslam_from_bag, wait_for_odometry_message  # noqa: I100 E402
+
+_TEST_CASE_NAMESPACE = '/visual_slam_test_srv_pipelined'
+
+# Number of calls of every service, they overlap with tracking on the pipeline threads.
+_NUM_CALLS = 5
+
+
+@pytest.mark.rostest
+def generate_test_description():
+    bag_path = pathlib.Path(__file__).parent / 'test_cases/rosbags/r2b_galileo'
+    override_parameters = {'enable_pipelined_tracking': True}
+    return run_cuvslam_from_bag(_TEST_CASE_NAMESPACE, bag_path, override_parameters)
+
+
+class IsaacRosVisualSlamServiceTest(IsaacROSBaseTest):
+    """This test checks the slam services while tracking runs on the pipeline threads."""
+
+    def call(self, service_type, name, request):
+        service_client = self.node.create_client(
+            service_type,
+            f'{_TEST_CASE_NAMESPACE}/visual_slam/{name}',
+        )
+        self.assertTrue(service_client.wait_for_service(timeout_sec=20))
+        response_future = service_client.call_async(request)
+        rclpy.spin_until_future_complete(self.node, response_future)
+        return response_future.result()
+
+    def test_services_while_tracking(self):
+        self.assertTrue(wait_for_odometry_message(self.node, _TEST_CASE_NAMESPACE))
+
+        for i in range(_NUM_CALLS):
+            request = GetAllPoses.Request()
+            request.max_count = 10
+            self.assertTrue(self.call(GetAllPoses, 'get_all_poses', request).success)
+
+            request = SetSlamPose.Request()
+            request.pose.position.x = float(i)
+            request.pose.orientation.w = 1.0
+            self.assertTrue(self.call(SetSlamPose, 'set_slam_pose', request).success)
+
+            map_path = pathlib.Path(f'/tmp/cuvslam_map_{uuid.uuid4().hex.lower()}')
+            request = FilePath.Request()
+            request.file_path = str(map_path)
+            self.assertTrue(self.call(FilePath, 'save_map', request).success)
+            self.assertTrue(map_path.exists())
+
+        # Tracking continues after the services were called.
+        self.assertTrue(wait_for_odometry_message(self.node, _TEST_CASE_NAMESPACE))
@@ -40,9 +40,7 @@ def generate_test_description():
 class IsaacRosVisualSlamServiceTest(IsaacROSBaseTest):
     """This test checks the functionality of the `visual_slam/reset` service."""
 
-    def test_localize_in_map_service(self):
-        self.assertTrue(wait_for_odometry_message(self.node, _TEST_CASE_NAMESPACE))
-
+    def reset(self, soft_reset, clear_map):
         service_client = self.node.create_client(
             Reset,
             f'{_TEST_CASE_NAMESPACE}/visual_slam/reset',
@@ -50,8 +48,18 @@ class IsaacRosVisualSlamServiceTest(IsaacROSBaseTest):
         self.assertTrue(service_client.wait_for_service(timeout_sec=20))
 
         request = Reset.Request()
+        request.soft_reset = soft_reset
+        request.clear_map = clear_map
 
         response_future = service_client.call_async(request)
         rclpy.spin_until_future_complete(self.node, response_future)
-        response = response_future.result()
-        self.assertTrue(response.success)
+        return response_future.result()
+
+    def test_reset_service(self):
+        # The soft resets keep the tracker, the last case is a full reset that recreates it.
+        for soft_reset, clear_map in [(True, False), (True, True), (False, False)]:
+            with self.subTest(soft_reset=soft_reset, clear_map=clear_map):
+                self.assertTrue(wait_for_odometry_message(self.node, _TEST_CASE_NAMESPACE))
+                self.assertTrue(self.reset(soft_reset, clear_map).success)
+                # Tracking resumes after the reset.
+                self.assertTrue(wait_for_odometry_message(self.node, _TEST_CASE_NAMESPACE))
@@ -0,0 +1,183 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/allocation_counter.hpp"
+#include "isaac_ros_visual_slam/impl/bounded_queue.hpp"
+#include "isaac_ros_visual_slam/impl/message_stream_sequencer.hpp"
+
+// Count the heap allocations of the test process, like visual_slam_replay_bench does.
+void * operator new(std::size_t size)
+{
+  nvidia::isaac_ros::visual_slam::CountHeapAllocation();
+  if (void * ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  nvidia::isaac_ros::visual_slam::CountHeapAllocation();
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void * operator new[](std::size_t size, const std::nothrow_t & tag) noexcept
+{
+  return operator new(size, tag);
+}
+
+void operator delete(void * ptr) noexcept {std::free(ptr);}
+void operator delete[](void * ptr) noexcept {std::free(ptr);}
+void operator delete(void * ptr, std::size_t) noexcept {std::free(ptr);}
+void operator delete[](void * ptr, std::size_t) noexcept {std::free(ptr);}
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+constexpr int kWarmupFrames = 20;
+constexpr int kMeasuredFrames = 200;
+
+// Same shape as the frame set handed to the tracking stage in pipelined mode.
+struct FrameSet
+{
+  std::vector<int64_t> imu_samples;
+  std::vector<std::pair<int, int64_t>> idx_and_image_msgs;
+};
+
+}  // namespace
+
+TEST(AllocationCounterTest, CountsAllocationsOfTheCallingThread)
+{
+  const uint64_t start = GetThreadHeapAllocations();
+  auto value = std::make_unique<int>(1);
+  EXPECT_EQ(GetThreadHeapAllocations() - start, 1u);
+
+  // Allocations of other threads are not attributed to this one.
+  uint64_t thread_allocations = 0;
+  std::thread thread([&thread_allocations]() {
+      const uint64_t thread_start = GetThreadHeapAllocations();
+      std::vector<int> values(16);
+      thread_allocations = GetThreadHeapAllocations() - thread_start;
+    });
+  const uint64_t after_start = GetThreadHeapAllocations();
+  thread.join();
+  EXPECT_EQ(thread_allocations, 1u);
+  EXPECT_EQ(GetThreadHeapAllocations(), after_start);
+}
+
+TEST(AllocationCounterTest, FrameSetHandOverDoesNotAllocate)
+{
+  // The producer fills a frame set and swaps it into the queue, the consumer swaps it out and
+  // clears it, like UpdatePose() and RunTrackingStage() do.
+  BoundedQueue<FrameSet> queue(1);
+  FrameSet pending;
+  FrameSet consumed;
+  size_t num_consumed_imu_samples = 0;
+  const std::vector<int64_t> imu_samples(10, 1);
+  const std::vector<std::pair<int, int64_t>> images(4, {0, 1});
+  const auto merge = [](FrameSet & dropped, FrameSet & next) {
+      next.imu_samples.insert(
+        next.imu_samples.begin(), dropped.imu_samples.begin(), dropped.imu_samples.end());
+    };
+  auto run_frame = [&](int frame) {
+      pending.imu_samples.assign(imu_samples.begin(), imu_samples.end());
+      pending.idx_and_image_msgs.assign(images.begin(), images.end());
+      queue.Push(pending, merge);
+      pending.imu_samples.clear();
+      pending.idx_and_image_msgs.clear();
+      // The consumer falls behind every third frame, which drops a frame set.
+      if (frame % 3 != 0) {
+        while (queue.Size() > 0 && queue.Pop(consumed)) {
+          num_consumed_imu_samples += consumed.imu_samples.size();
+          consumed.imu_samples.clear();
+          consumed.idx_and_image_msgs.clear();
+        }
+      }
+    };
+
+  for (int i = 0; i < kWarmupFrames; i++) {
+    run_frame(i);
+  }
+  const uint64_t start = GetThreadHeapAllocations();
+  for (int i = kWarmupFrames; i < kWarmupFrames + kMeasuredFrames; i++) {
+    run_frame(i);
+  }
+  EXPECT_EQ(GetThreadHeapAllocations() - start, 0u);
+  // Dropped frame sets carry their imu samples over to the next one.
+  EXPECT_GT(queue.Drops(), 0u);
+  if (queue.Size() > 0 && queue.Pop(consumed)) {
+    num_consumed_imu_samples += consumed.imu_samples.size();
+  }
+  EXPECT_EQ(num_consumed_imu_samples, (kWarmupFrames + kMeasuredFrames) * imu_samples.size());
+}
+
+TEST(AllocationCounterTest, SequencingDoesNotAllocate)
+{
+  MessageStreamSequencer<int64_t, int64_t> sequencer(20, 100, 10, 100);
+  size_t num_batches = 0;
+  size_t num_stream1_msgs = 0;
+  sequencer.RegisterCallback(
+    [&](const BatchView<int64_t> & stream1_msgs, const int64_t &) {
+      num_batches++;
+      num_stream1_msgs += stream1_msgs.size();
+    });
+  // Stream 1 is ten times as fast as stream 2, like imu and images.
+  auto run_frame = [&](int frame) {
+      for (int i = 0; i < 10; i++) {
+        const int64_t timestamp = frame * 100 + i * 10;
+        sequencer.CallbackStream1(timestamp, timestamp);
+      }
+      sequencer.CallbackStream2(frame * 100 + 95, frame * 100 + 95);
+    };
+
+  for (int i = 0; i < kWarmupFrames; i++) {
+    run_frame(i);
+  }
+  const size_t warmup_batches = num_batches;
+  const uint64_t start = GetThreadHeapAllocations();
+  for (int i = kWarmupFrames; i < kWarmupFrames + kMeasuredFrames; i++) {
+    run_frame(i);
+  }
+  EXPECT_EQ(GetThreadHeapAllocations() - start, 0u);
+  EXPECT_GE(num_batches - warmup_batches, static_cast<size_t>(kMeasuredFrames - 1));
+  EXPECT_GT(num_stream1_msgs, 0u);
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
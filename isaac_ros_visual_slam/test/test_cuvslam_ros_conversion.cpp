@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
+#include "tf2/LinearMath/Quaternion.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+// The measurements are floats in cuvslam::ImuMeasurement.
+constexpr double kTolerance = 1e-5;
+
+std::vector<ImuSample> MakeSamples(size_t num_samples, std::mt19937 & random)
+{
+  std::uniform_real_distribution<double> value(-20.0, 20.0);
+  std::vector<ImuSample> samples(num_samples);
+  for (size_t i = 0; i < num_samples; i++) {
+    auto msg = std::make_shared<ImuType>();
+    msg->header.stamp.sec = 100 + static_cast<int32_t>(i / 200);
+    msg->header.stamp.nanosec = static_cast<uint32_t>(i % 200) * 5'000'000;
+    msg->linear_acceleration.x = value(random);
+    msg->linear_acceleration.y = value(random);
+    msg->linear_acceleration.z = value(random);
+    msg->angular_velocity.x = value(random);
+    msg->angular_velocity.y = value(random);
+    msg->angular_velocity.z = value(random);
+    samples[i].msg = msg;
+  }
+  return samples;
+}
+
+// The conversion of a single message before the batching: rotate into the imu frame, then change
+// from ROS to cuVSLAM conventions.
+cuvslam::ImuMeasurement ReferenceMeasurement(
+  const ImuType & msg, const tf2::Matrix3x3 & imu_rotation_msg)
+{
+  const auto & in_lin_acc = msg.linear_acceleration;
+  const auto & in_ang_vel = msg.angular_velocity;
+  const tf2::Vector3 lin_acc = cuvslam_pose_canonical *
+    (imu_rotation_msg * tf2::Vector3(in_lin_acc.x, in_lin_acc.y, in_lin_acc.z));
+  const tf2::Vector3 ang_vel = cuvslam_pose_canonical *
+    (imu_rotation_msg * tf2::Vector3(in_ang_vel.x, in_ang_vel.y, in_ang_vel.z));
+
+  cuvslam::ImuMeasurement measurement;
+  for (int axis = 0; axis < 3; axis++) {
+    measurement.linear_accelerations[axis] = lin_acc[axis];
+    measurement.angular_velocities[axis] = ang_vel[axis];
+  }
+  measurement.timestamp_ns =
+    static_cast<int64_t>(msg.header.stamp.sec) * 1'000'000'000 + msg.header.stamp.nanosec;
+  return measurement;
+}
+
+void ExpectNear(const cuvslam::ImuMeasurement & actual, const cuvslam::ImuMeasurement & expected)
+{
+  EXPECT_EQ(actual.timestamp_ns, expected.timestamp_ns);
+  for (int axis = 0; axis < 3; axis++) {
+    EXPECT_NEAR(actual.linear_accelerations[axis], expected.linear_accelerations[axis], kTolerance);
+    EXPECT_NEAR(actual.angular_velocities[axis], expected.angular_velocities[axis], kTolerance);
+  }
+}
+
+tf2::Matrix3x3 MakeRotation(double roll, double pitch, double yaw)
+{
+  tf2::Quaternion rotation;
+  rotation.setRPY(roll, pitch, yaw);
+  return tf2::Matrix3x3(rotation);
+}
+
+}  // namespace
+
+TEST(CuvslamRosConversionTest, ImuBatchMatchesPerSampleConversion)
+{
+  std::mt19937 random(42);
+  const std::vector<ImuSample> samples = MakeSamples(37, random);
+
+  for (const tf2::Matrix3x3 & imu_rotation_msg :
+    {tf2::Matrix3x3::getIdentity(), MakeRotation(0.3, -1.2, 2.5)})
+  {
+    const Eigen::Matrix3d rotation = TocuVSLAMImuRotation(imu_rotation_msg);
+    ImuBatch batch;
+    TocuVSLAMImuMeasurements(
+      BatchView<ImuSample>(samples.data(), samples.size()), rotation, batch);
+
+    ASSERT_EQ(batch.measurements.size(), samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+      const cuvslam::ImuMeasurement expected =
+        ReferenceMeasurement(*samples[i].msg, imu_rotation_msg);
+      ExpectNear(batch.measurements[i], expected);
+      ExpectNear(TocuVSLAMImuMeasurement(*samples[i].msg, rotation), expected);
+    }
+  }
+}
+
+TEST(CuvslamRosConversionTest, ImuBatchIsReusedAcrossSizes)
+{
+  std::mt19937 random(7);
+  const Eigen::Matrix3d rotation = TocuVSLAMImuRotation(MakeRotation(0, 0, 1.0));
+  ImuBatch batch;
+  // A smaller batch after a larger one must not see stale samples of the larger one.
+  for (size_t num_samples : {16u, 3u, 0u, 9u}) {
+    const std::vector<ImuSample> samples = MakeSamples(num_samples, random);
+    TocuVSLAMImuMeasurements(
+      BatchView<ImuSample>(samples.data(), samples.size()), rotation, batch);
+    ASSERT_EQ(batch.measurements.size(), num_samples);
+    for (size_t i = 0; i < num_samples; i++) {
+      ExpectNear(batch.measurements[i], TocuVSLAMImuMeasurement(*samples[i].msg, rotation));
+    }
+  }
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,210 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/dropout_synchronizer.hpp"
+
+using DropoutSynchronizer = nvidia::isaac_ros::visual_slam::DropoutSynchronizer<int>;
+using std::chrono::milliseconds;
+
+namespace
+{
+
+constexpr int64_t kMs = 1000000;
+constexpr int64_t kPeriodNs = 33 * kMs;
+constexpr size_t kNumStreams = 3;
+constexpr size_t kNumReadmitFrames = 3;
+constexpr milliseconds kDeadline(50);
+
+}  // namespace
+
+// Records the emitted frame sets and the stream state changes of a synchronizer of three streams
+// that needs two messages per frame set.
+class DropoutSynchronizerTest : public ::testing::Test
+{
+public:
+  struct Emitted
+  {
+    int64_t timestamp;
+    // Sorted indices of the streams in the frame set.
+    std::vector<int> streams;
+  };
+
+  DropoutSynchronizerTest()
+  : synchronizer(kNumStreams, kMs, 2, 5, kDeadline, kNumReadmitFrames)
+  {
+    synchronizer.RegisterCallback(
+      [this](int64_t timestamp, const DropoutSynchronizer::Messages & messages) {
+        Emitted frame_set{timestamp, {}};
+        for (const auto & message : messages) {
+          // The message is its stream index.
+          EXPECT_EQ(message.first, message.second);
+          frame_set.streams.push_back(message.first);
+        }
+        std::sort(frame_set.streams.begin(), frame_set.streams.end());
+        emitted.push_back(frame_set);
+      });
+    synchronizer.RegisterStreamCallback(
+      [this](int index, bool degraded) {stream_changes.emplace_back(index, degraded);});
+  }
+
+  void Add(int index, int64_t timestamp, milliseconds now)
+  {
+    synchronizer.AddMessage(index, timestamp, index, start + now);
+  }
+
+  // Adds the messages of the streams for frame, all of them arriving at the same time.
+  void AddFrame(const std::vector<int> & streams, int frame, milliseconds now)
+  {
+    for (const int index : streams) {
+      Add(index, frame * kPeriodNs, now);
+    }
+  }
+
+  const DropoutSynchronizer::Clock::time_point start{};
+  DropoutSynchronizer synchronizer;
+  std::vector<Emitted> emitted;
+  std::vector<std::pair<int, bool>> stream_changes;
+};
+
+TEST_F(DropoutSynchronizerTest, CompleteFrameSetIsEmittedImmediately)
+{
+  Add(0, 100 * kMs, milliseconds(0));
+  Add(1, 100 * kMs + kMs / 2, milliseconds(1));
+  EXPECT_TRUE(emitted.empty());
+  Add(2, 100 * kMs - kMs / 2, milliseconds(2));
+  ASSERT_EQ(emitted.size(), 1u);
+  EXPECT_EQ(emitted[0].timestamp, 100 * kMs + kMs / 2);
+  EXPECT_EQ(emitted[0].streams, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(synchronizer.NumPartial(), 0u);
+}
+
+TEST_F(DropoutSynchronizerTest, DeadlineEmitsTheAvailableSubset)
+{
+  AddFrame({0, 1}, 1, milliseconds(0));
+  synchronizer.CheckDeadlines(start + kDeadline - milliseconds(1));
+  EXPECT_TRUE(emitted.empty());
+
+  synchronizer.CheckDeadlines(start + kDeadline);
+  ASSERT_EQ(emitted.size(), 1u);
+  EXPECT_EQ(emitted[0].streams, (std::vector<int>{0, 1}));
+  EXPECT_EQ(synchronizer.NumPartial(), 1u);
+  EXPECT_EQ(synchronizer.NumDegraded(), 1u);
+  EXPECT_EQ(stream_changes, (std::vector<std::pair<int, bool>>{{2, true}}));
+}
+
+TEST_F(DropoutSynchronizerTest, StalledStreamIsNotWaitedFor)
+{
+  AddFrame({0, 1}, 1, milliseconds(0));
+  synchronizer.CheckDeadlines(start + kDeadline);
+  ASSERT_EQ(synchronizer.NumDegraded(), 1u);
+
+  // The healthy streams complete the next frame sets without waiting for the deadline.
+  for (int frame = 2; frame < 10; frame++) {
+    AddFrame({0, 1}, frame, milliseconds(33 * frame));
+    ASSERT_EQ(emitted.size(), static_cast<size_t>(frame));
+    EXPECT_EQ(emitted.back().streams, (std::vector<int>{0, 1}));
+  }
+  EXPECT_EQ(synchronizer.NumDegraded(), 1u);
+  EXPECT_EQ(synchronizer.NumDropped(), 0u);
+}
+
+TEST_F(DropoutSynchronizerTest, FrameSetBelowTheMinimumIsDropped)
+{
+  AddFrame({0}, 1, milliseconds(0));
+  synchronizer.CheckDeadlines(start + kDeadline);
+  EXPECT_TRUE(emitted.empty());
+  EXPECT_EQ(synchronizer.NumDropped(), 1u);
+  // Nothing was emitted, so nothing was marked degraded.
+  EXPECT_EQ(synchronizer.NumDegraded(), 0u);
+
+  // A late message of the dropped frame set is dropped too.
+  AddFrame({1, 2}, 1, milliseconds(60));
+  EXPECT_TRUE(emitted.empty());
+}
+
+TEST_F(DropoutSynchronizerTest, ReadmitsAfterConsecutiveOnTimeFrames)
+{
+  AddFrame({0, 1}, 1, milliseconds(0));
+  synchronizer.CheckDeadlines(start + kDeadline);
+  ASSERT_EQ(synchronizer.NumDegraded(), 1u);
+
+  // The degraded stream delivers right after the healthy streams completed the frame set, before
+  // its deadline.
+  for (int frame = 2; frame < 2 + static_cast<int>(kNumReadmitFrames) - 1; frame++) {
+    AddFrame({0, 1}, frame, milliseconds(33 * frame));
+    AddFrame({2}, frame, milliseconds(33 * frame + 10));
+  }
+  EXPECT_EQ(synchronizer.NumDegraded(), 1u);
+
+  // A message past the deadline restarts the count.
+  int frame = 1 + static_cast<int>(kNumReadmitFrames);
+  AddFrame({0, 1}, frame, milliseconds(33 * frame));
+  AddFrame({2}, frame, milliseconds(33 * frame) + kDeadline + milliseconds(1));
+  for (frame++; frame < 2 + 2 * static_cast<int>(kNumReadmitFrames) - 1; frame++) {
+    AddFrame({0, 1}, frame, milliseconds(33 * frame));
+    AddFrame({2}, frame, milliseconds(33 * frame + 10));
+  }
+  EXPECT_EQ(synchronizer.NumDegraded(), 1u);
+
+  AddFrame({0, 1}, frame, milliseconds(33 * frame));
+  AddFrame({2}, frame, milliseconds(33 * frame + 10));
+  EXPECT_EQ(synchronizer.NumDegraded(), 0u);
+  EXPECT_EQ(
+    stream_changes, (std::vector<std::pair<int, bool>>{{2, true}, {2, false}}));
+
+  // The re-admitted stream is waited for again.
+  const size_t num_emitted = emitted.size();
+  frame++;
+  AddFrame({0, 1}, frame, milliseconds(33 * frame));
+  EXPECT_EQ(emitted.size(), num_emitted);
+  AddFrame({2}, frame, milliseconds(33 * frame + 10));
+  ASSERT_EQ(emitted.size(), num_emitted + 1);
+  EXPECT_EQ(emitted.back().streams, (std::vector<int>{0, 1, 2}));
+}
+
+TEST_F(DropoutSynchronizerTest, BackwardTimeJumpRestarts)
+{
+  const int first_frame = 300;
+  AddFrame({0, 1, 2}, first_frame, milliseconds(0));
+  ASSERT_EQ(emitted.size(), 1u);
+  // An incomplete frame set is pending when the time jumps.
+  AddFrame({0}, first_frame + 1, milliseconds(33));
+
+  // Going back by less than the time jump threshold is treated as late messages.
+  AddFrame({0, 1, 2}, first_frame - 10, milliseconds(40));
+  EXPECT_EQ(emitted.size(), 1u);
+
+  // A jump back by more restarts the synchronization.
+  AddFrame({0, 1, 2}, 1, milliseconds(50));
+  ASSERT_EQ(emitted.size(), 2u);
+  EXPECT_EQ(emitted[1].timestamp, kPeriodNs);
+  EXPECT_EQ(emitted[1].streams, (std::vector<int>{0, 1, 2}));
+  AddFrame({0, 1, 2}, 2, milliseconds(83));
+  ASSERT_EQ(emitted.size(), 3u);
+
+  // The pending frame set from before the jump was discarded and not counted as dropped.
+  synchronizer.CheckDeadlines(start + milliseconds(1000));
+  EXPECT_EQ(emitted.size(), 3u);
+  EXPECT_EQ(synchronizer.NumDropped(), 0u);
+}
@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <optional>
+
+#include "isaac_ros_visual_slam/impl/imu_propagator.hpp"
+#include "tf2/LinearMath/Quaternion.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+constexpr int64_t kImuPeriodNs = 10'000'000;
+constexpr int64_t kMaxPropagationNs = 2'000'000'000;
+constexpr double kGravity = 9.81;
+constexpr double kTolerance = 1e-9;
+
+// Gravity in the base frame of a level rig.
+const tf2::Vector3 kBaseGravity(0, 0, -kGravity);
+
+tf2::Transform MakePose(double x, double y, double yaw)
+{
+  tf2::Quaternion orientation;
+  orientation.setRPY(0, 0, yaw);
+  return tf2::Transform(orientation, tf2::Vector3(x, y, 0));
+}
+
+double Yaw(const tf2::Transform & pose)
+{
+  double roll, pitch, yaw;
+  pose.getBasis().getRPY(roll, pitch, yaw);
+  return yaw;
+}
+
+void ExpectNear(const tf2::Vector3 & actual, const tf2::Vector3 & expected)
+{
+  EXPECT_NEAR(actual.x(), expected.x(), kTolerance);
+  EXPECT_NEAR(actual.y(), expected.y(), kTolerance);
+  EXPECT_NEAR(actual.z(), expected.z(), kTolerance);
+}
+
+// Feeds a level rig's measurements from (start_ns, end_ns] and returns the last state. The
+// accelerometer measures the specific force, i.e. the acceleration plus the gravity reaction.
+std::optional<ImuPropagator::State> Feed(
+  ImuPropagator & propagator, int64_t start_ns, int64_t end_ns,
+  const tf2::Vector3 & angular_velocity, const tf2::Vector3 & acceleration)
+{
+  std::optional<ImuPropagator::State> state;
+  for (int64_t t = start_ns + kImuPeriodNs; t <= end_ns; t += kImuPeriodNs) {
+    state = propagator.Add(t, angular_velocity, acceleration - kBaseGravity);
+  }
+  return state;
+}
+
+}  // namespace
+
+TEST(ImuPropagatorTest, NeedsAnAnchor)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  EXPECT_FALSE(propagator.Add(kImuPeriodNs, tf2::Vector3(), -kBaseGravity));
+}
+
+TEST(ImuPropagatorTest, IntegratesConstantAcceleration)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(1, 0, 0), kBaseGravity);
+
+  const auto state =
+    Feed(propagator, 0, 1'000'000'000, tf2::Vector3(), tf2::Vector3(2, 0, 0));
+  ASSERT_TRUE(state);
+  EXPECT_EQ(state->timestamp_ns, 1'000'000'000);
+  // x = v * t + a * t^2 / 2
+  ExpectNear(state->pose.getOrigin(), tf2::Vector3(2, 0, 0));
+  ExpectNear(state->linear_velocity, tf2::Vector3(3, 0, 0));
+}
+
+TEST(ImuPropagatorTest, IntegratesRotation)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(), kBaseGravity);
+
+  const auto state =
+    Feed(propagator, 0, 500'000'000, tf2::Vector3(0, 0, 1.0), tf2::Vector3());
+  ASSERT_TRUE(state);
+  EXPECT_NEAR(Yaw(state->pose), 0.5, 1e-6);
+  ExpectNear(state->angular_velocity, tf2::Vector3(0, 0, 1.0));
+  // Gravity is cancelled by the specific force, so the rig stays in place.
+  ExpectNear(state->pose.getOrigin(), tf2::Vector3());
+}
+
+TEST(ImuPropagatorTest, AnchorVelocityIsInTheOdomFrame)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  // The rig faces along the odom y axis and drives forward.
+  propagator.Anchor(0, MakePose(1, 1, M_PI / 2), tf2::Vector3(0, 2, 0), kBaseGravity);
+
+  const auto state =
+    Feed(propagator, 0, 1'000'000'000, tf2::Vector3(), tf2::Vector3());
+  ASSERT_TRUE(state);
+  ExpectNear(state->pose.getOrigin(), tf2::Vector3(1, 3, 0));
+  ExpectNear(state->linear_velocity, tf2::Vector3(0, 2, 0));
+}
+
+TEST(ImuPropagatorTest, RotatesMeasurementsIntoTheBaseFrame)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  // The imu x axis points along the base y axis.
+  propagator.SetBasePoseImu(MakePose(0, 0, M_PI / 2));
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(), kBaseGravity);
+
+  // Gravity points along -z in both frames, an acceleration along imu x is along base y.
+  std::optional<ImuPropagator::State> state;
+  for (int64_t t = kImuPeriodNs; t <= 1'000'000'000; t += kImuPeriodNs) {
+    state = propagator.Add(t, tf2::Vector3(), tf2::Vector3(2, 0, kGravity));
+  }
+  ASSERT_TRUE(state);
+  ExpectNear(state->pose.getOrigin(), tf2::Vector3(0, 1, 0));
+}
+
+TEST(ImuPropagatorTest, AnchorIntegratesBufferedMeasurementsAgain)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  // Measurements that arrive while the frame at 200 ms is tracked.
+  EXPECT_FALSE(Feed(propagator, 0, 500'000'000, tf2::Vector3(), tf2::Vector3(2, 0, 0)));
+
+  propagator.Anchor(200'000'000, MakePose(5, 0, 0), tf2::Vector3(1, 0, 0), kBaseGravity);
+  const auto state =
+    Feed(propagator, 500'000'000, 1'200'000'000, tf2::Vector3(), tf2::Vector3(2, 0, 0));
+  ASSERT_TRUE(state);
+  // Propagated for one second from the anchor.
+  ExpectNear(state->pose.getOrigin(), tf2::Vector3(5 + 1 + 1, 0, 0));
+  ExpectNear(state->linear_velocity, tf2::Vector3(3, 0, 0));
+}
+
+TEST(ImuPropagatorTest, ReanchoringReplacesThePropagatedState)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(1, 0, 0), kBaseGravity);
+  Feed(propagator, 0, 300'000'000, tf2::Vector3(), tf2::Vector3(2, 0, 0));
+
+  // A tracked pose at 300 ms corrects the drift, the next measurement continues from there.
+  propagator.Anchor(300'000'000, MakePose(0, 0, 0), tf2::Vector3(), kBaseGravity);
+  const auto state = propagator.Add(310'000'000, tf2::Vector3(), -kBaseGravity);
+  ASSERT_TRUE(state);
+  ExpectNear(state->pose.getOrigin(), tf2::Vector3());
+  ExpectNear(state->linear_velocity, tf2::Vector3());
+}
+
+TEST(ImuPropagatorTest, StopsAfterTheMaximumPropagationTime)
+{
+  ImuPropagator propagator(100, 100'000'000);
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(), kBaseGravity);
+  EXPECT_TRUE(propagator.Add(100'000'000, tf2::Vector3(), -kBaseGravity));
+  EXPECT_FALSE(propagator.Add(110'000'000, tf2::Vector3(), -kBaseGravity));
+
+  // A new anchor restarts the propagation.
+  propagator.Anchor(110'000'000, tf2::Transform::getIdentity(), tf2::Vector3(), kBaseGravity);
+  EXPECT_TRUE(propagator.Add(120'000'000, tf2::Vector3(), -kBaseGravity));
+}
+
+TEST(ImuPropagatorTest, RejectsOutOfOrderMeasurements)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(), kBaseGravity);
+  EXPECT_TRUE(propagator.Add(20'000'000, tf2::Vector3(), -kBaseGravity));
+  EXPECT_FALSE(propagator.Add(20'000'000, tf2::Vector3(), -kBaseGravity));
+  EXPECT_FALSE(propagator.Add(10'000'000, tf2::Vector3(), -kBaseGravity));
+}
+
+TEST(ImuPropagatorTest, ResetDropsTheAnchor)
+{
+  ImuPropagator propagator(100, kMaxPropagationNs);
+  propagator.Anchor(0, tf2::Transform::getIdentity(), tf2::Vector3(), kBaseGravity);
+  propagator.Reset();
+  EXPECT_FALSE(propagator.Add(kImuPeriodNs, tf2::Vector3(), -kBaseGravity));
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/landmark_delta.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+// Same members as cuvslam::Slam::Landmark.
+struct Landmark
+{
+  uint64_t id;
+  float coords[3];
+  float weight;
+};
+
+using LandmarkList = std::vector<Landmark>;
+using Clock = LandmarkDelta<LandmarkList>::Clock;
+
+constexpr std::chrono::milliseconds kKeyframePeriod{1000};
+
+Landmark MakeLandmark(uint64_t id, float x, float weight = 1.0f)
+{
+  return Landmark{id, {x, 0.0f, 0.0f}, weight};
+}
+
+std::vector<uint64_t> Ids(const LandmarkList & landmarks)
+{
+  std::vector<uint64_t> ids;
+  for (const Landmark & landmark : landmarks) {
+    ids.push_back(landmark.id);
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+std::vector<uint64_t> Sorted(std::vector<uint64_t> ids)
+{
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+class LandmarkDeltaTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    delta_.Configure(kKeyframePeriod, 16);
+  }
+
+  LandmarkDelta<LandmarkList> delta_;
+  const Clock::time_point start_ = Clock::now();
+};
+
+}  // namespace
+
+TEST_F(LandmarkDeltaTest, FirstUpdateIsAKeyframe)
+{
+  EXPECT_FALSE(delta_.HasKeyframe());
+  EXPECT_TRUE(delta_.IsKeyframeDue(start_));
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 0), MakeLandmark(2, 1)}, start_));
+  EXPECT_TRUE(delta_.IsKeyframe());
+  EXPECT_TRUE(delta_.HasKeyframe());
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{1, 2}));
+  EXPECT_TRUE(delta_.RemovedIds().empty());
+}
+
+TEST_F(LandmarkDeltaTest, ReportsAddedMovedAndRemovedLandmarks)
+{
+  delta_.Update({MakeLandmark(1, 0), MakeLandmark(2, 1), MakeLandmark(3, 2)}, start_);
+
+  // 1 is unchanged, 2 moved, 3 was removed and 4 was added.
+  const auto now = start_ + std::chrono::milliseconds(100);
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 0), MakeLandmark(2, 1.5f), MakeLandmark(4, 3)}, now));
+  EXPECT_FALSE(delta_.IsKeyframe());
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{2, 4}));
+  EXPECT_EQ(Sorted(delta_.RemovedIds()), (std::vector<uint64_t>{3}));
+
+  // A removed id is reported only once.
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 0), MakeLandmark(4, 3)}, now));
+  EXPECT_TRUE(delta_.Changed().empty());
+  EXPECT_EQ(Sorted(delta_.RemovedIds()), (std::vector<uint64_t>{2}));
+}
+
+TEST_F(LandmarkDeltaTest, WeightChangesAreUpdates)
+{
+  delta_.Update({MakeLandmark(1, 0, 0.5f)}, start_);
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 0, 0.75f)}, start_));
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{1}));
+}
+
+TEST_F(LandmarkDeltaTest, SmallMovesAreNotSent)
+{
+  delta_.Update({MakeLandmark(1, 0)}, start_);
+  const float small_move = LandmarkDelta<LandmarkList>::kMoveThreshold / 2;
+  EXPECT_FALSE(delta_.Update({MakeLandmark(1, small_move)}, start_));
+
+  // The published position is kept, so small moves do not add up unnoticed.
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 3 * small_move)}, start_));
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{1}));
+}
+
+TEST_F(LandmarkDeltaTest, UnchangedLayerHasNothingToPublish)
+{
+  const LandmarkList landmarks = {MakeLandmark(1, 0), MakeLandmark(2, 1)};
+  delta_.Update(landmarks, start_);
+  EXPECT_FALSE(delta_.Update(landmarks, start_ + kKeyframePeriod / 2));
+  EXPECT_FALSE(delta_.IsKeyframe());
+  EXPECT_TRUE(delta_.Changed().empty());
+  EXPECT_TRUE(delta_.RemovedIds().empty());
+}
+
+TEST_F(LandmarkDeltaTest, KeyframesFollowTheSteadyClock)
+{
+  // The layer does not change, still a keyframe with all landmarks is due every period.
+  const LandmarkList landmarks = {MakeLandmark(1, 0), MakeLandmark(2, 1)};
+  delta_.Update(landmarks, start_);
+
+  const auto almost = start_ + kKeyframePeriod - std::chrono::milliseconds(1);
+  EXPECT_FALSE(delta_.IsKeyframeDue(almost));
+  EXPECT_FALSE(delta_.Update(landmarks, almost));
+
+  const auto first = start_ + kKeyframePeriod;
+  EXPECT_TRUE(delta_.IsKeyframeDue(first));
+  ASSERT_TRUE(delta_.Update(landmarks, first));
+  EXPECT_TRUE(delta_.IsKeyframe());
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{1, 2}));
+
+  // The next period starts at the last keyframe.
+  EXPECT_FALSE(delta_.IsKeyframeDue(first + kKeyframePeriod / 2));
+  EXPECT_TRUE(delta_.IsKeyframeDue(first + kKeyframePeriod));
+}
+
+TEST_F(LandmarkDeltaTest, KeyframeDoesNotListRemovedIds)
+{
+  delta_.Update({MakeLandmark(1, 0), MakeLandmark(2, 1)}, start_);
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 0)}, start_ + kKeyframePeriod));
+  EXPECT_TRUE(delta_.IsKeyframe());
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{1}));
+  EXPECT_TRUE(delta_.RemovedIds().empty());
+
+  // The removed landmark is forgotten, it is not reported after the keyframe either.
+  ASSERT_FALSE(delta_.Update({MakeLandmark(1, 0)}, start_ + kKeyframePeriod));
+}
+
+TEST_F(LandmarkDeltaTest, ResetStartsWithAKeyframe)
+{
+  delta_.Update({MakeLandmark(1, 0)}, start_);
+  delta_.Reset();
+  EXPECT_FALSE(delta_.HasKeyframe());
+  ASSERT_TRUE(delta_.Update({MakeLandmark(1, 0)}, start_));
+  EXPECT_TRUE(delta_.IsKeyframe());
+  EXPECT_EQ(Ids(delta_.Changed()), (std::vector<uint64_t>{1}));
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "isaac_ros_visual_slam/impl/latency_histogram.hpp"
+
+using nvidia::isaac_ros::visual_slam::LatencyHistogram;
+using std::chrono::nanoseconds;
+
+namespace
+{
+
+constexpr std::array<double, 4> kQuantiles = {0.5, 0.9, 0.99, 0.999};
+
+// Maximum relative error of a reported value.
+constexpr double kRelativeError = 1.0 / LatencyHistogram::kSubBuckets;
+
+}  // namespace
+
+TEST(LatencyHistogramTest, EmptyReportsZero)
+{
+  const LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.MaxSeconds(), 0.0);
+  for (const double value : histogram.Percentiles(kQuantiles)) {
+    EXPECT_EQ(value, 0.0);
+  }
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact)
+{
+  // Values below kSubBuckets nanoseconds have a bucket of their own.
+  LatencyHistogram histogram;
+  for (int64_t ns = 1; ns <= 10; ns++) {
+    histogram.Record(nanoseconds(ns));
+  }
+  const auto percentiles = histogram.Percentiles(std::array<double, 3>{0.1, 0.5, 1.0});
+  EXPECT_DOUBLE_EQ(percentiles[0], 1e-9);
+  EXPECT_DOUBLE_EQ(percentiles[1], 5e-9);
+  EXPECT_DOUBLE_EQ(percentiles[2], 10e-9);
+  EXPECT_DOUBLE_EQ(histogram.MaxSeconds(), 10e-9);
+}
+
+TEST(LatencyHistogramTest, BucketBoundsWithinRelativeError)
+{
+  // Every value is reported as the upper bound of its bucket, which is never below the value and
+  // at most kRelativeError above it.
+  for (int64_t ns : {31, 32, 33, 63, 64, 65, 1000, 12345, 999999, 1000000, 123456789,
+      1000000000})
+  {
+    LatencyHistogram histogram;
+    histogram.Record(nanoseconds(ns));
+    const double reported = histogram.Percentiles(std::array<double, 1>{0.5})[0];
+    const double expected = ns / 1e9;
+    EXPECT_GE(reported, expected) << ns;
+    EXPECT_LE(reported, expected * (1.0 + kRelativeError)) << ns;
+  }
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformDistribution)
+{
+  LatencyHistogram histogram;
+  for (int64_t us = 1; us <= 1000; us++) {
+    histogram.Record(std::chrono::microseconds(us));
+  }
+  EXPECT_EQ(histogram.Count(), 1000u);
+  const auto percentiles = histogram.Percentiles(kQuantiles);
+  const std::array<double, 4> expected = {500e-6, 900e-6, 990e-6, 999e-6};
+  for (size_t i = 0; i < kQuantiles.size(); i++) {
+    EXPECT_GE(percentiles[i], expected[i]);
+    EXPECT_LE(percentiles[i], expected[i] * (1.0 + kRelativeError));
+  }
+  EXPECT_DOUBLE_EQ(histogram.MaxSeconds(), 1000e-6);
+}
+
+TEST(LatencyHistogramTest, TailIsNotHiddenByTheMedian)
+{
+  LatencyHistogram histogram;
+  for (int i = 0; i < 990; i++) {
+    histogram.Record(std::chrono::milliseconds(1));
+  }
+  for (int i = 0; i < 10; i++) {
+    histogram.Record(std::chrono::milliseconds(100));
+  }
+  const auto percentiles = histogram.Percentiles(kQuantiles);
+  EXPECT_LE(percentiles[0], 1e-3 * (1.0 + kRelativeError));
+  EXPECT_LE(percentiles[2], 1e-3 * (1.0 + kRelativeError));
+  EXPECT_GE(percentiles[3], 100e-3);
+}
+
+TEST(LatencyHistogramTest, ValuesAreClamped)
+{
+  LatencyHistogram histogram;
+  histogram.Record(nanoseconds(-5));
+  histogram.Record(std::chrono::hours(1));
+  const auto percentiles = histogram.Percentiles(std::array<double, 2>{0.5, 1.0});
+  EXPECT_EQ(percentiles[0], 0.0);
+  EXPECT_DOUBLE_EQ(histogram.MaxSeconds(), LatencyHistogram::kMaxValue * 1e-9);
+  EXPECT_GE(percentiles[1], LatencyHistogram::kMaxValue * 1e-9);
+}
+
+TEST(LatencyHistogramTest, RotateKeepsThePreviousWindow)
+{
+  LatencyHistogram histogram;
+  histogram.Record(std::chrono::milliseconds(100));
+  histogram.Rotate();
+  // The previous window is still reported.
+  EXPECT_EQ(histogram.Count(), 1u);
+  histogram.Record(std::chrono::milliseconds(1));
+  EXPECT_EQ(histogram.Count(), 2u);
+  EXPECT_DOUBLE_EQ(histogram.MaxSeconds(), 100e-3);
+
+  // The second rotation discards the 100 ms sample.
+  histogram.Rotate();
+  EXPECT_EQ(histogram.Count(), 1u);
+  EXPECT_DOUBLE_EQ(histogram.MaxSeconds(), 1e-3);
+  const double p99 = histogram.Percentiles(std::array<double, 1>{0.99})[0];
+  EXPECT_LE(p99, 1e-3 * (1.0 + kRelativeError));
+
+  histogram.Rotate();
+  EXPECT_EQ(histogram.Count(), 0u);
+}
+
+TEST(LatencyHistogramTest, Reset)
+{
+  LatencyHistogram histogram;
+  histogram.Record(std::chrono::milliseconds(1));
+  histogram.Rotate();
+  histogram.Record(std::chrono::milliseconds(2));
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.MaxSeconds(), 0.0);
+}
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "isaac_ros_visual_slam/impl/latest_value_cache.hpp"
+
+using LatestValueCache = nvidia::isaac_ros::visual_slam::LatestValueCache<int>;
+
+TEST(LatestValueCacheTest, EmptyFindsNothing)
+{
+  const LatestValueCache cache(2, 4);
+  std::optional<int> value;
+  EXPECT_FALSE(cache.Find(0, 0, 1000, value));
+  EXPECT_FALSE(value.has_value());
+  // Unknown channels are ignored.
+  EXPECT_FALSE(cache.Find(5, 0, 1000, value));
+}
+
+TEST(LatestValueCacheTest, FindsTheClosestValue)
+{
+  LatestValueCache cache(1, 4);
+  cache.Add(0, 100, 1);
+  cache.Add(0, 200, 2);
+  cache.Add(0, 300, 3);
+
+  std::optional<int> value;
+  ASSERT_TRUE(cache.Find(0, 200, 1000, value));
+  EXPECT_EQ(*value, 2);
+  ASSERT_TRUE(cache.Find(0, 140, 1000, value));
+  EXPECT_EQ(*value, 1);
+  ASSERT_TRUE(cache.Find(0, 260, 1000, value));
+  EXPECT_EQ(*value, 3);
+  ASSERT_TRUE(cache.Find(0, 5000, 10000, value));
+  EXPECT_EQ(*value, 3);
+}
+
+TEST(LatestValueCacheTest, TieSelectsTheNewerValue)
+{
+  LatestValueCache cache(1, 4);
+  cache.Add(0, 200, 2);
+  cache.Add(0, 100, 1);
+
+  std::optional<int> value;
+  ASSERT_TRUE(cache.Find(0, 150, 1000, value));
+  EXPECT_EQ(*value, 2);
+}
+
+TEST(LatestValueCacheTest, ToleranceIsInclusive)
+{
+  LatestValueCache cache(1, 4);
+  cache.Add(0, 100, 1);
+
+  std::optional<int> value = 42;
+  EXPECT_FALSE(cache.Find(0, 151, 50, value));
+  // The value is left untouched.
+  EXPECT_EQ(*value, 42);
+  ASSERT_TRUE(cache.Find(0, 150, 50, value));
+  EXPECT_EQ(*value, 1);
+  ASSERT_TRUE(cache.Find(0, 50, 50, value));
+  EXPECT_EQ(*value, 1);
+  EXPECT_FALSE(cache.Find(0, 49, 50, value));
+}
+
+TEST(LatestValueCacheTest, KeepsTheLastDepthValues)
+{
+  LatestValueCache cache(1, 3);
+  for (int i = 1; i <= 7; i++) {
+    cache.Add(0, i * 100, i);
+  }
+
+  // 100 to 400 were overwritten by the ring, 500 to 700 are left.
+  std::optional<int> value;
+  EXPECT_FALSE(cache.Find(0, 400, 10, value));
+  for (int i = 5; i <= 7; i++) {
+    ASSERT_TRUE(cache.Find(0, i * 100, 10, value));
+    EXPECT_EQ(*value, i);
+  }
+  ASSERT_TRUE(cache.Find(0, 400, 100, value));
+  EXPECT_EQ(*value, 5);
+}
+
+TEST(LatestValueCacheTest, ChannelsAreIndependent)
+{
+  LatestValueCache cache(2, 2);
+  cache.Add(0, 100, 1);
+  cache.Add(1, 110, 11);
+  // Unknown channels are ignored.
+  cache.Add(2, 100, 21);
+
+  std::optional<int> value;
+  ASSERT_TRUE(cache.Find(0, 110, 100, value));
+  EXPECT_EQ(*value, 1);
+  ASSERT_TRUE(cache.Find(1, 100, 100, value));
+  EXPECT_EQ(*value, 11);
+}
+
+TEST(LatestValueCacheTest, ClearRemovesAllValues)
+{
+  LatestValueCache cache(2, 2);
+  cache.Add(0, 100, 1);
+  cache.Add(1, 100, 11);
+  cache.Clear();
+
+  std::optional<int> value;
+  EXPECT_FALSE(cache.Find(0, 100, 1000, value));
+  EXPECT_FALSE(cache.Find(1, 100, 1000, value));
+
+  cache.Add(0, 200, 2);
+  ASSERT_TRUE(cache.Find(0, 100, 1000, value));
+  EXPECT_EQ(*value, 2);
+}
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/limited_vector.hpp"
+
+using nvidia::isaac_ros::visual_slam::limited_vector;
+
+TEST(LimitedVectorTest, KeepsValuesUntilFull)
+{
+  limited_vector<int> values(4);
+  values.add(1);
+  values.add(2);
+  EXPECT_EQ(values.size(), 2u);
+  EXPECT_EQ(values.numAdded(), 2u);
+  EXPECT_EQ(values[0], 1);
+  EXPECT_EQ(values[1], 2);
+
+  std::vector<int> out;
+  values.copyTo(out);
+  EXPECT_EQ(out, (std::vector<int>{1, 2}));
+}
+
+TEST(LimitedVectorTest, OverwritesTheOldestValue)
+{
+  limited_vector<int> values(3);
+  for (int i = 1; i <= 5; i++) {
+    values.add(i);
+  }
+  EXPECT_EQ(values.size(), 3u);
+  EXPECT_EQ(values.numAdded(), 5u);
+  EXPECT_EQ(values[0], 3);
+  EXPECT_EQ(values[2], 5);
+
+  std::vector<int> out;
+  values.copyTo(out);
+  EXPECT_EQ(out, (std::vector<int>{3, 4, 5}));
+}
+
+TEST(LimitedVectorTest, CopyLastAcrossTheWrap)
+{
+  limited_vector<int> values(5);
+  for (int i = 1; i <= 7; i++) {
+    values.add(i);
+  }
+  // Stored as {6, 7, 3, 4, 5}, the last values span both segments.
+  std::vector<int> out;
+  values.copyLast(3, out);
+  EXPECT_EQ(out, (std::vector<int>{5, 6, 7}));
+  values.copyLast(2, out);
+  EXPECT_EQ(out, (std::vector<int>{6, 7}));
+  values.copyLast(0, out);
+  EXPECT_TRUE(out.empty());
+  // More than stored is clamped to the whole buffer.
+  values.copyLast(100, out);
+  EXPECT_EQ(out, (std::vector<int>{3, 4, 5, 6, 7}));
+}
+
+TEST(LimitedVectorTest, CopyReusesTheCapacity)
+{
+  limited_vector<int> values(4);
+  for (int i = 0; i < 10; i++) {
+    values.add(i);
+  }
+  std::vector<int> out;
+  out.reserve(4);
+  const int * storage = out.data();
+  values.copyTo(out);
+  EXPECT_EQ(out.data(), storage);
+}
+
+TEST(LimitedVectorTest, ZeroSizeKeepsNothing)
+{
+  limited_vector<int> values(0);
+  values.add(1);
+  EXPECT_EQ(values.size(), 0u);
+  EXPECT_EQ(values.numAdded(), 1u);
+  std::vector<int> out{42};
+  values.copyTo(out);
+  EXPECT_TRUE(out.empty());
+}
+
+TEST(LimitedVectorTest, MatchesDequeForAllWrapPositions)
+{
+  for (uint max_size = 1; max_size <= 6; max_size++) {
+    limited_vector<int> values(max_size);
+    std::deque<int> expected;
+    for (int i = 0; i < 20; i++) {
+      values.add(i);
+      expected.push_back(i);
+      if (expected.size() > max_size) {
+        expected.pop_front();
+      }
+      ASSERT_EQ(values.size(), expected.size());
+      for (size_t j = 0; j < expected.size(); j++) {
+        ASSERT_EQ(values[j], expected[j]);
+      }
+      for (size_t count = 0; count <= expected.size(); count++) {
+        std::vector<int> out;
+        values.copyLast(count, out);
+        ASSERT_EQ(out, std::vector<int>(expected.end() - count, expected.end()))
+          << "max_size " << max_size << " added " << i + 1 << " count " << count;
+      }
+    }
+  }
+}
@@ -28,6 +28,7 @@ using MsgType = int64_t;
 using MessageSequence = std::vector<std::pair<StreamIndex, TimestampType>>;
 using MessageStreamSequencer = nvidia::isaac_ros::visual_slam::MessageStreamSequencer<MsgType,
     MsgType>;
+using MessageBatch = nvidia::isaac_ros::visual_slam::BatchView<MsgType>;
 
 // This test fixture provides easy access to common methods and member variables that are used
 // for validation and assertions
@@ -36,7 +37,7 @@ class MessageStreamSequencerTest : public ::testing::Test
 public:
   // This callback is called by the MessageStreamSequencer. The signature puts and emphasis on
   // 1 or more messages for stream1 (faster stream) to 1 msg of stream2
-  void Callback(std::vector<MsgType> stream1_msgs, MsgType stream2_msg)
+  void Callback(const MessageBatch & stream1_msgs, MsgType stream2_msg)
   {
     for (auto msg : stream1_msgs) {
       interleaved_seq.emplace_back(std::make_pair(1, msg));
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <optional>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/pose_history.hpp"
+
+using nvidia::isaac_ros::visual_slam::PoseHistory;
+
+namespace
+{
+
+constexpr int64_t kMaxExtrapolationNs = 20;
+constexpr double kTolerance = 1e-9;
+
+// Pose at x along the x axis, rotated by yaw around the z axis.
+tf2::Transform MakePose(double x, double yaw)
+{
+  return tf2::Transform(tf2::Quaternion(tf2::Vector3(0, 0, 1), yaw), tf2::Vector3(x, 0, 0));
+}
+
+std::optional<tf2::Transform> GetPose(
+  const PoseHistory & history, int64_t timestamp,
+  PoseHistory::Frame frame = PoseHistory::Frame::kOdom)
+{
+  std::vector<std::optional<tf2::Transform>> poses;
+  history.GetPoses(frame, {timestamp}, poses);
+  return poses[0];
+}
+
+void ExpectPose(const std::optional<tf2::Transform> & pose, double x, double yaw)
+{
+  ASSERT_TRUE(pose.has_value());
+  EXPECT_NEAR(pose->getOrigin().x(), x, kTolerance);
+  const tf2::Quaternion expected(tf2::Vector3(0, 0, 1), yaw);
+  EXPECT_NEAR(pose->getRotation().angleShortestPath(expected), 0.0, 1e-6);
+}
+
+}  // namespace
+
+TEST(PoseHistoryTest, EmptyAnswersNothing)
+{
+  const PoseHistory history(10, kMaxExtrapolationNs);
+  EXPECT_FALSE(GetPose(history, 0).has_value());
+}
+
+TEST(PoseHistoryTest, InterpolatesBetweenPoses)
+{
+  PoseHistory history(10, kMaxExtrapolationNs);
+  history.Add(0, MakePose(0, 0), MakePose(100, 0));
+  history.Add(100, MakePose(10, M_PI / 2), MakePose(110, 0));
+
+  ExpectPose(GetPose(history, 0), 0, 0);
+  ExpectPose(GetPose(history, 100), 10, M_PI / 2);
+  ExpectPose(GetPose(history, 50), 5, M_PI / 4);
+  ExpectPose(GetPose(history, 25), 2.5, M_PI / 8);
+  // The map poses are kept separately.
+  ExpectPose(GetPose(history, 50, PoseHistory::Frame::kMap), 105, 0);
+}
+
+TEST(PoseHistoryTest, BatchKeepsTheRequestOrder)
+{
+  PoseHistory history(10, kMaxExtrapolationNs);
+  history.Add(0, MakePose(0, 0), MakePose(0, 0));
+  history.Add(100, MakePose(10, 0), MakePose(10, 0));
+
+  std::vector<std::optional<tf2::Transform>> poses;
+  EXPECT_EQ(history.GetPoses(PoseHistory::Frame::kOdom, {70, 1000, 10}, poses), 2u);
+  ASSERT_EQ(poses.size(), 3u);
+  ExpectPose(poses[0], 7, 0);
+  EXPECT_FALSE(poses[1].has_value());
+  ExpectPose(poses[2], 1, 0);
+}
+
+TEST(PoseHistoryTest, ExtrapolatesUpToTheLimit)
+{
+  PoseHistory history(10, kMaxExtrapolationNs);
+  history.Add(100, MakePose(10, 0), MakePose(10, 0));
+  // A single pose has no motion to extrapolate with.
+  EXPECT_FALSE(GetPose(history, 110).has_value());
+
+  history.Add(200, MakePose(20, 0), MakePose(20, 0));
+  ExpectPose(GetPose(history, 200 + kMaxExtrapolationNs), 22, 0);
+  EXPECT_FALSE(GetPose(history, 200 + kMaxExtrapolationNs + 1).has_value());
+  ExpectPose(GetPose(history, 100 - kMaxExtrapolationNs), 8, 0);
+  EXPECT_FALSE(GetPose(history, 100 - kMaxExtrapolationNs - 1).has_value());
+}
+
+TEST(PoseHistoryTest, NothingAcrossATrackingGap)
+{
+  PoseHistory history(10, kMaxExtrapolationNs);
+  history.Add(0, MakePose(0, 0), MakePose(0, 0));
+  history.Add(100, MakePose(10, 0), MakePose(10, 0));
+  history.MarkDiscontinuity();
+  // No extrapolation past the newest pose while tracking is lost.
+  ExpectPose(GetPose(history, 100), 10, 0);
+  EXPECT_FALSE(GetPose(history, 110).has_value());
+
+  history.Add(200, MakePose(50, 0), MakePose(50, 0));
+  history.Add(300, MakePose(60, 0), MakePose(60, 0));
+  EXPECT_FALSE(GetPose(history, 150).has_value());
+  ExpectPose(GetPose(history, 50), 5, 0);
+  ExpectPose(GetPose(history, 250), 55, 0);
+  ExpectPose(GetPose(history, 310), 61, 0);
+  // The pose right after the gap does not extrapolate with the motion across it.
+  history.Reset();
+  history.Add(0, MakePose(0, 0), MakePose(0, 0));
+  history.MarkDiscontinuity();
+  history.Add(100, MakePose(10, 0), MakePose(10, 0));
+  EXPECT_FALSE(GetPose(history, -10).has_value());
+  EXPECT_FALSE(GetPose(history, 110).has_value());
+}
+
+TEST(PoseHistoryTest, KeepsTheNewestPosesInTheRing)
+{
+  PoseHistory history(3, kMaxExtrapolationNs);
+  for (int i = 0; i < 7; i++) {
+    history.Add(i * 100, MakePose(i * 10, 0), MakePose(i * 10, 0));
+  }
+  // Poses 4, 5 and 6 are left.
+  EXPECT_FALSE(GetPose(history, 350).has_value());
+  ExpectPose(GetPose(history, 400), 40, 0);
+  ExpectPose(GetPose(history, 450), 45, 0);
+  ExpectPose(GetPose(history, 550), 55, 0);
+  ExpectPose(GetPose(history, 600), 60, 0);
+}
+
+TEST(PoseHistoryTest, TimeJumpBackClearsTheHistory)
+{
+  PoseHistory history(10, kMaxExtrapolationNs);
+  history.Add(1000, MakePose(10, 0), MakePose(10, 0));
+  history.Add(1100, MakePose(20, 0), MakePose(20, 0));
+  history.Add(0, MakePose(0, 0), MakePose(0, 0));
+  EXPECT_FALSE(GetPose(history, 1050).has_value());
+  ExpectPose(GetPose(history, 0), 0, 0);
+}
+
+TEST(PoseHistoryTest, EqualTimestampReplacesTheNewestPose)
+{
+  PoseHistory history(10, kMaxExtrapolationNs);
+  history.Add(0, MakePose(0, 0), MakePose(0, 0));
+  history.Add(100, MakePose(10, 0), MakePose(10, 0));
+  history.Add(100, MakePose(20, 0), MakePose(20, 0));
+  ExpectPose(GetPose(history, 100), 20, 0);
+  ExpectPose(GetPose(history, 50), 10, 0);
+}
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/rig_cache.hpp"
+
+using nvidia::isaac_ros::visual_slam::RigCache;
+
+namespace
+{
+
+const std::vector<std::string> kConfig = {"base_link", "camera_0", "imu"};
+
+std::shared_ptr<CameraInfoType> MakeCameraInfo(const std::string & frame_id, double fx)
+{
+  auto msg = std::make_shared<CameraInfoType>();
+  msg->header.frame_id = frame_id;
+  msg->width = 640;
+  msg->height = 480;
+  msg->k = {fx, 0, 320, 0, fx, 240, 0, 0, 1};
+  return msg;
+}
+
+// Expects Load() to throw a std::runtime_error whose message contains expected.
+void ExpectLoadFails(const RigCache & cache, const std::string & expected)
+{
+  try {
+    cache.Load();
+    FAIL() << "Load() did not throw";
+  } catch (const std::runtime_error & e) {
+    EXPECT_NE(std::string(e.what()).find(expected), std::string::npos) << e.what();
+  }
+}
+
+}  // namespace
+
+// Every test writes to a directory of its own below the system temporary directory.
+class RigCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    const auto * test = ::testing::UnitTest::GetInstance()->current_test_info();
+    directory_ = std::filesystem::temp_directory_path() /
+      ("rig_cache_test_" + std::to_string(getpid()) + "_" + test->name());
+    std::filesystem::remove_all(directory_);
+  }
+
+  void TearDown() override {std::filesystem::remove_all(directory_);}
+
+  RigCache::Contents MakeContents() const
+  {
+    RigCache::Contents contents;
+    contents.camera_infos[0] = MakeCameraInfo("camera_0", 500);
+    contents.camera_infos[1] = MakeCameraInfo("camera_1", 510);
+    auto imu = std::make_shared<ImuType>();
+    imu->header.frame_id = "imu";
+    contents.imu = imu;
+    contents.transforms[{"base_link", "camera_0"}] = tf2::Transform(
+      tf2::Quaternion(0, 0, 0, 1), tf2::Vector3(0.1, 0.2, 0.3));
+    return contents;
+  }
+
+  // Overwrites the bytes at offset of the cache file.
+  void Patch(const RigCache & cache, std::streamoff offset, const std::string & bytes) const
+  {
+    std::fstream file(cache.Path(), std::ios::binary | std::ios::in | std::ios::out);
+    ASSERT_TRUE(file);
+    file.seekp(offset);
+    file.write(bytes.data(), bytes.size());
+  }
+
+  std::filesystem::path directory_;
+};
+
+TEST_F(RigCacheTest, RoundTrip)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  EXPECT_FALSE(cache.Exists());
+  cache.Save(MakeContents());
+  EXPECT_TRUE(cache.Exists());
+  EXPECT_EQ(std::filesystem::path(cache.Path()).parent_path(), directory_);
+  // No temporary file is left behind.
+  EXPECT_EQ(
+    std::distance(
+      std::filesystem::directory_iterator(directory_), std::filesystem::directory_iterator()), 1);
+
+  const RigCache::Contents contents = cache.Load();
+  ASSERT_EQ(contents.camera_infos.size(), 2u);
+  EXPECT_EQ(contents.camera_infos.at(0)->header.frame_id, "camera_0");
+  EXPECT_EQ(contents.camera_infos.at(1)->header.frame_id, "camera_1");
+  EXPECT_EQ(contents.camera_infos.at(1)->width, 640u);
+  EXPECT_EQ(contents.camera_infos.at(1)->k[0], 510);
+  ASSERT_NE(contents.imu, nullptr);
+  EXPECT_EQ(contents.imu->header.frame_id, "imu");
+  ASSERT_EQ(contents.transforms.size(), 1u);
+  const tf2::Transform & transform = contents.transforms.at({"base_link", "camera_0"});
+  EXPECT_EQ(transform.getOrigin().x(), 0.1);
+  EXPECT_EQ(transform.getOrigin().z(), 0.3);
+  EXPECT_EQ(transform.getRotation().w(), 1);
+
+  cache.Remove();
+  EXPECT_FALSE(cache.Exists());
+}
+
+TEST_F(RigCacheTest, RoundTripWithoutImu)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  RigCache::Contents contents = MakeContents();
+  contents.imu = nullptr;
+  cache.Save(contents);
+  EXPECT_EQ(cache.Load().imu, nullptr);
+}
+
+TEST_F(RigCacheTest, ConfigurationsUseDifferentFiles)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  const RigCache other(directory_.string(), {"base_link", "camera_1", "imu"});
+  EXPECT_NE(cache.Path(), other.Path());
+  cache.Save(MakeContents());
+  EXPECT_FALSE(other.Exists());
+  ExpectLoadFails(other, "could not open");
+}
+
+TEST_F(RigCacheTest, RejectsAHashMismatch)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  const RigCache other(directory_.string(), {"base_link", "camera_1", "imu"});
+  cache.Save(MakeContents());
+  // A file of another configuration under this name, e.g. copied by hand.
+  std::filesystem::copy_file(cache.Path(), other.Path());
+  ExpectLoadFails(other, "different version or configuration");
+}
+
+TEST_F(RigCacheTest, RejectsAVersionMismatch)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  cache.Save(MakeContents());
+  // The version follows the 8 byte magic.
+  Patch(cache, 8, std::string("\xff\xff\xff\xff", 4));
+  ExpectLoadFails(cache, "different version or configuration");
+}
+
+TEST_F(RigCacheTest, RejectsABadMagic)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  cache.Save(MakeContents());
+  Patch(cache, 0, "XXXX");
+  ExpectLoadFails(cache, "different version or configuration");
+}
+
+TEST_F(RigCacheTest, RejectsATruncatedFile)
+{
+  const RigCache cache(directory_.string(), kConfig);
+  cache.Save(MakeContents());
+  const uintmax_t size = std::filesystem::file_size(cache.Path());
+  // Cut in the transforms, in the messages and in the header.
+  for (const uintmax_t truncated_size : {size - 1, size / 2, uintmax_t{10}}) {
+    std::filesystem::resize_file(cache.Path(), truncated_size);
+    ExpectLoadFails(cache, "truncated rig cache");
+  }
+}
+
+TEST(RigCacheHashTest, HashCameraInfoFollowsTheCalibration)
+{
+  const auto camera_info = MakeCameraInfo("camera_0", 500);
+  EXPECT_EQ(
+    RigCache::HashCameraInfo(*camera_info),
+    RigCache::HashCameraInfo(*MakeCameraInfo("camera_0", 500)));
+  EXPECT_NE(
+    RigCache::HashCameraInfo(*camera_info),
+    RigCache::HashCameraInfo(*MakeCameraInfo("camera_0", 501)));
+  EXPECT_NE(
+    RigCache::HashCameraInfo(*camera_info),
+    RigCache::HashCameraInfo(*MakeCameraInfo("camera_1", 500)));
+}
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <random>
+
+#include "isaac_ros_visual_slam/impl/pose_cache.hpp"
+
+using nvidia::isaac_ros::visual_slam::RunningCovariance;
+
+namespace
+{
+
+using Statistics = RunningCovariance<3>;
+
+// Population mean and covariance of the samples, computed from scratch.
+void BruteForce(
+  const std::deque<Statistics::Vector> & samples, Statistics::Vector & mean,
+  Statistics::Matrix & covariance)
+{
+  mean.setZero();
+  for (const auto & x : samples) {
+    mean += x;
+  }
+  mean /= samples.size();
+  covariance.setZero();
+  for (const auto & x : samples) {
+    covariance += (x - mean) * (x - mean).transpose();
+  }
+  covariance /= samples.size();
+}
+
+}  // namespace
+
+TEST(RunningCovarianceTest, SingleSampleHasZeroCovariance)
+{
+  Statistics statistics;
+  statistics.Add(Statistics::Vector(1.0, 2.0, 3.0));
+  EXPECT_EQ(statistics.Count(), 1u);
+  EXPECT_TRUE(statistics.Mean().isApprox(Statistics::Vector(1.0, 2.0, 3.0)));
+  EXPECT_TRUE(statistics.Covariance().isZero());
+}
+
+TEST(RunningCovarianceTest, RemovingTheLastSampleResets)
+{
+  Statistics statistics;
+  statistics.Add(Statistics::Vector(1.0, 2.0, 3.0));
+  statistics.Remove(Statistics::Vector(1.0, 2.0, 3.0));
+  EXPECT_EQ(statistics.Count(), 0u);
+  EXPECT_TRUE(statistics.Mean().isZero());
+
+  statistics.Add(Statistics::Vector(4.0, 5.0, 6.0));
+  EXPECT_TRUE(statistics.Mean().isApprox(Statistics::Vector(4.0, 5.0, 6.0)));
+  EXPECT_TRUE(statistics.Covariance().isZero());
+}
+
+TEST(RunningCovarianceTest, MatchesBruteForceOverASlidingWindow)
+{
+  constexpr size_t kWindowSize = 10;
+  std::mt19937 generator(42);
+  // Correlated samples with an offset, the offset stresses the cancellation in the update.
+  std::normal_distribution<double> noise(0.0, 0.5);
+
+  Statistics statistics;
+  std::deque<Statistics::Vector> window;
+  for (int i = 0; i < 1000; i++) {
+    const double a = noise(generator);
+    const Statistics::Vector x(100.0 + a, -50.0 + 2.0 * a + noise(generator),
+      0.01 * i + noise(generator));
+    statistics.Add(x);
+    window.push_back(x);
+    if (window.size() > kWindowSize) {
+      statistics.Remove(window.front());
+      window.pop_front();
+    }
+
+    Statistics::Vector mean;
+    Statistics::Matrix covariance;
+    BruteForce(window, mean, covariance);
+    ASSERT_EQ(statistics.Count(), window.size());
+    ASSERT_TRUE(statistics.Mean().isApprox(mean, 1e-9)) << "sample " << i;
+    ASSERT_LT((statistics.Covariance() - covariance).cwiseAbs().maxCoeff(), 1e-8)
+      << "sample " << i;
+  }
+}
+
+TEST(RunningCovarianceTest, ResetClearsTheStatistics)
+{
+  Statistics statistics;
+  statistics.Add(Statistics::Vector(1.0, 0.0, 0.0));
+  statistics.Add(Statistics::Vector(-1.0, 0.0, 0.0));
+  EXPECT_DOUBLE_EQ(statistics.Covariance()(0, 0), 1.0);
+  statistics.Reset();
+  EXPECT_EQ(statistics.Count(), 0u);
+  EXPECT_TRUE(statistics.Mean().isZero());
+
+  statistics.Add(Statistics::Vector(2.0, 2.0, 2.0));
+  EXPECT_TRUE(statistics.Covariance().isZero());
+}
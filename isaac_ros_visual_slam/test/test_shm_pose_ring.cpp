@@ -0,0 +1,297 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include "isaac_ros_visual_slam/shm_pose_ring.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+// Unique per process, so that tests running in parallel do not share rings.
+std::string RingName(const std::string & test)
+{
+  return "/isaac_ros_visual_slam_test_" + test + "_" + std::to_string(getpid());
+}
+
+// Every value of the record is derived from index, so that a torn read is detected.
+ShmPoseRecord MakeRecord(uint64_t index)
+{
+  ShmPoseRecord record{};
+  const double value = static_cast<double>(index);
+  record.timestamp_ns = static_cast<int64_t>(index);
+  record.write_time_ns = static_cast<int64_t>(index);
+  record.vo_state = 1;
+  std::fill(std::begin(record.vo_pose), std::end(record.vo_pose), value);
+  std::fill(std::begin(record.slam_pose), std::end(record.slam_pose), value);
+  std::fill(std::begin(record.pose_covariance), std::end(record.pose_covariance), value);
+  std::fill(std::begin(record.twist), std::end(record.twist), value);
+  std::fill(std::begin(record.twist_covariance), std::end(record.twist_covariance), value);
+  return record;
+}
+
+bool IsRecord(const ShmPoseRecord & record, uint64_t index)
+{
+  const ShmPoseRecord expected = MakeRecord(index);
+  return std::memcmp(&record, &expected, sizeof(record)) == 0;
+}
+
+// A shared memory object that is not written by ShmPoseRingWriter.
+class RawShm
+{
+public:
+  RawShm(const std::string & name, size_t size)
+  : name_(name), size_(size)
+  {
+    const int fd = shm_open(name_.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "shm_open of " + name_);
+    }
+    if (ftruncate(fd, size_) != 0) {
+      const int error = errno;
+      close(fd);
+      throw std::system_error(error, std::generic_category(), "ftruncate of " + name_);
+    }
+    memory_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory_ == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "mmap of " + name_);
+    }
+  }
+
+  ~RawShm()
+  {
+    munmap(memory_, size_);
+    shm_unlink(name_.c_str());
+  }
+
+  // The zero filled header of a ring with capacity slots, for the test to edit.
+  ShmPoseRingHeader & Header(uint32_t capacity)
+  {
+    ShmPoseRingHeader & header = *new (memory_) ShmPoseRingHeader;
+    header.magic = ShmPoseRingHeader::kMagic;
+    header.version = ShmPoseRingHeader::kVersion;
+    header.capacity = capacity;
+    header.record_size = sizeof(ShmPoseRecord);
+    header.num_written.store(0);
+    return header;
+  }
+
+private:
+  std::string name_;
+  size_t size_;
+  void * memory_;
+};
+
+constexpr uint32_t kCapacity = 4;
+const size_t kRingSize = sizeof(ShmPoseRingHeader) + kCapacity * sizeof(ShmPoseRingSlot);
+
+}  // namespace
+
+TEST(ShmPoseRingTest, RecordsRoundTrip)
+{
+  ShmPoseRingWriter writer(RingName("round_trip"), kCapacity);
+  ShmPoseRingReader reader(RingName("round_trip"));
+
+  ShmPoseRecord record;
+  EXPECT_EQ(reader.NumWritten(), 0u);
+  EXPECT_FALSE(reader.ReadLatest(record));
+  EXPECT_FALSE(reader.ReadNext(record));
+
+  writer.Write(MakeRecord(1));
+  writer.Write(MakeRecord(2));
+  EXPECT_EQ(reader.NumWritten(), 2u);
+  ASSERT_TRUE(reader.ReadLatest(record));
+  EXPECT_TRUE(IsRecord(record, 2));
+
+  ASSERT_TRUE(reader.ReadNext(record));
+  EXPECT_TRUE(IsRecord(record, 1));
+  ASSERT_TRUE(reader.ReadNext(record));
+  EXPECT_TRUE(IsRecord(record, 2));
+  EXPECT_FALSE(reader.ReadNext(record));
+  EXPECT_EQ(reader.NumSkipped(), 0u);
+}
+
+TEST(ShmPoseRingTest, NameWithoutSlash)
+{
+  const std::string name = RingName("no_slash");
+  ShmPoseRingWriter writer(name.substr(1), kCapacity);
+  ShmPoseRingReader reader(name);
+  writer.Write(MakeRecord(7));
+  ShmPoseRecord record;
+  ASSERT_TRUE(reader.ReadLatest(record));
+  EXPECT_TRUE(IsRecord(record, 7));
+}
+
+TEST(ShmPoseRingTest, WriterRemovesTheRing)
+{
+  const std::string name = RingName("removed");
+  {
+    ShmPoseRingWriter writer(name, kCapacity);
+  }
+  EXPECT_THROW(ShmPoseRingReader reader(name), std::system_error);
+}
+
+TEST(ShmPoseRingTest, RejectsUnexpectedLayouts)
+{
+  const std::string name = RingName("layout");
+  {
+    RawShm shm(name, sizeof(ShmPoseRingHeader) / 2);
+    EXPECT_THROW(ShmPoseRingReader reader(name), std::runtime_error);
+  }
+  {
+    RawShm shm(name, kRingSize);
+    shm.Header(kCapacity).magic = 0;
+    EXPECT_THROW(ShmPoseRingReader reader(name), std::runtime_error);
+  }
+  {
+    RawShm shm(name, kRingSize);
+    shm.Header(kCapacity).version = ShmPoseRingHeader::kVersion + 1;
+    EXPECT_THROW(ShmPoseRingReader reader(name), std::runtime_error);
+  }
+  {
+    RawShm shm(name, kRingSize);
+    shm.Header(kCapacity).record_size = sizeof(ShmPoseRecord) + 8;
+    EXPECT_THROW(ShmPoseRingReader reader(name), std::runtime_error);
+  }
+  {
+    // More slots than fit into the shared memory.
+    RawShm shm(name, kRingSize);
+    shm.Header(kCapacity + 1);
+    EXPECT_THROW(ShmPoseRingReader reader(name), std::runtime_error);
+  }
+  {
+    RawShm shm(name, kRingSize);
+    shm.Header(kCapacity);
+    EXPECT_NO_THROW(ShmPoseRingReader reader(name));
+  }
+}
+
+TEST(ShmPoseRingTest, ReadLatestAfterTheWriterLappedTheRing)
+{
+  ShmPoseRingWriter writer(RingName("latest"), kCapacity);
+  ShmPoseRingReader reader(RingName("latest"));
+  for (uint64_t i = 0; i < 3 * kCapacity + 1; i++) {
+    writer.Write(MakeRecord(i));
+  }
+  ShmPoseRecord record;
+  ASSERT_TRUE(reader.ReadLatest(record));
+  EXPECT_TRUE(IsRecord(record, 3 * kCapacity));
+}
+
+TEST(ShmPoseRingTest, ReadNextSkipsOverwrittenRecords)
+{
+  ShmPoseRingWriter writer(RingName("skip"), kCapacity);
+  ShmPoseRingReader reader(RingName("skip"));
+  writer.Write(MakeRecord(0));
+  writer.Write(MakeRecord(1));
+  ShmPoseRecord record;
+  ASSERT_TRUE(reader.ReadNext(record));
+  EXPECT_TRUE(IsRecord(record, 0));
+
+  // Records 1 to 7 are overwritten before the reader gets to them.
+  for (uint64_t i = 2; i < 12; i++) {
+    writer.Write(MakeRecord(i));
+  }
+  for (uint64_t i = 8; i < 12; i++) {
+    ASSERT_TRUE(reader.ReadNext(record));
+    EXPECT_TRUE(IsRecord(record, i));
+  }
+  EXPECT_FALSE(reader.ReadNext(record));
+  EXPECT_EQ(reader.NumSkipped(), 7u);
+}
+
+TEST(ShmPoseRingTest, LateReaderStartsWithTheOldestRecord)
+{
+  ShmPoseRingWriter writer(RingName("late"), kCapacity);
+  for (uint64_t i = 0; i < 10; i++) {
+    writer.Write(MakeRecord(i));
+  }
+  ShmPoseRingReader reader(RingName("late"));
+  ShmPoseRecord record;
+  ASSERT_TRUE(reader.ReadNext(record));
+  EXPECT_TRUE(IsRecord(record, 10 - kCapacity));
+  EXPECT_EQ(reader.NumSkipped(), 0u);
+}
+
+TEST(ShmPoseRingTest, ConcurrentReadsAreNeverTorn)
+{
+  // The writer laps the small ring constantly, the seqlock has to reject every slot that is
+  // rewritten while it is copied.
+  ShmPoseRingWriter writer(RingName("concurrent"), 2);
+  ShmPoseRingReader latest_reader(RingName("concurrent"));
+  ShmPoseRingReader next_reader(RingName("concurrent"));
+  constexpr uint64_t kNumRecords = 200000;
+  std::atomic<bool> done{false};
+  std::thread writer_thread([&]() {
+      for (uint64_t i = 0; i < kNumRecords; i++) {
+        writer.Write(MakeRecord(i));
+      }
+      done = true;
+    });
+
+  ShmPoseRecord record;
+  int64_t last_latest = -1;
+  int64_t last_next = -1;
+  uint64_t num_read = 0;
+  while (!done) {
+    if (latest_reader.ReadLatest(record)) {
+      ASSERT_TRUE(IsRecord(record, record.timestamp_ns));
+      ASSERT_GE(record.timestamp_ns, last_latest);
+      last_latest = record.timestamp_ns;
+    }
+    if (next_reader.ReadNext(record)) {
+      ASSERT_TRUE(IsRecord(record, record.timestamp_ns));
+      ASSERT_GT(record.timestamp_ns, last_next);
+      last_next = record.timestamp_ns;
+      num_read++;
+    }
+  }
+  writer_thread.join();
+  while (next_reader.ReadNext(record)) {
+    ASSERT_TRUE(IsRecord(record, record.timestamp_ns));
+    num_read++;
+  }
+  EXPECT_EQ(num_read + next_reader.NumSkipped(), kNumRecords);
+  ASSERT_TRUE(latest_reader.ReadLatest(record));
+  EXPECT_TRUE(IsRecord(record, kNumRecords - 1));
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/spsc_ring_buffer.hpp"
+
+using nvidia::isaac_ros::visual_slam::SpscRingBuffer;
+
+TEST(SpscRingBufferTest, PopsInPushOrder)
+{
+  SpscRingBuffer<int> ring(3);
+  EXPECT_TRUE(ring.IsEmpty());
+  EXPECT_EQ(ring.FrontTimeStamp(), std::numeric_limits<int64_t>::max());
+
+  EXPECT_TRUE(ring.Push(10, 1));
+  EXPECT_TRUE(ring.Push(20, 2));
+  EXPECT_EQ(ring.Size(), 2u);
+  EXPECT_EQ(ring.FrontTimeStamp(), 10);
+
+  int msg = 0;
+  EXPECT_TRUE(ring.PopInto(msg));
+  EXPECT_EQ(msg, 1);
+  EXPECT_EQ(ring.FrontTimeStamp(), 20);
+  EXPECT_TRUE(ring.PopInto(msg));
+  EXPECT_EQ(msg, 2);
+  EXPECT_FALSE(ring.PopInto(msg));
+  EXPECT_FALSE(ring.Drop());
+}
+
+TEST(SpscRingBufferTest, WrapsAround)
+{
+  SpscRingBuffer<int> ring(3);
+  int msg = 0;
+  // Run the counters several times around the ring with a varying fill level.
+  int next_push = 0;
+  int next_pop = 0;
+  for (int round = 0; round < 10; round++) {
+    for (int i = 0; i < 1 + round % 3; i++) {
+      ASSERT_TRUE(ring.Push(next_push, next_push));
+      next_push++;
+    }
+    while (ring.PopInto(msg)) {
+      EXPECT_EQ(msg, next_pop);
+      next_pop++;
+    }
+  }
+  EXPECT_EQ(next_pop, next_push);
+  EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(SpscRingBufferTest, RejectsPushWhenFull)
+{
+  SpscRingBuffer<int> ring(2);
+  EXPECT_TRUE(ring.Push(1, 1));
+  EXPECT_TRUE(ring.Push(2, 2));
+  EXPECT_TRUE(ring.IsFull());
+  EXPECT_FALSE(ring.Push(3, 3));
+  EXPECT_EQ(ring.Size(), 2u);
+  EXPECT_EQ(ring.FrontTimeStamp(), 1);
+}
+
+TEST(SpscRingBufferTest, DropOldestMakesRoom)
+{
+  // This is how the sequencer keeps the newest messages when a stream is full.
+  SpscRingBuffer<int> ring(2);
+  for (int i = 1; i <= 5; i++) {
+    if (ring.IsFull()) {
+      ASSERT_TRUE(ring.Drop());
+    }
+    ASSERT_TRUE(ring.Push(i, i));
+  }
+  int msg = 0;
+  ASSERT_TRUE(ring.PopInto(msg));
+  EXPECT_EQ(msg, 4);
+  ASSERT_TRUE(ring.PopInto(msg));
+  EXPECT_EQ(msg, 5);
+  EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(SpscRingBufferTest, PopIntoKeepsCapacity)
+{
+  SpscRingBuffer<std::vector<int>> ring(1);
+  std::vector<int> msg;
+  msg.reserve(16);
+  const int * storage = msg.data();
+
+  ASSERT_TRUE(ring.Push(1, std::vector<int>{1, 2, 3}));
+  // The caller's storage is swapped into the slot and cleared there.
+  ASSERT_TRUE(ring.PopInto(msg));
+  EXPECT_EQ(msg, (std::vector<int>{1, 2, 3}));
+
+  // The next push copies into the storage that was handed over, without reallocating it.
+  ASSERT_TRUE(ring.Push(2, std::vector<int>{4, 5}));
+  std::vector<int> next;
+  ASSERT_TRUE(ring.PopInto(next));
+  EXPECT_EQ(next, (std::vector<int>{4, 5}));
+  EXPECT_EQ(next.data(), storage);
+  EXPECT_GE(next.capacity(), 16u);
+}
+
+TEST(SpscRingBufferTest, DropReleasesTheMessage)
+{
+  SpscRingBuffer<std::vector<int>> ring(1);
+  ASSERT_TRUE(ring.Push(1, std::vector<int>{1, 2, 3}));
+  ASSERT_TRUE(ring.Drop());
+  EXPECT_TRUE(ring.IsEmpty());
+
+  // The dropped slot is cleared, so an empty message comes out after the next push.
+  ASSERT_TRUE(ring.Push(2, std::vector<int>{}));
+  std::vector<int> msg{7};
+  ASSERT_TRUE(ring.PopInto(msg));
+  EXPECT_TRUE(msg.empty());
+}
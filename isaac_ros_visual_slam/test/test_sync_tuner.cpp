@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/sync_tuner.hpp"
+
+using nvidia::isaac_ros::visual_slam::SyncTuner;
+
+namespace
+{
+
+constexpr int64_t kMs = 1000000;
+// 30 Hz cameras.
+constexpr int64_t kPeriodNs = 33333333;
+
+const SyncTuner::Config kMin{100000, 2};
+const SyncTuner::Config kMax{50 * kMs, 20};
+
+// Synthetic image streams with a fixed offset per stream and uniform timestamp jitter.
+struct Streams
+{
+  std::vector<int64_t> offsets_ns;
+  int64_t jitter_ns = 0;
+  int64_t sync_wait_ns = 0;
+};
+
+// Feeds num_frames frame sets and retunes after every set like the node does. Returns the number
+// of applied retunes, config holds the last applied config.
+int Feed(SyncTuner & tuner, const Streams & streams, int num_frames, SyncTuner::Config & config)
+{
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int64_t> jitter(-streams.jitter_ns, streams.jitter_ns);
+  int num_retunes = 0;
+  for (int frame = 0; frame < num_frames; frame++) {
+    for (size_t i = 0; i < streams.offsets_ns.size(); i++) {
+      tuner.AddImage(
+        static_cast<int>(i), 1000 * kMs + frame * kPeriodNs + streams.offsets_ns[i] +
+        jitter(generator));
+    }
+    tuner.AddSyncWait(streams.sync_wait_ns);
+    num_retunes += tuner.Retune(config);
+  }
+  return num_retunes;
+}
+
+}  // namespace
+
+TEST(SyncTunerTest, NothingBeforeTheWarmUp)
+{
+  SyncTuner tuner(2, {10 * kMs, 10}, kMin, kMax);
+  SyncTuner::Config config{};
+  // 100 frame sets of two images stay below the retune period.
+  EXPECT_EQ(Feed(tuner, {{0, 0}}, 100, config), 0);
+  EXPECT_EQ(tuner.GetStatistics().num_retunes, 0u);
+  EXPECT_EQ(tuner.GetStatistics().config.matching_threshold_ns, 10 * kMs);
+}
+
+TEST(SyncTunerTest, HardwareTriggeredTightensTheWindow)
+{
+  SyncTuner tuner(2, {10 * kMs, 10}, kMin, kMax);
+  SyncTuner::Config config{};
+  EXPECT_GE(Feed(tuner, {{0, kMs / 5}, 0, kMs}, 400, config), 1);
+  // 1.5 times the 0.2 ms skew.
+  EXPECT_NEAR(config.matching_threshold_ns, 3 * kMs / 10, kMs / 100);
+  // One period of wait plus the margin, shrunk from 10.
+  EXPECT_EQ(config.buffer_size, 3u);
+
+  const SyncTuner::Statistics statistics = tuner.GetStatistics();
+  EXPECT_NEAR(statistics.max_period_ms, kPeriodNs * 1e-6, 1e-3);
+  EXPECT_NEAR(statistics.skew_ms, 0.2, 1e-3);
+  EXPECT_EQ(statistics.config.matching_threshold_ns, config.matching_threshold_ns);
+}
+
+TEST(SyncTunerTest, SmallChangesAreNotApplied)
+{
+  // The skew of 5 ms recommends 7.5 ms, within the hysteresis of the current 7 ms, and the
+  // recommended buffer of 3 is not smaller by the margin.
+  SyncTuner tuner(2, {7 * kMs, 4}, kMin, kMax);
+  SyncTuner::Config config{};
+  EXPECT_EQ(Feed(tuner, {{0, 5 * kMs}, 0, 5 * kMs}, 1000, config), 0);
+  EXPECT_NEAR(tuner.GetStatistics().skew_ms, 5.0, 1e-3);
+  EXPECT_EQ(tuner.GetStatistics().config.matching_threshold_ns, 7 * kMs);
+  EXPECT_EQ(tuner.GetStatistics().config.buffer_size, 4u);
+
+  // A larger step is applied once and then stays.
+  SyncTuner large_step(2, {4 * kMs, 4}, kMin, kMax);
+  EXPECT_EQ(Feed(large_step, {{0, 5 * kMs}, 0, 5 * kMs}, 1000, config), 1);
+  EXPECT_NEAR(config.matching_threshold_ns, 15 * kMs / 2, kMs / 100);
+}
+
+TEST(SyncTunerTest, ThresholdIsClamped)
+{
+  // The 15 ms skew recommends 22.5 ms, which is capped below half a period.
+  SyncTuner tuner(2, {5 * kMs, 4}, kMin, kMax);
+  SyncTuner::Config config{};
+  EXPECT_GE(Feed(tuner, {{0, 15 * kMs}, 0, 15 * kMs}, 400, config), 1);
+  EXPECT_NEAR(config.matching_threshold_ns, 0.45 * kPeriodNs, kMs / 100);
+
+  // And to the configured maximum.
+  SyncTuner limited(2, {5 * kMs, 4}, kMin, {10 * kMs, 20});
+  EXPECT_GE(Feed(limited, {{0, 15 * kMs}, 0, 15 * kMs}, 400, config), 1);
+  EXPECT_EQ(config.matching_threshold_ns, 10 * kMs);
+
+  // A skew of zero does not go below the configured minimum.
+  SyncTuner minimum(2, {5 * kMs, 4}, kMin, kMax);
+  EXPECT_GE(Feed(minimum, {{0, 0}, 0, 0}, 400, config), 1);
+  EXPECT_EQ(config.matching_threshold_ns, kMin.matching_threshold_ns);
+  EXPECT_EQ(config.buffer_size, kMin.buffer_size);
+}
+
+TEST(SyncTunerTest, JitteryStreamsGrowTheBuffer)
+{
+  SyncTuner tuner(3, {5 * kMs, 2}, kMin, kMax);
+  SyncTuner::Config config{};
+  // Free running cameras with 2 ms of jitter whose frame sets wait for more than two periods.
+  EXPECT_GE(Feed(tuner, {{0, 3 * kMs, 6 * kMs}, 2 * kMs, 80 * kMs}, 1000, config), 1);
+  EXPECT_GE(config.buffer_size, 5u);
+  EXPECT_LE(config.buffer_size, kMax.buffer_size);
+  // The window covers the largest skew of 6 ms plus the jitter, but not half a period.
+  EXPECT_GT(config.matching_threshold_ns, 6 * kMs);
+  EXPECT_LT(config.matching_threshold_ns, kPeriodNs / 2);
+
+  const SyncTuner::Statistics statistics = tuner.GetStatistics();
+  EXPECT_GT(statistics.max_jitter_ms, 0.5);
+  EXPECT_NEAR(statistics.sync_wait_peak_ms, 80.0, 1e-3);
+
+  // The buffer is clamped to the configured maximum.
+  SyncTuner limited(3, {5 * kMs, 2}, kMin, {50 * kMs, 4});
+  EXPECT_GE(Feed(limited, {{0, 3 * kMs, 6 * kMs}, 2 * kMs, 80 * kMs}, 1000, config), 1);
+  EXPECT_EQ(config.buffer_size, 4u);
+}
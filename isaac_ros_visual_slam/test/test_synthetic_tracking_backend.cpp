@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "isaac_ros_visual_slam/impl/cuvslam_ros_conversion.hpp"
+#include "isaac_ros_visual_slam/impl/synthetic_tracking_backend.hpp"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+constexpr int64_t kFramePeriodNs = 100'000'000;
+// Poses pass through float in cuvslam::Pose.
+constexpr double kTolerance = 1e-4;
+
+std::vector<cuvslam::Image> MakeImages(int64_t timestamp_ns)
+{
+  std::vector<cuvslam::Image> images(2);
+  images[0].timestamp_ns = timestamp_ns;
+  images[1].timestamp_ns = timestamp_ns;
+  return images;
+}
+
+// Tracks one frame set and returns the rig pose in ROS conventions.
+tf2::Transform Track(SyntheticTrackingBackend & backend, int64_t timestamp_ns)
+{
+  const cuvslam::PoseEstimate estimate = backend.Track(MakeImages(timestamp_ns), {}, {});
+  EXPECT_TRUE(estimate.world_from_rig.has_value());
+  return ChangeBasis(canonical_pose_cuvslam, FromcuVSLAMPose(estimate.world_from_rig->pose));
+}
+
+tf2::Transform ToRos(const cuvslam::Pose & pose)
+{
+  return ChangeBasis(canonical_pose_cuvslam, FromcuVSLAMPose(pose));
+}
+
+void ExpectNear(const tf2::Transform & actual, const tf2::Transform & expected)
+{
+  EXPECT_NEAR(actual.getOrigin().distance(expected.getOrigin()), 0, kTolerance);
+  EXPECT_NEAR(actual.getRotation().angleShortestPath(expected.getRotation()), 0, kTolerance);
+}
+
+tf2::Transform MakePose(double x, double y, double yaw)
+{
+  tf2::Quaternion orientation;
+  orientation.setRPY(0, 0, yaw);
+  return tf2::Transform(orientation, tf2::Vector3(x, y, 0));
+}
+
+}  // namespace
+
+TEST(SyntheticTrackingBackendTest, FollowsTheScriptedCircle)
+{
+  SyntheticTrackingBackend::Config config;
+  config.linear_velocity = 2.0;
+  config.angular_velocity = 0.5;
+  SyntheticTrackingBackend backend(config);
+
+  const int64_t start_ns = 1'000'000'000;
+  ExpectNear(Track(backend, start_ns), tf2::Transform::getIdentity());
+
+  // After a quarter turn the rig is one radius ahead and one radius to the left.
+  const double radius = config.linear_velocity / config.angular_velocity;
+  const double quarter_turn_s = M_PI / 2 / config.angular_velocity;
+  const int64_t quarter_turn_ns = static_cast<int64_t>(quarter_turn_s * 1e9);
+  ExpectNear(Track(backend, start_ns + quarter_turn_ns), MakePose(radius, radius, M_PI / 2));
+
+  // After half a turn it is two radii to the left, facing backwards.
+  ExpectNear(Track(backend, start_ns + 2 * quarter_turn_ns), MakePose(0, 2 * radius, M_PI));
+}
+
+TEST(SyntheticTrackingBackendTest, DrivesStraightWithoutYawRate)
+{
+  SyntheticTrackingBackend::Config config;
+  config.linear_velocity = 1.5;
+  config.angular_velocity = 0;
+  SyntheticTrackingBackend backend(config);
+
+  Track(backend, 0);
+  ExpectNear(Track(backend, 2'000'000'000), MakePose(3.0, 0, 0));
+}
+
+TEST(SyntheticTrackingBackendTest, UsesTheLatestImageTimestamp)
+{
+  SyntheticTrackingBackend::Config config;
+  config.angular_velocity = 0;
+  SyntheticTrackingBackend backend(config);
+
+  Track(backend, 0);
+  std::vector<cuvslam::Image> images = MakeImages(kFramePeriodNs);
+  images[1].timestamp_ns = 10 * kFramePeriodNs;
+  const cuvslam::PoseEstimate estimate = backend.Track(images, {}, {});
+  ExpectNear(ToRos(estimate.world_from_rig->pose), MakePose(1.0, 0, 0));
+}
+
+TEST(SyntheticTrackingBackendTest, IsDeterministic)
+{
+  SyntheticTrackingBackend::Config config;
+  SyntheticTrackingBackend first(config);
+  SyntheticTrackingBackend second(config);
+
+  // The trajectory only depends on the time since the first frame.
+  for (int i = 0; i < 20; i++) {
+    const tf2::Transform first_pose = Track(first, 5'000'000'000 + i * kFramePeriodNs);
+    const tf2::Transform second_pose = Track(second, 9'000'000'000 + i * kFramePeriodNs);
+    ExpectNear(first_pose, second_pose);
+    ExpectNear(ToRos(first.TrackSlam()), ToRos(second.TrackSlam()));
+  }
+}
+
+TEST(SyntheticTrackingBackendTest, RejectsAnEmptyFrameSet)
+{
+  SyntheticTrackingBackend backend(SyntheticTrackingBackend::Config{});
+  EXPECT_THROW(backend.Track({}, {}, {}), std::invalid_argument);
+}
+
+TEST(SyntheticTrackingBackendTest, ResetKeepsTheSlamPose)
+{
+  SyntheticTrackingBackend::Config config;
+  config.angular_velocity = 0;
+  SyntheticTrackingBackend backend(config);
+
+  Track(backend, 0);
+  Track(backend, 10 * kFramePeriodNs);
+  ExpectNear(ToRos(backend.TrackSlam()), MakePose(1.0, 0, 0));
+
+  // Odometry restarts at the origin while slam continues where the rig was.
+  backend.Reset(false);
+  ExpectNear(Track(backend, 50 * kFramePeriodNs), tf2::Transform::getIdentity());
+  ExpectNear(ToRos(backend.TrackSlam()), MakePose(1.0, 0, 0));
+  Track(backend, 60 * kFramePeriodNs);
+  ExpectNear(ToRos(backend.TrackSlam()), MakePose(2.0, 0, 0));
+
+  std::vector<cuvslam::PoseStamped> poses;
+  backend.GetAllSlamPoses(poses, 100);
+  EXPECT_EQ(poses.size(), 3u);
+  EXPECT_EQ(poses.back().timestamp_ns, 60 * kFramePeriodNs);
+}
+
+TEST(SyntheticTrackingBackendTest, ResetWithClearMapDropsTheSlamPoses)
+{
+  SyntheticTrackingBackend::Config config;
+  config.angular_velocity = 0;
+  SyntheticTrackingBackend backend(config);
+
+  Track(backend, 0);
+  Track(backend, 10 * kFramePeriodNs);
+  backend.TrackSlam();
+
+  backend.Reset(true);
+  std::vector<cuvslam::PoseStamped> poses;
+  backend.GetAllSlamPoses(poses, 100);
+  EXPECT_TRUE(poses.empty());
+
+  ExpectNear(Track(backend, 50 * kFramePeriodNs), tf2::Transform::getIdentity());
+  ExpectNear(ToRos(backend.TrackSlam()), tf2::Transform::getIdentity());
+}
+
+TEST(SyntheticTrackingBackendTest, SetSlamPoseMovesTheMapFrame)
+{
+  SyntheticTrackingBackend::Config config;
+  config.angular_velocity = 0;
+  SyntheticTrackingBackend backend(config);
+
+  Track(backend, 0);
+  Track(backend, 10 * kFramePeriodNs);
+  const tf2::Transform slam_pose = MakePose(5.0, -2.0, M_PI / 2);
+  backend.SetSlamPose(TocuVSLAMPose(ChangeBasis(cuvslam_pose_canonical, slam_pose)));
+  ExpectNear(ToRos(backend.TrackSlam()), slam_pose);
+
+  // The rig keeps driving along its own x axis, which is the map y axis now.
+  Track(backend, 20 * kFramePeriodNs);
+  ExpectNear(ToRos(backend.TrackSlam()), MakePose(5.0, -1.0, M_PI / 2));
+}
+
+TEST(SyntheticTrackingBackendTest, GetAllSlamPosesReturnsTheLatest)
+{
+  SyntheticTrackingBackend backend(SyntheticTrackingBackend::Config{});
+  for (int i = 0; i < 5; i++) {
+    Track(backend, i * kFramePeriodNs);
+    backend.TrackSlam();
+  }
+  std::vector<cuvslam::PoseStamped> poses;
+  backend.GetAllSlamPoses(poses, 2);
+  ASSERT_EQ(poses.size(), 2u);
+  EXPECT_EQ(poses[0].timestamp_ns, 3 * kFramePeriodNs);
+  EXPECT_EQ(poses[1].timestamp_ns, 4 * kFramePeriodNs);
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia
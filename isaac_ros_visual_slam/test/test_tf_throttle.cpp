@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: NVIDIA CORPORATION & AFFILIATES
+// Copyright (c) 2025 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "isaac_ros_visual_slam/impl/sensor_time.hpp"
+#include "isaac_ros_visual_slam/impl/tf_throttle.hpp"
+#include "tf2/LinearMath/Quaternion.h"
+
+namespace nvidia
+{
+namespace isaac_ros
+{
+namespace visual_slam
+{
+namespace
+{
+
+constexpr int64_t kMsNs = 1'000'000;
+
+TfThrottle::Options MakeOptions()
+{
+  TfThrottle::Options options;
+  options.map_to_odom_keep_alive_ms = 1000;
+  options.map_to_odom_translation_threshold = 0.01;
+  options.map_to_odom_rotation_threshold = 0.01;
+  options.odom_to_base_max_rate = 10;
+  return options;
+}
+
+tf2::Transform MakePose(double x, double yaw)
+{
+  tf2::Quaternion orientation;
+  orientation.setRPY(0, 0, yaw);
+  return tf2::Transform(orientation, tf2::Vector3(x, 0, 0));
+}
+
+}  // namespace
+
+TEST(SensorTimeTest, PeriodElapsed)
+{
+  EXPECT_TRUE(IsPeriodElapsed(0, std::nullopt, 100));
+  EXPECT_FALSE(IsPeriodElapsed(150, 100, 100));
+  EXPECT_TRUE(IsPeriodElapsed(200, 100, 100));
+  EXPECT_TRUE(IsPeriodElapsed(101, 100, 0));
+  // After a time jump back, e.g. a restarted rosbag.
+  EXPECT_TRUE(IsTimeJumpBack(50, 100));
+  EXPECT_TRUE(IsPeriodElapsed(50, 100, 100));
+}
+
+TEST(TfThrottleTest, MapToOdomIsSentWhenItMoves)
+{
+  TfThrottle throttle(MakeOptions());
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(0, MakePose(0, 0)));
+  EXPECT_FALSE(throttle.ShouldPublishMapToOdom(10 * kMsNs, MakePose(0.005, 0.005)));
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(20 * kMsNs, MakePose(0.02, 0)));
+  // Compared against the last published pose, so small moves add up.
+  EXPECT_FALSE(throttle.ShouldPublishMapToOdom(30 * kMsNs, MakePose(0.025, 0)));
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(40 * kMsNs, MakePose(0.031, 0)));
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(50 * kMsNs, MakePose(0.031, 0.02)));
+}
+
+TEST(TfThrottleTest, MapToOdomIsKeptAlive)
+{
+  TfThrottle throttle(MakeOptions());
+  const tf2::Transform pose = MakePose(1, 0);
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(0, pose));
+  EXPECT_FALSE(throttle.ShouldPublishMapToOdom(999 * kMsNs, pose));
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(1000 * kMsNs, pose));
+  EXPECT_FALSE(throttle.ShouldPublishMapToOdom(1500 * kMsNs, pose));
+  // A time jump back publishes right away.
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(100 * kMsNs, pose));
+}
+
+TEST(TfThrottleTest, MapToOdomWithoutKeepAliveIsSentEveryFrame)
+{
+  TfThrottle::Options options = MakeOptions();
+  options.map_to_odom_keep_alive_ms = 0;
+  TfThrottle throttle(options);
+  for (int64_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(throttle.ShouldPublishMapToOdom(i * kMsNs, MakePose(1, 0)));
+  }
+}
+
+TEST(TfThrottleTest, OdomToBaseIsLimitedToTheMaxRate)
+{
+  TfThrottle throttle(MakeOptions());
+  int published = 0;
+  // One second at 30 Hz.
+  for (int64_t i = 0; i < 30; i++) {
+    published += throttle.ShouldPublishOdomToBase(i * 1'000'000'000 / 30);
+  }
+  EXPECT_EQ(published, 10);
+
+  EXPECT_FALSE(throttle.ShouldPublishOdomToBase(950 * kMsNs));
+  EXPECT_TRUE(throttle.ShouldPublishOdomToBase(500 * kMsNs));
+}
+
+TEST(TfThrottleTest, OdomToBaseWithoutMaxRateIsSentEveryFrame)
+{
+  TfThrottle::Options options = MakeOptions();
+  options.odom_to_base_max_rate = 0;
+  TfThrottle throttle(options);
+  for (int64_t i = 0; i < 3; i++) {
+    EXPECT_TRUE(throttle.ShouldPublishOdomToBase(i * kMsNs));
+  }
+}
+
+TEST(TfThrottleTest, ResetPublishesRightAway)
+{
+  TfThrottle throttle(MakeOptions());
+  const tf2::Transform pose = MakePose(1, 0);
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(0, pose));
+  EXPECT_TRUE(throttle.ShouldPublishOdomToBase(0));
+  throttle.Reset();
+  EXPECT_TRUE(throttle.ShouldPublishMapToOdom(kMsNs, pose));
+  EXPECT_TRUE(throttle.ShouldPublishOdomToBase(kMsNs));
+}
+
+}  // namespace visual_slam
+}  // namespace isaac_ros
+}  // namespace nvidia